@@ -1,5 +1,7 @@
 // --- PBRShader --------------------------------------------------------------
-// PBR shader for non-textured 3D objects.
+// PBR shader for 3D objects.
+// Variants: HAS_ALBEDO_MAP, HAS_NORMAL_MAP, HAS_METALLIC_MAP, HAS_ROUGHNESS_MAP,
+// HAS_AO_MAP. See MaterialFeature in Material.h.
 
 // --- Vertex Shader ---
 #type vertex
@@ -144,36 +146,38 @@ vec3 CalculateSpotLight(SpotLight spotLight, vec3 n, vec3 v, vec3 f0, vec3 albed
 
 void main()
 {
+	// Material inputs. Each texture map is enabled by a define so untextured materials
+	// compile without texture fetches or per-fragment branches.
 	// Albedo
-	vec3 albedo;
-	if (u_Material[v_MaterialIndex].AlbedoTexIndex != 0)
-		albedo = pow(texture(u_Textures[u_Material[v_MaterialIndex].AlbedoTexIndex], v_TexCoord).xyz, vec3(2.2f));
-	else
-		albedo = u_Material[v_MaterialIndex].Albedo.xyz;
+#ifdef HAS_ALBEDO_MAP
+	vec3 albedo = pow(texture(u_Textures[u_Material[v_MaterialIndex].AlbedoTexIndex], v_TexCoord).xyz, vec3(2.2f));
+#else
+	vec3 albedo = u_Material[v_MaterialIndex].Albedo.xyz;
+#endif
 	// Normal
-	vec3 N;
-	if (u_Material[v_MaterialIndex].NormalMapTexIndex != 0)
-		N = getNormalFromMap();
-	else
-		N = normalize(v_Normal);
+#ifdef HAS_NORMAL_MAP
+	vec3 N = getNormalFromMap();
+#else
+	vec3 N = normalize(v_Normal);
+#endif
 	// Metallic
-	float metallic;
-	if (u_Material[v_MaterialIndex].MetallicTexIndex != 0)
-		metallic = texture(u_Textures[u_Material[v_MaterialIndex].MetallicTexIndex], v_TexCoord).r;
-	else
-		metallic = u_Material[v_MaterialIndex].Metallic;
+#ifdef HAS_METALLIC_MAP
+	float metallic = texture(u_Textures[u_Material[v_MaterialIndex].MetallicTexIndex], v_TexCoord).r;
+#else
+	float metallic = u_Material[v_MaterialIndex].Metallic;
+#endif
 	// Roughness
-	float roughness;
-	if (u_Material[v_MaterialIndex].RoughnessTexIndex != 0)
-		roughness = texture(u_Textures[u_Material[v_MaterialIndex].RoughnessTexIndex], v_TexCoord).r;
-	else
-		roughness = u_Material[v_MaterialIndex].Roughness;
+#ifdef HAS_ROUGHNESS_MAP
+	float roughness = texture(u_Textures[u_Material[v_MaterialIndex].RoughnessTexIndex], v_TexCoord).r;
+#else
+	float roughness = u_Material[v_MaterialIndex].Roughness;
+#endif
 	// AO
-	float ao;
-	if (u_Material[v_MaterialIndex].AOTexIndex != 0)
-		ao = texture(u_Textures[u_Material[v_MaterialIndex].AOTexIndex], v_TexCoord).r;
-	else
-		ao = u_Material[v_MaterialIndex].AO;
+#ifdef HAS_AO_MAP
+	float ao = texture(u_Textures[u_Material[v_MaterialIndex].AOTexIndex], v_TexCoord).r;
+#else
+	float ao = u_Material[v_MaterialIndex].AO;
+#endif
 
 	vec3 V = normalize(v_ViewPos - v_FragPos);
 
@@ -0,0 +1,95 @@
+#include "Benchmarks.h"
+
+namespace Locus::Benchmarks
+{
+	void PhysicsSync(uint32_t colliderCount, uint32_t frameCount)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		Ref<Scene> scene = CreateRef<Scene>("PhysicsSyncBenchmark");
+		uint32_t columns = (uint32_t)glm::ceil(glm::sqrt((float)colliderCount));
+		std::vector<Entity> entities;
+		entities.reserve(colliderCount);
+		for (uint32_t i = 0; i < colliderCount; i++)
+		{
+			Entity entity = scene->CreateEntity("Collider");
+			entity.GetComponent<TransformComponent>().LocalPosition = { (float)(i % columns) * 2.0f, (float)(i / columns) * 2.0f, 0.0f };
+			entity.AddComponent<BoxCollider2DComponent>();
+			entities.push_back(entity);
+		}
+
+		scene->OnPhysicsStart();
+
+		Timer timer;
+		// Full sweep, the way every entity used to be synced each frame.
+		timer.Reset();
+		for (uint32_t frame = 0; frame < frameCount; frame++)
+		{
+			auto view = scene->GetEntitiesWith<IDComponent>();
+			for (auto e : view)
+				scene->UpdatePhysicsData(Entity(e, scene.get()));
+		}
+		float fullSweepTime = timer.ElapsedMillis();
+
+		// Change driven, one entity edited per frame.
+		timer.Reset();
+		for (uint32_t frame = 0; frame < frameCount; frame++)
+		{
+			scene->MarkPhysicsDirty(entities[frame % colliderCount]);
+			scene->SyncPhysicsData();
+		}
+		float dirtySyncTime = timer.ElapsedMillis();
+
+		scene->OnPhysicsStop();
+
+		LOCUS_CORE_INFO("Physics sync benchmark ({0} static colliders, {1} frames)", colliderCount, frameCount);
+		LOCUS_CORE_INFO("  Full sweep: {0:.4f} ms/frame", fullSweepTime / frameCount);
+		LOCUS_CORE_INFO("  Dirty only: {0:.4f} ms/frame", dirtySyncTime / frameCount);
+	}
+
+	void SceneDeserialize()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		const uint32_t entityCounts[] = { 1000, 10000, 50000 };
+		uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "LocusDeserializeBenchmark.locus";
+
+		LOCUS_CORE_INFO("Scene deserialize benchmark ({0} hardware threads)", hardwareThreads);
+		for (uint32_t entityCount : entityCounts)
+		{
+			{
+				Ref<Scene> scene = CreateRef<Scene>("DeserializeBenchmark");
+				uint32_t columns = (uint32_t)glm::ceil(glm::sqrt((float)entityCount));
+				for (uint32_t i = 0; i < entityCount; i++)
+				{
+					Entity entity = scene->CreateEntity("Entity" + std::to_string(i));
+					entity.GetComponent<TransformComponent>().LocalPosition = { (float)(i % columns), (float)(i / columns), 0.0f };
+					entity.AddComponent<SpriteRendererComponent>(glm::vec4(1.0f, 0.5f, 0.2f, 1.0f));
+					if (i % 2 == 0)
+					{
+						entity.AddComponent<Rigidbody2DComponent>();
+						entity.AddComponent<BoxCollider2DComponent>();
+					}
+				}
+				SceneSerializer(scene).Serialize(path.string());
+			}
+
+			float times[2] = {};
+			uint32_t threadCounts[2] = { 1, hardwareThreads };
+			for (int i = 0; i < 2; i++)
+			{
+				Ref<Scene> scene = CreateRef<Scene>();
+				SceneSerializer serializer(scene);
+				serializer.SetThreadCount(threadCounts[i]);
+				Timer timer;
+				serializer.Deserialize(path.string());
+				times[i] = timer.ElapsedMillis();
+			}
+
+			LOCUS_CORE_INFO("  {0} entities: {1:.2f} ms on 1 thread, {2:.2f} ms on {3} threads ({4:.2f}x)",
+				entityCount, times[0], times[1], hardwareThreads, times[0] / times[1]);
+		}
+		std::filesystem::remove(path);
+	}
+}
@@ -0,0 +1,17 @@
+// --- Benchmarks -------------------------------------------------------------
+// Editor debug routines that time engine hot paths on generated scenes.
+// Results are written to the log. Run from the Debug panel.
+#pragma once
+
+#include <Locus.h>
+
+namespace Locus::Benchmarks
+{
+	// Compares syncing every entity to Box2D each frame against only syncing
+	// entities marked dirty, on a scene of static box colliders.
+	void PhysicsSync(uint32_t colliderCount = 10000, uint32_t frameCount = 300);
+
+	// Loads generated .locus scenes of increasing size on one thread and on
+	// every hardware thread.
+	void SceneDeserialize();
+}
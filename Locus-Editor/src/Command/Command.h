@@ -18,7 +18,12 @@ namespace Locus
 		void SetNoMerge() { m_CanMerge = false; }
 		bool CanMerge() const { return m_CanMerge; }
 
+		// Entity whose components the command edits in place. Null if it edits none.
+		void SetTarget(Entity entity) { m_Target = entity; }
+		Entity GetTarget() const { return m_Target; }
+
 	protected:
 		bool m_CanMerge = true;
+		Entity m_Target;
 	};
 }
@@ -11,6 +11,7 @@ namespace Locus
 		int32_t CommandSize;
 		int32_t CommandPtr;
 		bool FirstCommand;
+		Entity Target;
 
 		LocusEditorLayer* Editor;
 	};
@@ -42,7 +43,10 @@ namespace Locus
 
 	void CommandHistory::AddCommand(Command* cmd)
 	{
+		if (!cmd->GetTarget())
+			cmd->SetTarget(s_Data->Target);
 		cmd->Execute();
+		s_Data->Editor->OnEntityEdited(cmd->GetTarget());
 
 		if (s_Data->CommandPtr < s_Data->CommandSize)
 		{
@@ -74,6 +78,7 @@ namespace Locus
 		if (s_Data->CommandPtr >= 0 && s_Data->Commands[s_Data->CommandPtr] != nullptr && !s_Data->FirstCommand)
 		{
 			s_Data->Commands[s_Data->CommandPtr]->Undo();
+			s_Data->Editor->OnEntityEdited(s_Data->Commands[s_Data->CommandPtr]->GetTarget());
 			s_Data->CommandPtr--;
 			s_Data->FirstCommand = false;
 			LOCUS_CORE_INFO("UNDO COMMAND. Ptr Position: {0}", s_Data->CommandPtr);
@@ -86,6 +91,7 @@ namespace Locus
 		if (redoCommandPtr < s_Data->CommandSize && redoCommandPtr >= 0 && !s_Data->FirstCommand)
 		{
 			s_Data->Commands[redoCommandPtr]->Execute();
+			s_Data->Editor->OnEntityEdited(s_Data->Commands[redoCommandPtr]->GetTarget());
 			s_Data->CommandPtr++;
 			s_Data->FirstCommand = false;
 			LOCUS_CORE_INFO("REDO COMMAND. Ptr Position: {0}", s_Data->CommandPtr);
@@ -96,4 +102,9 @@ namespace Locus
 	{
 		s_Data->Editor->SetSavedStatus(status);
 	}
+
+	void CommandHistory::SetTarget(Entity entity)
+	{
+		s_Data->Target = entity;
+	}
 }
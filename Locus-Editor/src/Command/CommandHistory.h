@@ -17,5 +17,8 @@ namespace Locus
 		static void Redo();
 
 		static void SetEditorSavedStatus(bool status);
+		// Entity edited by the commands added until the next call. The editor is notified whenever
+		//	one of them is executed, undone or redone, so the scene picks up the in place edit.
+		static void SetTarget(Entity entity);
 	};
 }
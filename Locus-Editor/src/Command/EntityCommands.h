@@ -30,6 +30,8 @@ namespace Locus
 			data->SpriteRenderer = CreateRef<SpriteRendererComponent>(entity.GetComponent<SpriteRendererComponent>());
 		if (entity.HasComponent<CircleRendererComponent>())
 			data->CircleRenderer = CreateRef<CircleRendererComponent>(entity.GetComponent<CircleRendererComponent>());
+		if (entity.HasComponent<TilemapComponent>())
+			data->Tilemap = CreateRef<TilemapComponent>(entity.GetComponent<TilemapComponent>());
 		if (entity.HasComponent<CubeRendererComponent>())
 			data->CubeRenderer = CreateRef<CubeRendererComponent>(entity.GetComponent<CubeRendererComponent>());
 		if (entity.HasComponent<MeshRendererComponent>())
@@ -48,6 +50,8 @@ namespace Locus
 			data->BoxCollider2D = CreateRef<BoxCollider2DComponent>(entity.GetComponent<BoxCollider2DComponent>());
 		if (entity.HasComponent<CircleCollider2DComponent>())
 			data->CircleCollider2D = CreateRef<CircleCollider2DComponent>(entity.GetComponent<CircleCollider2DComponent>());
+		if (entity.HasComponent<CompoundCollider2DComponent>())
+			data->CompoundCollider2D = CreateRef<CompoundCollider2DComponent>(entity.GetComponent<CompoundCollider2DComponent>());
 		if (entity.HasComponent<ScriptComponent>())
 			data->Script = CreateRef<ScriptComponent>(entity.GetComponent<ScriptComponent>());
 	}
@@ -56,7 +60,7 @@ namespace Locus
 	static void LoadEntityData(Ref<ComponentData> data, Entity entity)
 	{
 		entity.GetComponent<IDComponent>() = *data->ID;
-		entity.GetComponent<TagComponent>() = *data->Tag;
+		entity.AddOrReplaceComponent<TagComponent>(*data->Tag);
 		entity.GetComponent<TransformComponent>() = *data->Transform;
 		if (data->Child)
 			entity.AddComponent<ChildComponent>(*data->Child);
@@ -64,6 +68,8 @@ namespace Locus
 			entity.AddComponent<SpriteRendererComponent>(*data->SpriteRenderer);
 		if (data->CircleRenderer)
 			entity.AddComponent<CircleRendererComponent>(*data->CircleRenderer);
+		if (data->Tilemap)
+			entity.AddComponent<TilemapComponent>(*data->Tilemap);
 		if (data->CubeRenderer)
 			entity.AddComponent<CubeRendererComponent>(*data->CubeRenderer);
 		if (data->MeshRenderer)
@@ -82,6 +88,8 @@ namespace Locus
 			entity.AddComponent<BoxCollider2DComponent>(*data->BoxCollider2D);
 		if (data->CircleCollider2D)
 			entity.AddComponent<CircleCollider2DComponent>(*data->CircleCollider2D);
+		if (data->CompoundCollider2D)
+			entity.AddComponent<CompoundCollider2DComponent>(*data->CompoundCollider2D);
 		if (data->Script)
 			entity.AddComponent<ScriptComponent>(*data->Script);
 	}
@@ -296,7 +304,7 @@ namespace Locus
 			// Overriding copied data
 			auto& tc = entity.GetComponent<TransformComponent>();
 			tc.Self = m_UUID;
-			entity.GetComponent<TagComponent>().Tag = m_EntityName;
+			m_ActiveScene->SetEntityTag(entity, m_EntityName);
 
 			if (tc.Parent)
 			{
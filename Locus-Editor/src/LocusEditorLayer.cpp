@@ -12,6 +12,7 @@
 #include "Command/CommandHistory.h"
 #include "Command/EntityCommands.h"
 #include "Command/ValueCommands.h"
+#include "Benchmarks/Benchmarks.h"
 
 namespace Locus
 {
@@ -31,6 +32,7 @@ namespace Locus
 		m_ProjectBrowserPanel = CreateRef<ProjectBrowserPanel>();
 		m_ConsolePanel = CreateRef<ConsolePanel>();
 		m_ResourceInspectorPanel = CreateRef<ResourceInspectorPanel>(m_ProjectBrowserPanel);
+		m_ScriptProfilerPanel = CreateRef<ScriptProfilerPanel>();
 
 		CommandHistory::Init(this);
 
@@ -45,8 +47,11 @@ namespace Locus
 		m_RotateIcon = Texture2D::Create("resources/icons/RotateIcon.png");
 
 		// Shaders
-		m_MaskShader = Shader::Create("resources/shaders/MaskShader.glsl");
-		OutlinePostProcessShader = Shader::Create("resources/shaders/OutlinePostProcessShader.glsl");
+		auto shaders = Shader::CreateBatch({ "resources/shaders/MaskShader.glsl", "resources/shaders/OutlinePostProcessShader.glsl" });
+		m_MaskShader = shaders[0];
+		OutlinePostProcessShader = shaders[1];
+		for (auto& shader : shaders)
+			Renderer::GetShaderLibrary().Add(shader);
 	}
 
 	LocusEditorLayer::~LocusEditorLayer()
@@ -105,6 +110,11 @@ namespace Locus
 		LOCUS_PROFILE_FUNCTION();
 		RendererStats::StatsStartFrame();
 
+		Renderer::GetShaderLibrary().CheckForChanges();
+		// Reloading unloads the app domain, so it must not happen while scripts are running.
+		if (m_SceneState == SceneState::Edit && ScriptEngine::CheckForChanges(m_EditorScene))
+			m_PropertiesPanel->m_ScriptClasses = ScriptEngine::GetClassNames();
+
 		// On viewport resize
 		if (FramebufferSpecification spec = m_Framebuffer->GetSpecification();
 			m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f &&
@@ -160,6 +170,13 @@ namespace Locus
 			}
 		}
 
+		// Entity picking
+		if (int pixelData; m_Framebuffer->GetRequestedPixel(pixelData))
+		{
+			Entity picked = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
+			g_SelectedEntity = picked.IsValid() ? picked : Entity();
+		}
+
 		// Gizmo visibility
 		if (g_SelectedEntity.IsValid())
 			m_GizmoVisible = true;
@@ -341,7 +358,7 @@ namespace Locus
 			{
 				if (control && shift)
 				{
-					ScriptEngine::ReloadScripts();
+					ScriptEngine::ReloadScripts(m_EditorScene);
 					m_PropertiesPanel->m_ScriptClasses = ScriptEngine::GetClassNames();
 				}
 				else
@@ -371,8 +388,8 @@ namespace Locus
 			if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)m_ViewportSize.x && mouseY < (int)m_ViewportSize.y 
 				&& m_ViewportHovered && (!ImGuizmo::IsOver() || ImGuizmo::IsOver() && !m_GizmoVisible))
 			{
-				int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY); // TODO: This is really slow??
-				g_SelectedEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
+				// Selection is applied in OnUpdate() once the readback arrives.
+				m_Framebuffer->RequestPixel(1, mouseX, mouseY);
 				m_GizmoFirstClick = true;
 			}
 		}
@@ -400,7 +417,7 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		std::string path = FileDialogs::OpenFile("Locus Scene (*.locus)\0*.locus\0");
+		std::string path = FileDialogs::OpenFile("Locus Scene (*.locus;*.locusb)\0*.locus;*.locusb\0");
 		if (!path.empty())
 			OpenScene(path);
 	}
@@ -411,29 +428,38 @@ namespace Locus
 
 		if (m_SceneState != SceneState::Edit)
 			OnSceneStop();
+
+		// Loaded into a new scene so a file that fails to load leaves the open scene and its save path as they were.
+		Ref<Scene> scene = CreateRef<Scene>();
+		scene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		SceneSerializer serializer(scene);
+		if (!serializer.Deserialize(path.string()))
+		{
+			LOCUS_CORE_ERROR("Failed to open scene {0}", path.string());
+			return;
+		}
+
 		g_SelectedEntity = {};
-		m_EditorScene = CreateRef<Scene>();
-		m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		m_EditorScene = scene;
 		m_ActiveScene = m_EditorScene;
 		m_SceneHierarchyPanel->SetScene(m_ActiveScene);
 		m_PropertiesPanel->SetScene(m_ActiveScene);
-		SceneSerializer serializer(m_EditorScene);
-		serializer.Deserialize(path.string());
 		m_SavePath = path.string();
 		m_IsSaved = true;
 		CommandHistory::Reset();
 	}
 
-	// Returns false if canceling file dialog.
+	// Returns false if canceling file dialog or if the scene failed to save.
 	bool LocusEditorLayer::SaveSceneAs()
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		std::string path = FileDialogs::SaveFile("Locus Scene (*.locus)\0*.locus\0");
+		std::string path = FileDialogs::SaveFile("Locus Scene (*.locus)\0*.locus\0Locus Binary Scene (*.locusb)\0*.locusb\0");
 		if (!path.empty())
 		{
 			SceneSerializer serializer(m_EditorScene);
-			serializer.Serialize(path);
+			if (!serializer.Serialize(path))
+				return false;
 			m_SavePath = path;
 			m_IsSaved = true;
 			return true;
@@ -452,7 +478,8 @@ namespace Locus
 		else
 		{
 			SceneSerializer serializer(m_EditorScene);
-			serializer.Serialize(m_SavePath);
+			if (!serializer.Serialize(m_SavePath))
+				return false;
 			m_IsSaved = true;
 			return true;
 		}
@@ -492,6 +519,7 @@ namespace Locus
 		}
 
 		// Entity transform
+		CommandHistory::SetTarget(g_SelectedEntity);
 		auto& tc = g_SelectedEntity.GetComponent<TransformComponent>();
 		glm::mat4& transform = m_ActiveScene->GetWorldTransform(g_SelectedEntity);
 
@@ -551,6 +579,7 @@ namespace Locus
 				}
 			}
 		}
+		CommandHistory::SetTarget(Entity::Null);
 	}
 
 	void LocusEditorLayer::ProcessViewportDragDrop()
@@ -570,6 +599,15 @@ namespace Locus
 		}
 	}
 
+	void LocusEditorLayer::OnEntityEdited(Entity entity)
+	{
+		// Commands outlive the scene they were recorded in. Only edits to the active scene are synced.
+		if (!entity || entity != Entity((entt::entity)entity, m_ActiveScene.get()) || !entity.IsValid())
+			return;
+
+		m_ActiveScene->MarkPhysicsDirty(entity);
+	}
+
 	void LocusEditorLayer::OnScenePlay()
 	{
 		LOCUS_PROFILE_FUNCTION();
@@ -649,6 +687,7 @@ namespace Locus
 		m_ProjectBrowserPanel->OnImGuiRender();
 		m_ConsolePanel->OnImGuiRender();
 		m_ResourceInspectorPanel->OnImGuiRender();
+		m_ScriptProfilerPanel->OnImGuiRender();
 		//ImGui::ShowDemoWindow();
 
 
@@ -863,7 +902,7 @@ namespace Locus
 		{
 			if (ImGui::MenuItem("Reload Scripts", "Ctrl+Shift+R"))
 			{
-				ScriptEngine::ReloadScripts();
+				ScriptEngine::ReloadScripts(m_EditorScene);
 				m_PropertiesPanel->m_ScriptClasses = ScriptEngine::GetClassNames();
 			}
 
@@ -1181,6 +1220,106 @@ namespace Locus
 			ImGui::Text("WorldScale: %f, %f, %f", worldScale.x, worldScale.y, worldScale.z);
 		}
 
+		// Physics
+		ImGui::Separator();
+		ImGui::Text("Physics Stats:");
+		const PhysicsStats2D& physicsStats = m_ActiveScene->GetPhysicsStats();
+		if (m_SceneState == SceneState::Play || m_SceneState == SceneState::Physics)
+		{
+			m_PhysicsStepHistory[m_PhysicsHistoryOffset] = physicsStats.Step;
+			m_PhysicsCollideHistory[m_PhysicsHistoryOffset] = physicsStats.Collide;
+			m_PhysicsSolveHistory[m_PhysicsHistoryOffset] = physicsStats.Solve;
+			m_PhysicsBroadphaseHistory[m_PhysicsHistoryOffset] = physicsStats.Broadphase;
+			m_PhysicsHistoryOffset = (m_PhysicsHistoryOffset + 1) % s_PhysicsHistorySize;
+		}
+		ImGui::Text("Steps: %d", physicsStats.Steps);
+		ImGui::Text("Step: %.3f ms (Collide %.3f, Solve %.3f, Broadphase %.3f, TOI %.3f)",
+			physicsStats.Step, physicsStats.Collide, physicsStats.Solve, physicsStats.Broadphase, physicsStats.SolveTOI);
+		ImGui::Text("Solve: Init %.3f, Velocity %.3f, Position %.3f", physicsStats.SolveInit, physicsStats.SolveVelocity, physicsStats.SolvePosition);
+		// World counts walk every body and contact, so they are only captured while shown.
+		bool showWorldStats = ImGui::TreeNode("World");
+		m_ActiveScene->SetPhysicsWorldStatsEnabled(showWorldStats);
+		if (showWorldStats)
+		{
+			ImGui::Text("Bodies: %d (Awake %d)", physicsStats.BodyCount, physicsStats.AwakeBodyCount);
+			ImGui::Text("Contacts: %d (Touching %d)", physicsStats.ContactCount, physicsStats.TouchingContactCount);
+			ImGui::Text("Proxies: %d", physicsStats.ProxyCount);
+			ImGui::Text("Islands: %d (Largest %d)", physicsStats.IslandCount, physicsStats.LargestIsland);
+			ImGui::TreePop();
+		}
+		ImGui::PlotLines("Step", m_PhysicsStepHistory, s_PhysicsHistorySize, m_PhysicsHistoryOffset, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+		ImGui::PlotLines("Collide", m_PhysicsCollideHistory, s_PhysicsHistorySize, m_PhysicsHistoryOffset, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+		ImGui::PlotLines("Solve", m_PhysicsSolveHistory, s_PhysicsHistorySize, m_PhysicsHistoryOffset, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+		ImGui::PlotLines("Broadphase", m_PhysicsBroadphaseHistory, s_PhysicsHistorySize, m_PhysicsHistoryOffset, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+
+		// Physics settings. Edited values go through the same clamp as loaded ones.
+		if (ImGui::TreeNode("Physics Settings"))
+		{
+			Physics2DSettings& settings = m_ActiveScene->GetPhysics2DSettings();
+			int maxSubsteps = (int)settings.MaxSubsteps;
+			ImGui::DragFloat("Fixed Timestep", &settings.FixedTimestep, 0.0001f, Physics2DSettings::MinFixedTimestep, 1.0f, "%.4f");
+			ImGui::DragInt("Velocity Iterations", &settings.VelocityIterations, 1.0f, 1, 100);
+			ImGui::DragInt("Position Iterations", &settings.PositionIterations, 1.0f, 1, 100);
+			if (ImGui::DragInt("Max Substeps", &maxSubsteps, 1.0f, 1, 64))
+				settings.MaxSubsteps = (uint32_t)std::max(maxSubsteps, 1);
+			ImGui::Checkbox("Interpolate", &settings.Interpolate);
+			ImGui::Checkbox("Threaded", &settings.Threaded);
+			settings.Clamp();
+			ImGui::TreePop();
+		}
+
+		// Collision pairs
+		ImGui::Separator();
+		ImGui::Text("Collision Pairs");
+		const CollisionPairStats2D& pairStats = m_ActiveScene->GetCollisionPairStats();
+		for (uint32_t a = 0; a < CollisionLayers2D::MaxLayers; a++)
+		{
+			for (uint32_t b = a; b < CollisionLayers2D::MaxLayers; b++)
+			{
+				if (pairStats.Counts[a][b] > 0)
+					ImGui::Text("%s - %s: %d", CollisionLayers2D::GetLayerName(a).c_str(), CollisionLayers2D::GetLayerName(b).c_str(), pairStats.Counts[a][b]);
+			}
+		}
+
+		// Collision layers
+		if (ImGui::TreeNode("Collision Layers"))
+		{
+			for (uint32_t i = 0; i < CollisionLayers2D::MaxLayers; i++)
+			{
+				ImGui::PushID((int)i);
+				char buffer[64];
+				strncpy_s(buffer, sizeof(buffer), CollisionLayers2D::GetLayerName(i).c_str(), sizeof(buffer) - 1);
+				ImGui::SetNextItemWidth(120.0f);
+				if (ImGui::InputText("##LayerName", buffer, sizeof(buffer)))
+					CollisionLayers2D::SetLayerName(i, buffer);
+				// Lower triangle of the symmetric matrix.
+				for (uint32_t j = 0; j <= i; j++)
+				{
+					ImGui::SameLine();
+					ImGui::PushID((int)j);
+					bool collides = CollisionLayers2D::GetCollides(i, j);
+					if (ImGui::Checkbox("##Collides", &collides))
+						CollisionLayers2D::SetCollides(i, j, collides);
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("%s - %s", CollisionLayers2D::GetLayerName(i).c_str(), CollisionLayers2D::GetLayerName(j).c_str());
+					ImGui::PopID();
+				}
+				ImGui::PopID();
+			}
+			// Changes apply to physics data created afterwards.
+			if (ImGui::Button("Save"))
+				CollisionLayers2D::Save();
+			ImGui::TreePop();
+		}
+
+		// Benchmarks
+		ImGui::Separator();
+		ImGui::Text("Benchmarks");
+		if (ImGui::Button("Physics Sync"))
+			Benchmarks::PhysicsSync();
+		if (ImGui::Button("Scene Deserialize"))
+			Benchmarks::SceneDeserialize();
+
 		ImGui::End();
 	}
 
@@ -9,6 +9,7 @@
 #include "Panels/PropertiesPanel.h"
 #include "Panels/ConsolePanel.h"
 #include "Panels/ResourceInspectorPanel.h"
+#include "Panels/ScriptProfilerPanel.h"
 
 namespace Locus
 {
@@ -27,6 +28,8 @@ namespace Locus
 		virtual void OnImGuiRender() override;
 
 		void SetSavedStatus(bool status) { m_IsSaved = status; }
+		// Called by CommandHistory after a command edited the components of an entity.
+		void OnEntityEdited(Entity entity);
 
 	private:
 		// Events
@@ -119,8 +122,17 @@ namespace Locus
 		Ref<PropertiesPanel> m_PropertiesPanel;
 		Ref<ConsolePanel> m_ConsolePanel;
 		Ref<ResourceInspectorPanel> m_ResourceInspectorPanel;
+		Ref<ScriptProfilerPanel> m_ScriptProfilerPanel;
 
 		// Layout
 		LayoutStyle m_LayoutStyle = LayoutStyle::Default;
+
+		// Debug
+		static const int s_PhysicsHistorySize = 120;
+		float m_PhysicsStepHistory[s_PhysicsHistorySize] = {};
+		float m_PhysicsCollideHistory[s_PhysicsHistorySize] = {};
+		float m_PhysicsSolveHistory[s_PhysicsHistorySize] = {};
+		float m_PhysicsBroadphaseHistory[s_PhysicsHistorySize] = {};
+		int m_PhysicsHistoryOffset = 0;
 	};
 }
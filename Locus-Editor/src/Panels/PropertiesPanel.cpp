@@ -16,6 +16,24 @@ namespace Locus
 {
 	extern Entity g_SelectedEntity;
 
+	namespace Utils
+	{
+		// Continues the outline with a 45 degree turn so the new vertex is never collinear with the last edge
+		//	and never lands on an existing vertex right away.
+		static glm::vec2 GetNextColliderVertex(const std::vector<glm::vec2>& vertices)
+		{
+			if (vertices.empty())
+				return glm::vec2(0.0f);
+			if (vertices.size() == 1)
+				return vertices.back() + glm::vec2(1.0f, 0.0f);
+
+			glm::vec2 direction = vertices.back() - vertices[vertices.size() - 2];
+			if (glm::dot(direction, direction) < 0.0001f)
+				direction = { 1.0f, 0.0f };
+			return vertices.back() + 0.5f * (direction + glm::vec2(-direction.y, direction.x));
+		}
+	}
+
 	PropertiesPanel::PropertiesPanel()
 	{
 		m_ProjectDirectory = Application::Get().GetProjectPath() / "Assets";
@@ -78,6 +96,15 @@ namespace Locus
 					ImGui::CloseCurrentPopup();
 				}
 
+				if (ImGui::MenuItem("Tilemap"))
+				{
+					if (!g_SelectedEntity.HasComponent<TilemapComponent>())
+						CommandHistory::AddCommand(new AddComponentCommand<TilemapComponent>(m_ActiveScene, g_SelectedEntity));
+					else
+						LOCUS_CORE_WARN("This entity already has a Tilemap Component");
+					ImGui::CloseCurrentPopup();
+				}
+
 				if (ImGui::MenuItem("Cube Renderer"))
 				{
 					if (!g_SelectedEntity.HasComponent<CubeRendererComponent>())
@@ -150,6 +177,15 @@ namespace Locus
 					ImGui::CloseCurrentPopup();
 				}
 
+				if (ImGui::MenuItem("Compound Collider 2D"))
+				{
+					if (!g_SelectedEntity.HasComponent<CompoundCollider2DComponent>())
+						CommandHistory::AddCommand(new AddComponentCommand<CompoundCollider2DComponent>(m_ActiveScene, g_SelectedEntity));
+					else
+						LOCUS_CORE_WARN("This entity already has a CompoundCollider2D Component");
+					ImGui::CloseCurrentPopup();
+				}
+
 				if (ImGui::MenuItem("Script"))
 				{
 					if (!g_SelectedEntity.HasComponent<ScriptComponent>())
@@ -248,19 +284,25 @@ namespace Locus
 
 	void PropertiesPanel::DrawComponents(Entity entity)
 	{
+		CommandHistory::SetTarget(entity);
+
 		// --- Tag Component --------------------------------------------------
 		if (entity.HasComponent<TagComponent>())
 		{
 			// Tag
 			ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 0.0f, ImGui::GetStyle().ItemSpacing.x });
+			// Written through the scene so its tag and group index stays current, including on undo.
+			Ref<Scene> scene = m_ActiveScene;
 			auto& tag = entity.GetComponent<TagComponent>().Tag;
-			Widgets::DrawStringControl("Tag", tag, "Empty Entity", 0, ImGui::GetWindowWidth() * 0.5f - ImGui::CalcTextSize("Tag").x - ImGui::GetStyle().FramePadding.x * 2.0f);
+			Widgets::DrawStringControl("Tag", tag, "Empty Entity", 0, ImGui::GetWindowWidth() * 0.5f - ImGui::CalcTextSize("Tag").x - ImGui::GetStyle().FramePadding.x * 2.0f,
+				[scene, entity](const std::string& value) { scene->SetEntityTag(entity, value); });
 
 			ImGui::SameLine();
 
 			// Groups TODO: replace this with dropdown
 			auto& group = entity.GetComponent<TagComponent>().Group;
-			Widgets::DrawStringControl("Group", group, "Default", 0);
+			Widgets::DrawStringControl("Group", group, "Default", 0, -1.0f,
+				[scene, entity](const std::string& value) { scene->SetEntityGroup(entity, value); });
 			ImGui::PopStyleVar();
 		}
 
@@ -359,6 +401,42 @@ namespace Locus
 				Widgets::DrawValueControl("Fade", component.Fade, 0.005f, 0.01f, "%.3f", -1.0f, -1.0f, 0.0001f, FLT_MAX);
 			});
 
+		// --- Tilemap Component ----------------------------------------------
+		DrawComponentUI<TilemapComponent>("Tilemap", entity, [this](auto& component)
+			{
+				Widgets::DrawTextureDropdown("Tileset", component.Tileset);
+				Widgets::DrawValueControl("Tileset Columns", component.TilesetSize.x, 1, 0.1f, nullptr, -1.0f, -1.0f, 1, INT_MAX);
+				Widgets::DrawValueControl("Tileset Rows", component.TilesetSize.y, 1, 0.1f, nullptr, -1.0f, -1.0f, 1, INT_MAX);
+				Widgets::DrawVec2Control("Tile Size", component.TileSize);
+				Widgets::DrawColorControl("Color", component.Color, { 1.0f, 1.0f, 1.0f, 1.0f });
+				Widgets::DrawBoolControl("Collision", component.Collision, true);
+				if (component.Collision)
+				{
+					Widgets::DrawValueControl("Friction", component.Friction, 0.3f);
+					Widgets::DrawCollisionGrid("Collision Category", component.CollisionCategory, 0x0001);
+					Widgets::DrawCollisionGrid("Collision Mask", component.CollisionMask, 0xFFFF);
+				}
+
+				// Fill tool. Edits replace the whole map so they can be undone.
+				ImGui::Separator();
+				ImGui::Text("Tiles: %d", component.Map.GetTileCount());
+				ImGui::DragInt("Tile", &m_TileBrush, 0.1f, 1, component.TilesetSize.x * component.TilesetSize.y);
+				ImGui::DragInt4("Rect", m_TileFillRect, 0.1f);
+				bool fill = ImGui::Button("Fill");
+				ImGui::SameLine();
+				bool erase = ImGui::Button("Erase");
+				if (fill || erase)
+				{
+					Tilemap map = component.Map;
+					for (int y = m_TileFillRect[1]; y < m_TileFillRect[1] + m_TileFillRect[3]; y++)
+					{
+						for (int x = m_TileFillRect[0]; x < m_TileFillRect[0] + m_TileFillRect[2]; x++)
+							map.SetTile(x, y, fill ? (uint16_t)m_TileBrush : 0);
+					}
+					CommandHistory::AddCommand(new ChangeValueCommand(map, component.Map));
+				}
+			});
+
 		// --- Cube Renderer Component ----------------------------------------
 		DrawComponentUI<CubeRendererComponent>("Cube Renderer", entity, [this](auto& component) 
 			{
@@ -480,6 +558,103 @@ namespace Locus
 				Widgets::DrawVec2Control("Offset", component.Offset, { 0.0f, 0.0f });
 			});
 
+		// --- CompoundCollider2D Component -----------------------------------
+		DrawComponentUI<CompoundCollider2DComponent>("Compound Collider 2D", entity, [this](auto& component)
+			{
+				const char* shapeTypeStrings[] = { "Box", "Circle", "Polygon", "Edge", "Chain" };
+				int removeIndex = -1;
+				for (int i = 0; i < component.Shapes.size(); i++)
+				{
+					ColliderShape2D& shape = component.Shapes[i];
+					ImGui::PushID(i);
+					bool open = ImGui::TreeNodeEx("##Shape", ImGuiTreeNodeFlags_DefaultOpen, "%s %d", shapeTypeStrings[(int)shape.Type], i);
+					ImGui::SameLine(ImGui::GetContentRegionAvail().x - 20.0f);
+					if (ImGui::SmallButton("-"))
+						removeIndex = i;
+					if (open)
+					{
+						// Shape type dropdown
+						ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 0.0f, ImGui::GetStyle().ItemSpacing.y });
+						Widgets::DrawControlLabel("Type", { ImGui::GetContentRegionAvail().x * 0.5f, 0.0f });
+						ImGui::SameLine();
+						ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+						if (ImGui::BeginCombo("##Type", shapeTypeStrings[(int)shape.Type]))
+						{
+							for (int type = 0; type < 5; type++)
+							{
+								bool isSelected = (int)shape.Type == type;
+								if (ImGui::Selectable(shapeTypeStrings[type], isSelected))
+									CommandHistory::AddCommand(new ChangeValueCommand((ColliderShape2DType)type, shape.Type));
+								if (isSelected)
+									ImGui::SetItemDefaultFocus();
+							}
+							ImGui::EndCombo();
+						}
+						ImGui::PopItemWidth();
+						ImGui::PopStyleVar();
+
+						Widgets::DrawValueControl("Friction", shape.Friction, 0.3f);
+						Widgets::DrawValueControl("Restitution", shape.Restitution, 0.0f);
+						Widgets::DrawValueControl("Restitution Threshold", shape.RestitutionThreshold, 1.0f);
+						Widgets::DrawCollisionGrid("Collision Category", shape.CollisionCategory, 0x0001);
+						Widgets::DrawCollisionGrid("Collision Mask", shape.CollisionMask, 0xFFFF);
+						Widgets::DrawVec2Control("Offset", shape.Offset, { 0.0f, 0.0f });
+
+						switch (shape.Type)
+						{
+						case ColliderShape2DType::Box: Widgets::DrawVec2Control("Size", shape.Size); break;
+						case ColliderShape2DType::Circle: Widgets::DrawValueControl("Radius", shape.Radius, 0.5f); break;
+						default:
+						{
+							if (shape.Type == ColliderShape2DType::Chain)
+								Widgets::DrawBoolControl("Loop", shape.Loop);
+
+							// Vertices
+							int removeVertex = -1;
+							for (int v = 0; v < shape.Vertices.size(); v++)
+							{
+								ImGui::PushID(v);
+								Widgets::DrawVec2Control("Vertex " + std::to_string(v), shape.Vertices[v], { 0.0f, 0.0f });
+								ImGui::SameLine();
+								if (ImGui::SmallButton("-"))
+									removeVertex = v;
+								ImGui::PopID();
+							}
+							if (removeVertex >= 0)
+							{
+								std::vector<glm::vec2> vertices = shape.Vertices;
+								vertices.erase(vertices.begin() + removeVertex);
+								CommandHistory::AddCommand(new ChangeValueCommand(vertices, shape.Vertices));
+							}
+							if (ImGui::Button("Add Vertex"))
+							{
+								std::vector<glm::vec2> vertices = shape.Vertices;
+								vertices.push_back(Utils::GetNextColliderVertex(vertices));
+								CommandHistory::AddCommand(new ChangeValueCommand(vertices, shape.Vertices));
+							}
+							break;
+						}
+						}
+						ImGui::TreePop();
+					}
+					ImGui::PopID();
+				}
+
+				// Shapes are edited through whole-list commands so adding and removing can be undone.
+				if (removeIndex >= 0)
+				{
+					std::vector<ColliderShape2D> shapes = component.Shapes;
+					shapes.erase(shapes.begin() + removeIndex);
+					CommandHistory::AddCommand(new ChangeValueCommand(shapes, component.Shapes));
+				}
+				if (ImGui::Button("Add Shape"))
+				{
+					std::vector<ColliderShape2D> shapes = component.Shapes;
+					shapes.emplace_back();
+					CommandHistory::AddCommand(new ChangeValueCommand(shapes, component.Shapes));
+				}
+			});
+
 		// --- Script ---------------------------------------------------------
 		DrawComponentUI<ScriptComponent>("Script", entity, [this, entity](auto& component) mutable
 			{
@@ -505,7 +680,7 @@ namespace Locus
 							if (ImGui::Selectable(m_ScriptClasses[i].c_str(), isSelected))
 							{
 								CommandHistory::AddCommand(new ChangeValueCommand(m_ScriptClasses[i], component.ScriptClass));
-								ScriptEngine::GetFieldInstances(entity.GetUUID()).clear(); // Could cause error if undoing
+								ScriptEngine::ClearFieldInstances(entity.GetUUID()); // Could cause error if undoing
 							}
 							if (isSelected)
 								ImGui::SetItemDefaultFocus();
@@ -520,6 +695,8 @@ namespace Locus
 				if (Application::Get().IsRunning())
 					DrawScriptFields(entity, component);
 			});
+
+		CommandHistory::SetTarget(Entity::Null);
 	}
 
 	void PropertiesPanel::DrawScriptFields(Entity entity, ScriptComponent& component)
@@ -601,68 +778,34 @@ namespace Locus
 				}
 				else // Editor controls
 				{
-					auto& fieldInstances = ScriptEngine::GetFieldInstances(entity.GetUUID());
-					// Create a ScriptClassFieldInstance if not contained in fieldInstances. Then set the default value defined in the C# script.
-					if (fieldInstances.find(name) == fieldInstances.end())
-					{
-						ScriptClassFieldInstance& scriptField = fieldInstances[name];
-						scriptField.Field = field;
-						
-						if (field.Type == FieldType::SystemSingle)
-							scriptField.SetValue(scriptClass->GetFieldValue<float>(name));
-						else if (field.Type == FieldType::SystemDouble)
-							scriptField.SetValue(scriptClass->GetFieldValue<double>(name));
-						else if (field.Type == FieldType::SystemShort)
-							scriptField.SetValue(scriptClass->GetFieldValue<int16_t>(name));
-						else if (field.Type == FieldType::SystemInt)
-							scriptField.SetValue(scriptClass->GetFieldValue<int>(name));
-						else if (field.Type == FieldType::SystemLong)
-							scriptField.SetValue(scriptClass->GetFieldValue<int64_t>(name));
-						else if (field.Type == FieldType::SystemUShort)
-							scriptField.SetValue(scriptClass->GetFieldValue<uint16_t>(name));
-						else if (field.Type == FieldType::SystemUInt)
-							scriptField.SetValue(scriptClass->GetFieldValue<uint32_t>(name));
-						else if (field.Type == FieldType::SystemULong)
-							scriptField.SetValue(scriptClass->GetFieldValue<uint64_t>(name));
-						else if (field.Type == FieldType::SystemBoolean)
-							scriptField.SetValue(scriptClass->GetFieldValue<bool>(name));
-						else if (field.Type == FieldType::SystemChar)
-							scriptField.SetValue(scriptClass->GetFieldValue<char>(name));
-						else if (field.Type == FieldType::LocusVec2)
-							scriptField.SetValue(scriptClass->GetFieldValue<glm::vec2>(name));
-						else if (field.Type == FieldType::LocusVec3)
-							scriptField.SetValue(scriptClass->GetFieldValue<glm::vec3>(name));
-					}
-					else
-					{
-						// Draw field controls to editor.
-						ScriptClassFieldInstance& scriptField = fieldInstances.at(name);
-
-						if (field.Type == FieldType::SystemSingle)
-							Widgets::DrawValueControl<float>(name, *(float*)scriptField.m_Buffer, scriptClass->GetFieldValue<float>(name));
-						else if (field.Type == FieldType::SystemDouble)
-							Widgets::DrawValueControl<double>(name, *(double*)scriptField.m_Buffer, scriptClass->GetFieldValue<double>(name));
-						else if (field.Type == FieldType::SystemShort)
-							Widgets::DrawValueControl<int16_t>(name, *(int16_t*)scriptField.m_Buffer, scriptClass->GetFieldValue<int16_t>(name));
-						else if (field.Type == FieldType::SystemInt)
-							Widgets::DrawValueControl<int>(name, *(int*)scriptField.m_Buffer, scriptClass->GetFieldValue<int>(name));
-						else if (field.Type == FieldType::SystemLong)
-							Widgets::DrawValueControl<int64_t>(name, *(int64_t*)scriptField.m_Buffer, scriptClass->GetFieldValue<int64_t>(name));
-						else if (field.Type == FieldType::SystemUShort)
-							Widgets::DrawValueControl<uint16_t>(name, *(uint16_t*)scriptField.m_Buffer, scriptClass->GetFieldValue<uint16_t>(name));
-						else if (field.Type == FieldType::SystemUInt)
-							Widgets::DrawValueControl<uint32_t>(name, *(uint32_t*)scriptField.m_Buffer, scriptClass->GetFieldValue<uint32_t>(name));
-						else if (field.Type == FieldType::SystemULong)
-							Widgets::DrawValueControl<uint64_t>(name, *(uint64_t*)scriptField.m_Buffer, scriptClass->GetFieldValue<uint64_t>(name));
-						else if (field.Type == FieldType::SystemBoolean)
-							Widgets::DrawBoolControl(name, *(bool*)scriptField.m_Buffer, scriptClass->GetFieldValue<bool>(name));
-						else if (field.Type == FieldType::SystemChar)
-							Widgets::DrawCharControl(name, *(char*)scriptField.m_Buffer, scriptClass->GetFieldValue<char>(name));
-						else if (field.Type == FieldType::LocusVec2)
-							Widgets::DrawVec2Control(name, *(glm::vec2*)scriptField.m_Buffer, scriptClass->GetFieldValue<glm::vec2>(name));
-						else if (field.Type == FieldType::LocusVec3)
-							Widgets::DrawVec3Control(name, *(glm::vec3*)scriptField.m_Buffer, scriptClass->GetFieldValue<glm::vec3>(name));
-					}
+					// Field instances start from the defaults defined in the C# script.
+					ScriptFieldInstances& fieldInstances = ScriptEngine::GetFieldInstances(entity.GetUUID(), scriptClass);
+
+					// Draw field controls to editor.
+					if (field.Type == FieldType::SystemSingle)
+						Widgets::DrawValueControl<float>(name, fieldInstances.GetValueRef<float>(field), scriptClass->GetFieldValue<float>(name));
+					else if (field.Type == FieldType::SystemDouble)
+						Widgets::DrawValueControl<double>(name, fieldInstances.GetValueRef<double>(field), scriptClass->GetFieldValue<double>(name));
+					else if (field.Type == FieldType::SystemShort)
+						Widgets::DrawValueControl<int16_t>(name, fieldInstances.GetValueRef<int16_t>(field), scriptClass->GetFieldValue<int16_t>(name));
+					else if (field.Type == FieldType::SystemInt)
+						Widgets::DrawValueControl<int>(name, fieldInstances.GetValueRef<int>(field), scriptClass->GetFieldValue<int>(name));
+					else if (field.Type == FieldType::SystemLong)
+						Widgets::DrawValueControl<int64_t>(name, fieldInstances.GetValueRef<int64_t>(field), scriptClass->GetFieldValue<int64_t>(name));
+					else if (field.Type == FieldType::SystemUShort)
+						Widgets::DrawValueControl<uint16_t>(name, fieldInstances.GetValueRef<uint16_t>(field), scriptClass->GetFieldValue<uint16_t>(name));
+					else if (field.Type == FieldType::SystemUInt)
+						Widgets::DrawValueControl<uint32_t>(name, fieldInstances.GetValueRef<uint32_t>(field), scriptClass->GetFieldValue<uint32_t>(name));
+					else if (field.Type == FieldType::SystemULong)
+						Widgets::DrawValueControl<uint64_t>(name, fieldInstances.GetValueRef<uint64_t>(field), scriptClass->GetFieldValue<uint64_t>(name));
+					else if (field.Type == FieldType::SystemBoolean)
+						Widgets::DrawBoolControl(name, fieldInstances.GetValueRef<bool>(field), scriptClass->GetFieldValue<bool>(name));
+					else if (field.Type == FieldType::SystemChar)
+						Widgets::DrawCharControl(name, fieldInstances.GetValueRef<char>(field), scriptClass->GetFieldValue<char>(name));
+					else if (field.Type == FieldType::LocusVec2)
+						Widgets::DrawVec2Control(name, fieldInstances.GetValueRef<glm::vec2>(field), scriptClass->GetFieldValue<glm::vec2>(name));
+					else if (field.Type == FieldType::LocusVec3)
+						Widgets::DrawVec3Control(name, fieldInstances.GetValueRef<glm::vec3>(field), scriptClass->GetFieldValue<glm::vec3>(name));
 				}
 			}
 		}
@@ -686,6 +829,11 @@ namespace Locus
 			m_ClipboardComponent.CircleRenderer = CreateRef<CircleRendererComponent>(g_SelectedEntity.GetComponent<CircleRendererComponent>());
 			m_ClipboardComponentType = ComponentType::CircleRenderer;
 		}
+		if (typeid(T) == typeid(TilemapComponent))
+		{
+			m_ClipboardComponent.Tilemap = CreateRef<TilemapComponent>(g_SelectedEntity.GetComponent<TilemapComponent>());
+			m_ClipboardComponentType = ComponentType::Tilemap;
+		}
 		if (typeid(T) == typeid(CubeRendererComponent))
 		{
 			m_ClipboardComponent.CubeRenderer = CreateRef<CubeRendererComponent>(g_SelectedEntity.GetComponent<CubeRendererComponent>());
@@ -716,6 +864,11 @@ namespace Locus
 			m_ClipboardComponent.CircleCollider2D = CreateRef<CircleCollider2DComponent>(g_SelectedEntity.GetComponent<CircleCollider2DComponent>());
 			m_ClipboardComponentType = ComponentType::CircleCollider2D;
 		}
+		if (typeid(T) == typeid(CompoundCollider2DComponent))
+		{
+			m_ClipboardComponent.CompoundCollider2D = CreateRef<CompoundCollider2DComponent>(g_SelectedEntity.GetComponent<CompoundCollider2DComponent>());
+			m_ClipboardComponentType = ComponentType::CompoundCollider2D;
+		}
 		if (typeid(T) == typeid(ScriptComponent))
 		{
 			m_ClipboardComponent.Script = CreateRef<ScriptComponent>(g_SelectedEntity.GetComponent<ScriptComponent>());
@@ -735,6 +888,8 @@ namespace Locus
 			break;
 		case Locus::ComponentType::CircleRenderer: selectedEntity.AddOrReplaceComponent<CircleRendererComponent>(*m_ClipboardComponent.CircleRenderer);
 			break;
+		case Locus::ComponentType::Tilemap: selectedEntity.AddOrReplaceComponent<TilemapComponent>(*m_ClipboardComponent.Tilemap);
+			break;
 		case Locus::ComponentType::CubeRenderer: selectedEntity.AddOrReplaceComponent<CubeRendererComponent>(*m_ClipboardComponent.CubeRenderer);
 			break;
 		case Locus::ComponentType::PointLight: selectedEntity.AddOrReplaceComponent<PointLightComponent>(*m_ClipboardComponent.PointLight);
@@ -747,6 +902,8 @@ namespace Locus
 			break;
 		case Locus::ComponentType::CircleCollider2D: selectedEntity.AddOrReplaceComponent<CircleCollider2DComponent>(*m_ClipboardComponent.CircleCollider2D);
 			break;
+		case Locus::ComponentType::CompoundCollider2D: selectedEntity.AddOrReplaceComponent<CompoundCollider2DComponent>(*m_ClipboardComponent.CompoundCollider2D);
+			break;
 		case Locus::ComponentType::Script: selectedEntity.AddOrReplaceComponent<ScriptComponent>(*m_ClipboardComponent.Script);
 			break;
 		default:
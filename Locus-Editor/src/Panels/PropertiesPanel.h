@@ -41,6 +41,10 @@ namespace Locus
 		// Script
 		std::vector<std::string> m_ScriptClasses;
 
+		// Tilemap fill tool
+		int m_TileBrush = 1;
+		int m_TileFillRect[4] = { 0, 0, 16, 16 }; // X, Y, Width, Height
+
 		ComponentData m_ClipboardComponent;
 		ComponentType m_ClipboardComponentType = ComponentType::None;
 
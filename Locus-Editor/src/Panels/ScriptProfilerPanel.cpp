@@ -0,0 +1,97 @@
+#include "Lpch.h"
+#include "ScriptProfilerPanel.h"
+
+#include <ImGui/imgui.h>
+
+#include "Locus/Scripting/ScriptProfiler.h"
+
+namespace Locus
+{
+	void ScriptProfilerPanel::OnImGuiRender()
+	{
+		ImGuiWindowFlags windowFlags = ImGuiWindowFlags_TabBarAlignLeft | ImGuiWindowFlags_DockedWindowBorder;
+		ImGui::Begin("Script Profiler", false, windowFlags);
+
+		bool enabled = ScriptProfiler::IsEnabled();
+		if (ImGui::Checkbox("Enable", &enabled))
+			ScriptProfiler::SetEnabled(enabled);
+
+		if (ScriptProfiler::IsActive())
+		{
+			DrawGCStats();
+			ImGui::Separator();
+			DrawClassTable();
+		}
+		else
+		{
+			ImGui::TextDisabled("Enable to time script callbacks while playing.");
+		}
+
+		ImGui::End();
+	}
+
+	void ScriptProfilerPanel::DrawGCStats()
+	{
+		const ScriptGCStats& gc = ScriptProfiler::GetGCStats();
+		ImGui::Text("GC Heap: %.1f / %.1f KB", (float)gc.UsedSize / 1024.0f, (float)gc.HeapSize / 1024.0f);
+		ImGui::Text("GC Collections this frame: %d", gc.FrameCollections);
+		for (size_t i = 0; i < gc.Collections.size(); i++)
+		{
+			ImGui::SameLine();
+			ImGui::Text(" Gen %d: %d", (int)i, gc.Collections[i]);
+		}
+
+		const ScriptCallbackStats& dispatch = ScriptProfiler::GetCollisionDispatchStats();
+		ImGui::Text("Collision Dispatch: %.3f ms", dispatch.Milliseconds);
+	}
+
+	void ScriptProfilerPanel::DrawClassTable()
+	{
+		const std::vector<ScriptClassProfile>& profiles = ScriptProfiler::GetClassProfiles();
+
+		// Slowest OnUpdate first.
+		std::vector<uint32_t> order(profiles.size());
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [&profiles](uint32_t a, uint32_t b)
+		{
+			return profiles[a].Frame[(size_t)ScriptCallback::OnUpdate].Milliseconds > profiles[b].Frame[(size_t)ScriptCallback::OnUpdate].Milliseconds;
+		});
+
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg;
+		if (ImGui::BeginTable("ScriptProfilerTable", 6, tableFlags))
+		{
+			ImGui::TableSetupColumn("Class");
+			ImGui::TableSetupColumn("OnUpdate (ms)");
+			ImGui::TableSetupColumn("Calls");
+			ImGui::TableSetupColumn("Avg (us)");
+			ImGui::TableSetupColumn("OnCreate (ms)");
+			ImGui::TableSetupColumn("Collisions");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t index : order)
+			{
+				const ScriptClassProfile& profile = profiles[index];
+				const ScriptCallbackStats& update = profile.Frame[(size_t)ScriptCallback::OnUpdate];
+				const ScriptCallbackStats& create = profile.Total[(size_t)ScriptCallback::OnCreate];
+				const ScriptCallbackStats& collision = profile.Frame[(size_t)ScriptCallback::Collision];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(profile.ClassName.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", update.Milliseconds);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", update.Calls);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", update.Calls > 0 ? update.Milliseconds * 1000.0f / (float)update.Calls : 0.0f);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", create.Milliseconds);
+				ImGui::TableNextColumn();
+				ImGui::Text("%d", collision.Calls);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+}
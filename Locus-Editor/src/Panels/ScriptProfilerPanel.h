@@ -0,0 +1,17 @@
+#pragma once
+
+namespace Locus
+{
+	class ScriptProfilerPanel
+	{
+	public:
+		ScriptProfilerPanel() = default;
+		~ScriptProfilerPanel() = default;
+
+		void OnImGuiRender();
+
+	private:
+		void DrawGCStats();
+		void DrawClassTable();
+	};
+}
@@ -113,7 +113,8 @@ namespace Locus::Widgets
 		ImGui::PopStyleVar();
 	}
 
-	void DrawStringControl(const std::string& name, std::string& changeValue, const std::string& resetValue, float labelWidth, float inputWidth)
+	void DrawStringControl(const std::string& name, std::string& changeValue, const std::string& resetValue, float labelWidth, float inputWidth,
+		std::function<void(const std::string&)> setter)
 	{
 		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 0.0f, ImGui::GetStyle().ItemSpacing.y });
 
@@ -128,7 +129,12 @@ namespace Locus::Widgets
 		{
 			ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
 			if (ImGui::IsMouseDoubleClicked(0))
-				CommandHistory::AddCommand(new ChangeValueCommand(resetValue, changeValue));
+			{
+				if (setter)
+					CommandHistory::AddCommand(new ChangeFunctionValueCommand(setter, resetValue, changeValue));
+				else
+					CommandHistory::AddCommand(new ChangeValueCommand(resetValue, changeValue));
+			}
 		}
 
 		// For some reason ImGui::InputText doesnt like a single char*
@@ -140,6 +146,9 @@ namespace Locus::Widgets
 		ImGui::PushItemWidth(inputWidth);
 		if (ImGui::InputText(label.c_str(), buffer, sizeof(buffer), flags))
 		{
+			if (setter)
+				CommandHistory::AddCommand(new ChangeFunctionValueCommand(setter, std::string(buffer), changeValue));
+			else
 				CommandHistory::AddCommand(new ChangeValueCommand(std::string(buffer), changeValue));
 		}
 
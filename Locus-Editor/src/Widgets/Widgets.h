@@ -22,7 +22,9 @@ namespace Locus::Widgets
 
 	void DrawCharControl(const std::string& name, char& changeValue, char resetValue = ' ', float labelWidth = -1.0f, float inputWidth = -1.0f, Ref<ScriptInstance> instance = nullptr);
 
-	void DrawStringControl(const std::string& name, std::string& changeValue, const std::string& resetValue = std::string(), float labelWidth = -1.0f, float inputWidth = -1.0f);
+	// Values that need to notify their owner, eg. a tag, pass a setter that the command calls instead of writing changeValue.
+	void DrawStringControl(const std::string& name, std::string& changeValue, const std::string& resetValue = std::string(), float labelWidth = -1.0f, float inputWidth = -1.0f,
+		std::function<void(const std::string&)> setter = nullptr);
 
 	void DrawColorControl(const std::string& name, glm::vec4& changeValue, const glm::vec4& resetValue = glm::vec4(1.0f), float labelWidth = -1.0f, float inputWidth = -1.0f);
 
@@ -12,6 +12,7 @@ int main(int argc, char** argv)
 		LOCUS_PROFILE_BEGIN_SESSION("Startup", "LocusProfile-Startup.log");
 		Locus::Application* app = new Locus::Application("Locus Editor", argv[1], argv[2]);
 		app->PushLayer(new Locus::LocusEditorLayer());
+		app->SetRenderThreadEnabled(true);
 		LOCUS_PROFILE_END_SESSION();
 
 		LOCUS_PROFILE_BEGIN_SESSION("Runtime", "LocusProfile-Runtime.log");
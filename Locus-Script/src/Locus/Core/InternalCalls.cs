@@ -15,37 +15,53 @@ namespace Locus
 
 		// --- Entity ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static ulong Entity_CreateEntity();
+		internal extern static ulong Entity_CreateEntity(out uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static bool Entity_HasComponent(ulong id, Type componentType);
+		internal extern static uint Entity_GetHandle(ulong id);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Entity_AddComponent(ulong id, Type componentType);
+		internal extern static bool Entity_IsValid(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static ulong Entity_Find(string tag);
+		internal extern static bool Entity_HasComponent(ulong id, uint handle, Type componentType);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Entity_Destroy(ulong id);
+		internal extern static void Entity_AddComponent(ulong id, uint handle, Type componentType);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static string Entity_GetTag(ulong id);
+		internal extern static ulong Entity_Find(string tag, out uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Entity_SetTag(ulong id, string newTag);
+		internal extern static int Entity_FindAll(string tag, ulong[] ids, uint[] handles);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static string Entity_GetGroup(ulong id);
+		internal extern static int Entity_GetGroupEntities(string group, ulong[] ids, uint[] handles);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Entity_SetGroup(ulong id, string newTag);
+		internal extern static void Entity_Destroy(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static bool Entity_GetEnabled(ulong id);
+		internal extern static string Entity_GetTag(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Entity_SetEnabled(ulong id, bool newEnabled);
+		internal extern static void Entity_SetTag(ulong id, uint handle, string newTag);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static string Entity_GetGroup(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_SetGroup(ulong id, uint handle, string newTag);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool Entity_GetEnabled(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_SetEnabled(ulong id, uint handle, bool newEnabled);
+
+		// --- Scene ---
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static int Scene_QueryEntities(Type componentType, ulong[] ids, uint[] handles);
 
 		// --- Vec2 ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
@@ -73,124 +89,164 @@ namespace Locus
 
 		// --- Transform Component ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetLocalTransform(ulong id, out Mat4 output);
+		internal extern static void TransformComponent_GetLocalTransform(ulong id, uint handle, out Mat4 output);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_GetWorldTransform(ulong id, uint handle, out Mat4 output);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_GetLocalPosition(ulong id, uint handle, out Vec3 output);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_SetLocalPosition(ulong id, uint handle, ref Vec3 newPos);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_GetLocalRotationEuler(ulong id, uint handle, out Vec3 output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetWorldTransform(ulong id, out Mat4 output);
+		internal extern static void TransformComponent_SetLocalRotationEuler(ulong id, uint handle, ref Vec3 newRot);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetLocalPosition(ulong id, out Vec3 output);
+		internal extern static void TransformComponent_GetLocalScale(ulong id, uint handle, out Vec3 output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_SetLocalPosition(ulong id, ref Vec3 newPos);
+		internal extern static void TransformComponent_SetLocalScale(ulong id, uint handle, ref Vec3 newScale);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetLocalRotationEuler(ulong id, out Vec3 output);
+		internal extern static void TransformComponent_GetWorldToLocal(ulong id, uint handle, out Mat4 output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_SetLocalRotationEuler(ulong id, ref Vec3 newRot);
+		internal extern static void TransformComponent_GetLocalPositions(ulong[] ids, uint[] handles, int count, Vec3[] output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetLocalScale(ulong id, out Vec3 output);
+		internal extern static void TransformComponent_SetLocalPositions(ulong[] ids, uint[] handles, int count, Vec3[] newPositions);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_SetLocalScale(ulong id, ref Vec3 newScale);
+		internal extern static void TransformComponent_GetLocalRotationsEuler(ulong[] ids, uint[] handles, int count, Vec3[] output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void TransformComponent_GetWorldToLocal(ulong id, out Mat4 output);
+		internal extern static void TransformComponent_SetLocalRotationsEuler(ulong[] ids, uint[] handles, int count, Vec3[] newRotations);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_GetLocalScales(ulong[] ids, uint[] handles, int count, Vec3[] output);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TransformComponent_SetLocalScales(ulong[] ids, uint[] handles, int count, Vec3[] newScales);
 
 		// --- Sprite Renderer Component ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void SpriteRendererComponent_GetColor(ulong id, out Color output);
+		internal extern static void SpriteRendererComponent_GetColor(ulong id, uint handle, out Color output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void SpriteRendererComponent_SetColor(ulong id, ref Color newColor);
+		internal extern static void SpriteRendererComponent_SetColor(ulong id, uint handle, ref Color newColor);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float SpriteRendererComponent_GetTilingFactor(ulong id);
+		internal extern static void SpriteRendererComponent_GetColors(ulong[] ids, uint[] handles, int count, Color[] output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void SpriteRendererComponent_SetTilingFactor(ulong id, float newTF);
+		internal extern static void SpriteRendererComponent_SetColors(ulong[] ids, uint[] handles, int count, Color[] newColors);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static float SpriteRendererComponent_GetTilingFactor(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void SpriteRendererComponent_SetTilingFactor(ulong id, uint handle, float newTF);
 
 		// --- Circle Renderer Component ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void CircleRendererComponent_GetColor(ulong id, out Color output);
+		internal extern static void CircleRendererComponent_GetColor(ulong id, uint handle, out Color output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void CircleRendererComponent_SetColor(ulong id, ref Color newColor);
+		internal extern static void CircleRendererComponent_SetColor(ulong id, uint handle, ref Color newColor);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float CircleRendererComponent_GetThickness(ulong id);
+		internal extern static float CircleRendererComponent_GetThickness(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void CircleRendererComponent_SetThickness(ulong id, float newThickness);
+		internal extern static void CircleRendererComponent_SetThickness(ulong id, uint handle, float newThickness);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float CircleRendererComponent_GetFade(ulong id);
+		internal extern static float CircleRendererComponent_GetFade(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void CircleRendererComponent_SetFade(ulong id, float newFade);
+		internal extern static void CircleRendererComponent_SetFade(ulong id, uint handle, float newFade);
 
 		// --- Rigidbody2D Component ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static int Rigidbody2DComponent_GetBodyType(ulong id);
+		internal extern static int Rigidbody2DComponent_GetBodyType(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Rigidbody2DComponent_SetBodyType(ulong id, uint handle, int newBodyType);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static float Rigidbody2DComponent_GetMass(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Rigidbody2DComponent_SetMass(ulong id, uint handle, float newMass);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static float Rigidbody2DComponent_GetGravityScale(ulong id, uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Rigidbody2DComponent_SetGravityScale(ulong id, uint handle, float newGravityScale);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetBodyType(ulong id, int newBodyType);
+		internal extern static float Rigidbody2DComponent_GetLinearDamping(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float Rigidbody2DComponent_GetMass(ulong id);
+		internal extern static void Rigidbody2DComponent_SetLinearDamping(ulong id, uint handle, float newLinearDamping);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetMass(ulong id, float newMass);
+		internal extern static float Rigidbody2DComponent_GetAngularDamping(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float Rigidbody2DComponent_GetGravityScale(ulong id);
+		internal extern static void Rigidbody2DComponent_SetAngularDamping(ulong id, uint handle, float newAngularDamping);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetGravityScale(ulong id, float newGravityScale);
+		internal extern static bool Rigidbody2DComponent_GetFixedRotation(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float Rigidbody2DComponent_GetLinearDamping(ulong id);
+		internal extern static void Rigidbody2DComponent_SetFixedRotation(ulong id, uint handle, bool newFixedRotation);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetLinearDamping(ulong id, float newLinearDamping);
+		internal extern static bool Rigidbody2DComponent_GetIsBullet(ulong id, uint handle);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static float Rigidbody2DComponent_GetAngularDamping(ulong id);
+		internal extern static void Rigidbody2DComponent_SetIsBullet(ulong id, uint handle, bool newIsBullet);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetAngularDamping(ulong id, float newAngularDamping);
+		internal extern static void Rigidbody2DComponent_AddForce(ulong id, uint handle, ref Vec2 force);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static bool Rigidbody2DComponent_GetFixedRotation(ulong id);
+		internal extern static void Rigidbody2DComponent_AddLinearImpulse(ulong id, uint handle, ref Vec2 impulse);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetFixedRotation(ulong id, bool newFixedRotation);
+		internal extern static void Rigidbody2DComponent_GetPosition(ulong id, uint handle, out Vec2 output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static bool Rigidbody2DComponent_GetIsBullet(ulong id);
+		internal extern static void Rigidbody2DComponent_SetPosition(ulong id, uint handle, ref Vec2 newPos);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetIsBullet(ulong id, bool newIsBullet);
+		internal extern static void Rigidbody2DComponent_GetVelocity(ulong id, uint handle, out Vec2 output);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_AddForce(ulong id, ref Vec2 force);
+		internal extern static void Rigidbody2DComponent_SetVelocity(ulong id, uint handle, ref Vec2 newVelocity);
 
+		// --- Physics2D ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_AddLinearImpulse(ulong id, ref Vec2 impulse);
+		internal extern static bool Physics2D_Raycast(ref Vec2 origin, ref Vec2 direction, float distance, ushort mask, out RaycastHit2D hit);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_GetPosition(ulong id, out Vec2 output);
+		internal extern static int Physics2D_RaycastAll(ref Vec2 origin, ref Vec2 direction, float distance, ushort mask, RaycastHit2D[] hits);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetPosition(ulong id, ref Vec2 newPos);
+		internal extern static int Physics2D_OverlapAABB(ref Vec2 min, ref Vec2 max, ushort mask, ulong[] results);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_GetVelocity(ulong id, out Vec2 output);
+		internal extern static int Physics2D_OverlapCircle(ref Vec2 center, float radius, ushort mask, ulong[] results);
 
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
-		internal extern static void Rigidbody2DComponent_SetVelocity(ulong id, ref Vec2 newVelocity);
+		internal extern static int Physics2D_OverlapBox(ref Vec2 center, ref Vec2 size, float angle, ushort mask, ulong[] results);
 
 		// --- Input ---
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
@@ -1,4 +1,5 @@
 ﻿// --- Physics ----------------------------------------------------------------
+using System.Runtime.InteropServices;
 
 namespace Locus
 {
@@ -14,4 +15,67 @@ namespace Locus
 		/// <summary> Kinematic rigidbody. </summary>
 		Kinematic
 	}
+
+	/// <summary>
+	/// Result of a 2D raycast.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct RaycastHit2D
+	{
+		/// <summary> ID of the entity that was hit. </summary>
+		public ulong EntityID;
+		/// <summary> World position of the hit. </summary>
+		public Vec2 Point;
+		/// <summary> Surface normal at the hit. </summary>
+		public Vec2 Normal;
+		/// <summary> Distance along the ray from 0 (origin) to 1 (max distance). </summary>
+		public float Fraction;
+
+		/// <summary> The entity that was hit. </summary>
+		public Entity Entity => new Entity(EntityID);
+	}
+
+	/// <summary>
+	/// 2D physics queries against the running scene. Queries use the physics broadphase and
+	/// write into arrays owned by the caller so they can be reused every frame.
+	/// Fixtures are ignored unless their collision category is in mask.
+	/// </summary>
+	public static class Physics2D
+	{
+		/// <summary>
+		/// Casts a ray and returns the closest hit. Returns false if nothing was hit.
+		/// </summary>
+		public static bool Raycast(Vec2 origin, Vec2 direction, float distance, out RaycastHit2D hit, ushort mask = 0xFFFF)
+		{
+			return InternalCalls.Physics2D_Raycast(ref origin, ref direction, distance, mask, out hit);
+		}
+		/// <summary>
+		/// Casts a ray and fills hits sorted by distance. Returns the number of hits written.
+		/// </summary>
+		public static int RaycastAll(Vec2 origin, Vec2 direction, float distance, RaycastHit2D[] hits, ushort mask = 0xFFFF)
+		{
+			return InternalCalls.Physics2D_RaycastAll(ref origin, ref direction, distance, mask, hits);
+		}
+		/// <summary>
+		/// Fills results with the IDs of entities overlapping the axis aligned box. Returns the number written.
+		/// </summary>
+		public static int OverlapAABB(Vec2 min, Vec2 max, ulong[] results, ushort mask = 0xFFFF)
+		{
+			return InternalCalls.Physics2D_OverlapAABB(ref min, ref max, mask, results);
+		}
+		/// <summary>
+		/// Fills results with the IDs of entities overlapping the circle. Returns the number written.
+		/// </summary>
+		public static int OverlapCircle(Vec2 center, float radius, ulong[] results, ushort mask = 0xFFFF)
+		{
+			return InternalCalls.Physics2D_OverlapCircle(ref center, radius, mask, results);
+		}
+		/// <summary>
+		/// Fills results with the IDs of entities overlapping the box. Angle is in degrees. Returns the number written.
+		/// </summary>
+		public static int OverlapBox(Vec2 center, Vec2 size, float angle, ulong[] results, ushort mask = 0xFFFF)
+		{
+			return InternalCalls.Physics2D_OverlapBox(ref center, ref size, angle, mask, results);
+		}
+	}
 }
@@ -30,7 +30,7 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetLocalTransform(Entity.ID, out Mat4 result);
+				InternalCalls.TransformComponent_GetLocalTransform(Entity.ID, Entity.Handle, out Mat4 result);
 				return result;
 			}
 		}
@@ -41,7 +41,7 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetWorldTransform(Entity.ID, out Mat4 result);
+				InternalCalls.TransformComponent_GetWorldTransform(Entity.ID, Entity.Handle, out Mat4 result);
 				return result;
 			}
 		}
@@ -52,10 +52,10 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetLocalPosition(Entity.ID, out Vec3 result);
+				InternalCalls.TransformComponent_GetLocalPosition(Entity.ID, Entity.Handle, out Vec3 result);
 				return result;
 			}
-			set => InternalCalls.TransformComponent_SetLocalPosition(Entity.ID, ref value);
+			set => InternalCalls.TransformComponent_SetLocalPosition(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Local euler rotation of the entity in degrees.
@@ -64,10 +64,10 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetLocalRotationEuler(Entity.ID, out Vec3 result);
+				InternalCalls.TransformComponent_GetLocalRotationEuler(Entity.ID, Entity.Handle, out Vec3 result);
 				return result;
 			}
-			set => InternalCalls.TransformComponent_SetLocalRotationEuler(Entity.ID, ref value);
+			set => InternalCalls.TransformComponent_SetLocalRotationEuler(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Local scale of the entity.
@@ -76,10 +76,10 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetLocalScale(Entity.ID, out Vec3 result);
+				InternalCalls.TransformComponent_GetLocalScale(Entity.ID, Entity.Handle, out Vec3 result);
 				return result;
 			}
-			set => InternalCalls.TransformComponent_SetLocalScale(Entity.ID, ref value);
+			set => InternalCalls.TransformComponent_SetLocalScale(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Matrix to convert world space coordinates to local space.
@@ -88,10 +88,44 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.TransformComponent_GetWorldToLocal(Entity.ID, out Mat4 result);
+				InternalCalls.TransformComponent_GetWorldToLocal(Entity.ID, Entity.Handle, out Mat4 result);
 				return result;
 			}
 		}
+
+		// --- Batched ---
+		// These read or write the component of every entity in the query in one internal call.
+		// The arrays must hold at least entities.Count elements. Entities without the component are skipped.
+		/// <summary> Writes the local position of every entity in the query into output. </summary>
+		public static void GetPositions(EntityQuery entities, Vec3[] output)
+		{
+			InternalCalls.TransformComponent_GetLocalPositions(entities.IDs, entities.Handles, entities.Count, output);
+		}
+		/// <summary> Sets the local position of every entity in the query. </summary>
+		public static void SetPositions(EntityQuery entities, Vec3[] positions)
+		{
+			InternalCalls.TransformComponent_SetLocalPositions(entities.IDs, entities.Handles, entities.Count, positions);
+		}
+		/// <summary> Writes the local euler rotation in degrees of every entity in the query into output. </summary>
+		public static void GetEulerRotations(EntityQuery entities, Vec3[] output)
+		{
+			InternalCalls.TransformComponent_GetLocalRotationsEuler(entities.IDs, entities.Handles, entities.Count, output);
+		}
+		/// <summary> Sets the local euler rotation in degrees of every entity in the query. </summary>
+		public static void SetEulerRotations(EntityQuery entities, Vec3[] rotations)
+		{
+			InternalCalls.TransformComponent_SetLocalRotationsEuler(entities.IDs, entities.Handles, entities.Count, rotations);
+		}
+		/// <summary> Writes the local scale of every entity in the query into output. </summary>
+		public static void GetScales(EntityQuery entities, Vec3[] output)
+		{
+			InternalCalls.TransformComponent_GetLocalScales(entities.IDs, entities.Handles, entities.Count, output);
+		}
+		/// <summary> Sets the local scale of every entity in the query. </summary>
+		public static void SetScales(EntityQuery entities, Vec3[] scales)
+		{
+			InternalCalls.TransformComponent_SetLocalScales(entities.IDs, entities.Handles, entities.Count, scales);
+		}
 	}
 
 
@@ -109,18 +143,30 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.SpriteRendererComponent_GetColor(Entity.ID, out Color result);
+				InternalCalls.SpriteRendererComponent_GetColor(Entity.ID, Entity.Handle, out Color result);
 				return result;
 			}
-			set => InternalCalls.SpriteRendererComponent_SetColor(Entity.ID, ref value);
+			set => InternalCalls.SpriteRendererComponent_SetColor(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Tiling factor of the attached texture.
 		/// </summary>
 		public float TilingFactor
 		{
-			get => InternalCalls.SpriteRendererComponent_GetTilingFactor(Entity.ID);
-			set => InternalCalls.SpriteRendererComponent_SetTilingFactor(Entity.ID, value);
+			get => InternalCalls.SpriteRendererComponent_GetTilingFactor(Entity.ID, Entity.Handle);
+			set => InternalCalls.SpriteRendererComponent_SetTilingFactor(Entity.ID, Entity.Handle, value);
+		}
+
+		// --- Batched ---
+		/// <summary> Writes the color of every entity in the query into output. </summary>
+		public static void GetColors(EntityQuery entities, Color[] output)
+		{
+			InternalCalls.SpriteRendererComponent_GetColors(entities.IDs, entities.Handles, entities.Count, output);
+		}
+		/// <summary> Sets the color of every entity in the query. </summary>
+		public static void SetColors(EntityQuery entities, Color[] colors)
+		{
+			InternalCalls.SpriteRendererComponent_SetColors(entities.IDs, entities.Handles, entities.Count, colors);
 		}
 	}
 
@@ -139,26 +185,26 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.CircleRendererComponent_GetColor(Entity.ID, out Color result);
+				InternalCalls.CircleRendererComponent_GetColor(Entity.ID, Entity.Handle, out Color result);
 				return result;
 			}
-			set => InternalCalls.CircleRendererComponent_SetColor(Entity.ID, ref value);
+			set => InternalCalls.CircleRendererComponent_SetColor(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Inner thickness of the circle. 0 displays nothing and 1 displays a full circle.
 		/// </summary>
 		public float Thickness
 		{
-			get => InternalCalls.CircleRendererComponent_GetThickness(Entity.ID);
-			set => InternalCalls.CircleRendererComponent_SetThickness(Entity.ID, value);
+			get => InternalCalls.CircleRendererComponent_GetThickness(Entity.ID, Entity.Handle);
+			set => InternalCalls.CircleRendererComponent_SetThickness(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// The blur of the circle. 
 		/// </summary>
 		public float Fade
 		{
-			get => InternalCalls.CircleRendererComponent_GetFade(Entity.ID);
-			set => InternalCalls.CircleRendererComponent_SetFade(Entity.ID, value);
+			get => InternalCalls.CircleRendererComponent_GetFade(Entity.ID, Entity.Handle);
+			set => InternalCalls.CircleRendererComponent_SetFade(Entity.ID, Entity.Handle, value);
 		}
 	}
 
@@ -177,13 +223,13 @@ namespace Locus
 		{
 			get
 			{
-				int internalType = InternalCalls.Rigidbody2DComponent_GetBodyType(Entity.ID);
+				int internalType = InternalCalls.Rigidbody2DComponent_GetBodyType(Entity.ID, Entity.Handle);
 				return (RigidbodyType)internalType;
 			}
 			set
 			{
 				int bodyType = (int)value;
-				InternalCalls.Rigidbody2DComponent_SetBodyType(Entity.ID, bodyType);
+				InternalCalls.Rigidbody2DComponent_SetBodyType(Entity.ID, Entity.Handle, bodyType);
 			}
 		}
 		/// <summary>
@@ -191,40 +237,40 @@ namespace Locus
 		/// </summary>
 		public float Mass
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetMass(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetMass(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetMass(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetMass(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// Affects the speed of the entity's movement affected by gravity. 
 		/// </summary>
 		public float GravityScale
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetGravityScale(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetGravityScale(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetGravityScale(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetGravityScale(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// The rate at which the world velocity is reduced on the entity.
 		/// </summary>
 		public float LinearDamping
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetLinearDamping(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetLinearDamping(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetLinearDamping(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetLinearDamping(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// The rate at which the angular velocity is reduced on the entity.
 		/// </summary>
 		public float AngularDamping
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetAngularDamping(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetAngularDamping(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetAngularDamping(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetAngularDamping(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// Whether the entity can rotate. Constraint along the z-axis.
 		/// </summary>
 		public bool FixedRotation
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetFixedRotation(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetFixedRotation(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetFixedRotation(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetFixedRotation(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// Whether to enable continuous collision detection. 
@@ -232,8 +278,8 @@ namespace Locus
 		/// </summary>
 		public bool IsBullet
 		{
-			get => InternalCalls.Rigidbody2DComponent_GetIsBullet(Entity.ID);
-			set => InternalCalls.Rigidbody2DComponent_SetIsBullet(Entity.ID, value);
+			get => InternalCalls.Rigidbody2DComponent_GetIsBullet(Entity.ID, Entity.Handle);
+			set => InternalCalls.Rigidbody2DComponent_SetIsBullet(Entity.ID, Entity.Handle, value);
 		}
 		/// <summary>
 		/// Position of the rigidbody. 
@@ -243,10 +289,10 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.Rigidbody2DComponent_GetPosition(Entity.ID, out Vec2 result);
+				InternalCalls.Rigidbody2DComponent_GetPosition(Entity.ID, Entity.Handle, out Vec2 result);
 				return result;
 			}
-			set => InternalCalls.Rigidbody2DComponent_SetPosition(Entity.ID, ref value);
+			set => InternalCalls.Rigidbody2DComponent_SetPosition(Entity.ID, Entity.Handle, ref value);
 		}
 		/// <summary>
 		/// Velocity of the rigidbody.
@@ -255,10 +301,10 @@ namespace Locus
 		{
 			get
 			{
-				InternalCalls.Rigidbody2DComponent_GetVelocity(Entity.ID, out Vec2 result);
+				InternalCalls.Rigidbody2DComponent_GetVelocity(Entity.ID, Entity.Handle, out Vec2 result);
 				return result;
 			}
-			set => InternalCalls.Rigidbody2DComponent_SetVelocity(Entity.ID, ref value);
+			set => InternalCalls.Rigidbody2DComponent_SetVelocity(Entity.ID, Entity.Handle, ref value);
 		}
 
 		/// <summary>
@@ -266,14 +312,14 @@ namespace Locus
 		/// </summary>
 		public void AddForce(Vec2 force)
 		{
-			InternalCalls.Rigidbody2DComponent_AddForce(Entity.ID, ref force);
+			InternalCalls.Rigidbody2DComponent_AddForce(Entity.ID, Entity.Handle, ref force);
 		}
 		/// <summary>
 		/// Adds an impluse to the rigidbody. Equal to the change in momentum.
 		/// </summary>
 		public void AddLinearImpulse(Vec2 impulse)
 		{
-			InternalCalls.Rigidbody2DComponent_AddLinearImpulse(Entity.ID, ref impulse);
+			InternalCalls.Rigidbody2DComponent_AddLinearImpulse(Entity.ID, Entity.Handle, ref impulse);
 		}
 	}
 
@@ -1,5 +1,6 @@
 ﻿// --- Entity -----------------------------------------------------------------
 using System;
+using System.Runtime.ExceptionServices;
 
 namespace Locus
 {
@@ -11,23 +12,25 @@ namespace Locus
 		// --- Properties ---
 		/// <summary> The unique identifier for the entity. </summary>
 		public readonly ulong ID;
+		/// <summary> Engine side handle of the entity. Lets internal calls skip the ID lookup. </summary>
+		internal readonly uint Handle;
 		/// <summary> Name of the entity. </summary>
 		public string Tag
 		{
-			get => InternalCalls.Entity_GetTag(ID);
-			set => InternalCalls.Entity_SetTag(ID, value);
+			get => InternalCalls.Entity_GetTag(ID, Handle);
+			set => InternalCalls.Entity_SetTag(ID, Handle, value);
 		}
 		/// <summary> The group/layer of the entity. </summary>
 		public string Group
 		{
-			get => InternalCalls.Entity_GetGroup(ID);
-			set => InternalCalls.Entity_SetGroup(ID, value);
+			get => InternalCalls.Entity_GetGroup(ID, Handle);
+			set => InternalCalls.Entity_SetGroup(ID, Handle, value);
 		}
 		/// <summary> The enabled state of the entity. </summary>
 		public bool Enabled
 		{
-			get => InternalCalls.Entity_GetEnabled(ID);
-			set => InternalCalls.Entity_SetEnabled(ID, value);
+			get => InternalCalls.Entity_GetEnabled(ID, Handle);
+			set => InternalCalls.Entity_SetEnabled(ID, Handle, value);
 		}
 		/// <summary> The transform component of the entity. </summary>
 		public TransformComponent Transform
@@ -44,13 +47,23 @@ namespace Locus
 		public Entity()
 		{
 			ID = 0;
+			Handle = NullHandle;
 		}
 
 		internal Entity(ulong id)
 		{
 			ID = id;
+			Handle = id == 0 ? NullHandle : InternalCalls.Entity_GetHandle(id);
 		}
 
+		internal Entity(ulong id, uint handle)
+		{
+			ID = id;
+			Handle = handle;
+		}
+
+		private const uint NullHandle = 0xFFFFFFFF;
+
 		// --- Public Methods ---
 		/// <summary>
 		/// Returns true if entity has component T. 
@@ -58,7 +71,7 @@ namespace Locus
 		public bool HasComponent<T>() where T : Component
 		{
 			Type componentType = typeof(T);
-			return InternalCalls.Entity_HasComponent(ID, componentType);
+			return InternalCalls.Entity_HasComponent(ID, Handle, componentType);
 		}
 		/// <summary>
 		/// Gets the component T attached to the entity. Returns null if entity does not contain the component.
@@ -78,7 +91,7 @@ namespace Locus
 		{
 			T component = new T() { Entity = this };
 			Type componentType = typeof(T);
-			InternalCalls.Entity_AddComponent(ID, componentType);
+			InternalCalls.Entity_AddComponent(ID, Handle, componentType);
 			return component;
 		}
 
@@ -88,7 +101,8 @@ namespace Locus
 		/// </summary>
 		public static Entity CreateEntity(string tag = "Empty Entity")
 		{
-			Entity entity = new Entity(InternalCalls.Entity_CreateEntity());
+			ulong id = InternalCalls.Entity_CreateEntity(out uint handle);
+			Entity entity = new Entity(id, handle);
 			entity.Tag = tag;
 			return entity;
 		}
@@ -97,33 +111,74 @@ namespace Locus
 		/// </summary>
 		public static void Destroy(Entity entity)
 		{
-			InternalCalls.Entity_Destroy(entity.ID);
+			InternalCalls.Entity_Destroy(entity.ID, entity.Handle);
 		}
 		/// <summary>
 		/// Searches and returns an entity by tag. Returns null if entity is not found.
+		/// If several entities share the tag, the same one is returned every time, but not necessarily the first created.
 		/// </summary>
 		public static Entity Find(string tag)
 		{
-			Entity entity = new Entity(InternalCalls.Entity_Find(tag));
-			if (entity.ID == 0)
+			ulong id = InternalCalls.Entity_Find(tag, out uint handle);
+			if (id == 0)
 				return null;
-			return entity;
+			return new Entity(id, handle);
+		}
+
+		/// <summary>
+		/// Fills results with every entity with the tag. Returns the number of entities found.
+		/// </summary>
+		public static int FindAll(string tag, EntityQuery results)
+		{
+			while (!results.SetQueriedCount(InternalCalls.Entity_FindAll(tag, results.IDs, results.Handles))) {}
+			return results.Count;
+		}
+		/// <summary>
+		/// Fills results with every entity in the group. Returns the number of entities found.
+		/// </summary>
+		public static int GetGroup(string name, EntityQuery results)
+		{
+			while (!results.SetQueriedCount(InternalCalls.Entity_GetGroupEntities(name, results.IDs, results.Handles))) {}
+			return results.Count;
 		}
 
 		// --- Collision Callbacks ---
-		internal void OnCollisionBeginInternal(ulong id)
+		/// <summary>
+		/// Called by the engine once per frame with every collision event. The first beginCount events are begins.
+		/// otherEntities holds the script instance of the other entity, or null if it has none.
+		/// </summary>
+		internal static void DispatchCollisionsInternal(Entity[] entities, Entity[] otherEntities, ulong[] otherIDs, uint[] otherHandles, int beginCount, int count)
 		{
-			OnCollisionBegin(new Entity(id));
+			ExceptionDispatchInfo firstException = null;
+			for (int i = 0; i < count; i++)
+			{
+				// An earlier callback of this batch can destroy the entity.
+				Entity entity = entities[i];
+				if (!InternalCalls.Entity_IsValid(entity.ID, entity.Handle))
+					continue;
+
+				Entity other = otherEntities[i] ?? new Entity(otherIDs[i], otherHandles[i]);
+				try
+				{
+					if (i < beginCount)
+						entity.OnCollisionBegin(other);
+					else
+						entity.OnCollisionEnd(other);
+				}
+				catch (Exception e)
+				{
+					// Keep dispatching so one failing script doesn't drop the other events.
+					if (firstException == null)
+						firstException = ExceptionDispatchInfo.Capture(e);
+				}
+			}
+			firstException?.Throw();
 		}
 		/// <summary>
 		/// Called whenever the entity begins a collision with another entity.
 		/// </summary>
 		public virtual void OnCollisionBegin(Entity entity) {}
 
-		internal void OnCollisionEndInternal(ulong id)
-		{
-			OnCollisionEnd(new Entity(id));
-		}
 		/// <summary>
 		/// Called whenever the entity ends a collision with another entity.
 		/// </summary>
@@ -0,0 +1,99 @@
+﻿// --- EntityQuery ------------------------------------------------------------
+// A list of entities stored as parallel ID and handle arrays so it can be
+//  passed to batched internal calls in one transition.
+using System;
+
+namespace Locus
+{
+	/// <summary>
+	/// A reusable list of entities. Fill it with Refresh() or Add() and pass it to the
+	/// batched component methods, eg. TransformComponent.SetPositions().
+	/// </summary>
+	public class EntityQuery
+	{
+		internal ulong[] IDs;
+		internal uint[] Handles;
+
+		private readonly Type m_ComponentType;
+
+		/// <summary> Number of entities in the query. </summary>
+		public int Count { get; private set; }
+
+		/// <summary> Returns the entity at index. </summary>
+		public Entity this[int index] => new Entity(IDs[index], Handles[index]);
+
+		/// <summary>
+		/// Creates an empty query. Refresh() does nothing on a query without a component type.
+		/// </summary>
+		public EntityQuery(int capacity = 64)
+		{
+			IDs = new ulong[Math.Max(capacity, 1)];
+			Handles = new uint[Math.Max(capacity, 1)];
+		}
+
+		internal EntityQuery(Type componentType, int capacity) : this(capacity)
+		{
+			m_ComponentType = componentType;
+		}
+
+		/// <summary>
+		/// Creates a query over every enabled entity with component T.
+		/// </summary>
+		public static EntityQuery Create<T>(int capacity = 64) where T : Component
+		{
+			EntityQuery query = new EntityQuery(typeof(T), capacity);
+			query.Refresh();
+			return query;
+		}
+
+		/// <summary>
+		/// Refills the query with the current matching entities. Arrays only grow, so calling this every frame does not allocate once the scene settles.
+		/// </summary>
+		public void Refresh()
+		{
+			if (m_ComponentType == null)
+				return;
+
+			while (!SetQueriedCount(InternalCalls.Scene_QueryEntities(m_ComponentType, IDs, Handles))) {}
+		}
+
+		/// <summary> Adds an entity to the query. </summary>
+		public void Add(Entity entity)
+		{
+			if (Count == IDs.Length)
+				Reserve(Count * 2);
+			IDs[Count] = entity.ID;
+			Handles[Count] = entity.Handle;
+			Count++;
+		}
+
+		/// <summary> Removes all entities from the query. </summary>
+		public void Clear()
+		{
+			Count = 0;
+		}
+
+		/// <summary>
+		/// Takes the total returned by an internal call that filled IDs and Handles. Returns false after growing
+		/// the arrays if they were too small, in which case the call has to be made again.
+		/// </summary>
+		internal bool SetQueriedCount(int count)
+		{
+			if (count > IDs.Length)
+			{
+				Reserve(count);
+				return false;
+			}
+			Count = count;
+			return true;
+		}
+
+		private void Reserve(int capacity)
+		{
+			if (capacity <= IDs.Length)
+				return;
+			Array.Resize(ref IDs, capacity);
+			Array.Resize(ref Handles, capacity);
+		}
+	}
+}
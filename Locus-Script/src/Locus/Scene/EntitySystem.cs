@@ -0,0 +1,21 @@
+﻿// --- EntitySystem -----------------------------------------------------------
+namespace Locus
+{
+	/// <summary>
+	/// Base class for system scripts. One instance of every system is created when the scene starts.
+	/// Unlike an Entity script, OnUpdate() is called once per frame instead of once per entity,
+	/// so a system can process many entities with an EntityQuery and the batched component methods.
+	/// </summary>
+	public abstract class EntitySystem
+	{
+		/// <summary>
+		/// Called once after every entity script has been created.
+		/// </summary>
+		public virtual void OnCreate() {}
+
+		/// <summary>
+		/// Called once per frame after the entity scripts have been updated.
+		/// </summary>
+		public virtual void OnUpdate(float deltaTime) {}
+	}
+}
@@ -46,6 +46,7 @@
 
 // --- Scripting ---
 #include "Locus/Scripting/ScriptEngine.h"
+#include "Locus/Scripting/ScriptProfiler.h"
 
 // --- Resource ---
 #include "Locus/Resource/ResourceManager.h"
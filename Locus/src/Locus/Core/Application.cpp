@@ -2,8 +2,10 @@
 #include "Application.h"
 
 #include "Locus/Renderer/Renderer.h"
+#include "Locus/Renderer/RenderThread.h"
 #include "Locus/Scripting/ScriptEngine.h"
 #include "Locus/Resource/ResourceManager.h"
+#include "Locus/Physics2D/CollisionLayers2D.h"
 
 namespace Locus
 {
@@ -30,6 +32,7 @@ namespace Locus
 		Renderer::Init();
 		ScriptEngine::Init();
 		ResourceManager::Init();
+		CollisionLayers2D::Init();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -67,6 +70,9 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
+		if (m_RenderThreadEnabled)
+			RenderThread::Start(&m_Window->GetContext());
+
 		while (m_Running)
 		{
 			// Calculate deltaTime
@@ -94,6 +100,9 @@ namespace Locus
 			// Call window OnUpdate() after all layers
 			m_Window->OnUpdate();
 
+			// Hand this frame to the render thread. Only waits if the previous frame is still executing.
+			RenderThread::KickFrame();
+
 			// Calculate FPS
 			static int frames = 0;
 			static float timer = 1.0f;
@@ -106,6 +115,8 @@ namespace Locus
 				frames = 0;
 			}
 		}
+
+		RenderThread::Stop();
 	}
 
 	void Application::Close()
@@ -43,6 +43,10 @@ namespace Locus
 		inline uint32_t GetFPS() const { return m_FPS; }
 
 		inline bool IsRunning() const { return m_Running; }
+
+		// Records rendering on the main thread and replays it on a dedicated render thread. Set before Run().
+		inline void SetRenderThreadEnabled(bool enabled) { m_RenderThreadEnabled = enabled; }
+		inline bool IsRenderThreadEnabled() const { return m_RenderThreadEnabled; }
 	private:
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
@@ -57,6 +61,7 @@ namespace Locus
 		ImGuiLayer* m_ImGuiLayer;
 		bool m_Running = true;
 		bool m_Minimized = false;
+		bool m_RenderThreadEnabled = false;
 		LayerStack m_LayerStack;
 
 		float m_LastFrameTime = 0.0f;
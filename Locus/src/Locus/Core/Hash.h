@@ -0,0 +1,27 @@
+// --- Hash -------------------------------------------------------------------
+// 64-bit FNV-1a. Used for cache keys and change detection, not for security.
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Locus
+{
+	namespace Utils
+	{
+		inline constexpr uint64_t s_HashSeed = 14695981039346656037ull;
+
+		// Pass the result of a previous call as seed to combine several values into one hash.
+		inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = s_HashSeed)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			uint64_t hash = seed;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+}
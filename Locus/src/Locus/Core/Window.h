@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "Locus/Events/Event.h"
+#include "Locus/Renderer/GraphicsContext.h"
 
 namespace Locus
 {
@@ -38,6 +39,7 @@ namespace Locus
 		virtual bool IsVSync() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext& GetContext() = 0;
 
 		static Scope<Window> Create(const WindowProps& props = WindowProps());
 	};
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <fstream>
 #include <thread>
+#include <mutex>
 
 namespace Locus
 {
@@ -49,6 +50,9 @@ namespace Locus
 
 		void WriteProfile(const ProfileResult& result)
 		{
+			// Profiles are written from worker threads as well.
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
 			if (m_ProfileCount++ > 0)
 				m_OutputStream << ",";
 
@@ -71,6 +75,29 @@ namespace Locus
 				EndSession();
 		}
 
+		// Counter events show up as a graph track in the trace viewer.
+		void WriteCounter(const std::string& name, long long timestamp, double value)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (m_ProfileCount++ > 0)
+				m_OutputStream << ",";
+
+			std::string counterName = name;
+			std::replace(counterName.begin(), counterName.end(), '"', '\'');
+
+			m_OutputStream << "{";
+			m_OutputStream << "\"cat\":\"counter\",";
+			m_OutputStream << "\"name\":\"" << counterName << "\",";
+			m_OutputStream << "\"ph\":\"C\",";
+			m_OutputStream << "\"pid\":0,";
+			m_OutputStream << "\"ts\":" << timestamp << ",";
+			m_OutputStream << "\"args\":{\"value\":" << value << "}";
+			m_OutputStream << "}";
+
+			m_OutputStream.flush();
+		}
+
 		void WriteHeader()
 		{
 			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";
@@ -94,6 +121,7 @@ namespace Locus
 		std::ofstream m_OutputStream;
 		int m_ProfileCount;
 		int m_Frames = 0;
+		std::mutex m_Mutex;
 	};
 
 
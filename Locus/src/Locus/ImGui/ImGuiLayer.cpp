@@ -5,9 +5,11 @@
 #include <backends/imgui_impl_opengl3.h>
 #include <backends/imgui_impl_glfw.h>
 #include <ImGuizmo.h>
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include "Locus/Core/Application.h"
+#include "Locus/Renderer/RenderThread.h"
 
 namespace Locus
 {
@@ -35,6 +37,45 @@ namespace Locus
 		return { value.x, value.y, value.z, value.w };
 	}
 
+	// Copy of a viewport's draw data that the render thread can read while the main thread builds the next frame.
+	struct ImGuiDrawDataSnapshot
+	{
+		ImDrawData DrawData;
+		std::vector<ImDrawList*> CmdLists;
+		GLFWwindow* Window = nullptr;
+		bool Clear = false;
+
+		ImGuiDrawDataSnapshot(ImDrawData* drawData)
+			: DrawData(*drawData)
+		{
+			for (int i = 0; i < drawData->CmdListsCount; i++)
+				CmdLists.push_back(drawData->CmdLists[i]->CloneOutput());
+
+		#if IMGUI_VERSION_NUM >= 18980
+			for (int i = 0; i < (int)CmdLists.size(); i++)
+				DrawData.CmdLists[i] = CmdLists[i];
+		#else
+			DrawData.CmdLists = CmdLists.data();
+		#endif
+		}
+
+		~ImGuiDrawDataSnapshot()
+		{
+			for (auto cmdList : CmdLists)
+				IM_DELETE(cmdList);
+		}
+	};
+
+	// Destroy callback of the GLFW backend. Wrapped so only destroying a platform window waits for the render thread.
+	static void (*s_PlatformDestroyWindow)(ImGuiViewport*) = nullptr;
+
+	static void DestroyPlatformWindow(ImGuiViewport* viewport)
+	{
+		// The previous frame may still render into the window.
+		RenderThread::WaitForFrame();
+		s_PlatformDestroyWindow(viewport);
+	}
+
 	ImGuiLayer::ImGuiLayer() : Layer("ImGuiLayer")
 	{
 
@@ -85,6 +126,11 @@ namespace Locus
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 410");
+		ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+		s_PlatformDestroyWindow = platformIO.Platform_DestroyWindow;
+		platformIO.Platform_DestroyWindow = DestroyPlatformWindow;
+		// Create the font texture now instead of lazily in NewFrame(), which may run on the render thread.
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
 	}
 
 	void ImGuiLayer::OnDetach()
@@ -110,7 +156,10 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_NewFrame();
+		RenderThread::Submit([]()
+			{
+				ImGui_ImplOpenGL3_NewFrame();
+			});
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
@@ -126,6 +175,11 @@ namespace Locus
 
 		// Rendering
 		ImGui::Render();
+		if (RenderThread::IsRunning())
+		{
+			RenderThreaded();
+			return;
+		}
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -137,6 +191,58 @@ namespace Locus
 		}
 	}
 
+	void ImGuiLayer::RenderThreaded()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		ImGuiIO& io = ImGui::GetIO();
+
+		Ref<ImGuiDrawDataSnapshot> mainSnapshot = CreateRef<ImGuiDrawDataSnapshot>(ImGui::GetDrawData());
+		RenderThread::Submit([mainSnapshot]()
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(&mainSnapshot->DrawData);
+			});
+
+		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+		{
+			// Platform windows are created on this thread. Creating one makes its context current here,
+			// so release it for the render thread. Destroying one waits for the previous frame, see DestroyPlatformWindow().
+			ImGui::UpdatePlatformWindows();
+			glfwMakeContextCurrent(nullptr);
+
+			std::vector<Ref<ImGuiDrawDataSnapshot>> snapshots;
+			ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+			for (int i = 1; i < platformIO.Viewports.Size; i++)
+			{
+				ImGuiViewport* viewport = platformIO.Viewports[i];
+				if ((viewport->Flags & ImGuiViewportFlags_IsMinimized) || !viewport->DrawData)
+					continue;
+
+				Ref<ImGuiDrawDataSnapshot> snapshot = CreateRef<ImGuiDrawDataSnapshot>(viewport->DrawData);
+				snapshot->Window = (GLFWwindow*)viewport->PlatformHandle;
+				snapshot->Clear = !(viewport->Flags & ImGuiViewportFlags_NoRendererClear);
+				snapshots.push_back(snapshot);
+			}
+
+			GLFWwindow* mainWindow = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+			RenderThread::Submit([snapshots, mainWindow]()
+				{
+					for (auto& snapshot : snapshots)
+					{
+						glfwMakeContextCurrent(snapshot->Window);
+						if (snapshot->Clear)
+						{
+							glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+							glClear(GL_COLOR_BUFFER_BIT);
+						}
+						ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData);
+						glfwSwapBuffers(snapshot->Window);
+					}
+					glfwMakeContextCurrent(mainWindow);
+				});
+		}
+	}
+
 	void ImGuiLayer::SetDarkTheme()
 	{
 		auto& colors = ImGui::GetStyle().Colors;
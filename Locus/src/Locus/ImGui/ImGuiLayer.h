@@ -54,6 +54,10 @@ namespace Locus
 
 		void SetDarkTheme();
 
+	private:
+		// Snapshots draw data of every viewport and submits it to the render thread.
+		void RenderThreaded();
+
 	private:
 		bool m_BlockEvents = false;
 	};
@@ -0,0 +1,21 @@
+#include "Lpch.h"
+#include "CollisionFilter2D.h"
+
+namespace Locus
+{
+	bool CollisionFilter2D::ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB)
+	{
+		const b2Filter& filterA = fixtureA->GetFilterData();
+		const b2Filter& filterB = fixtureB->GetFilterData();
+
+		uint32_t layerA = CollisionLayers2D::GetLayerIndex(filterA.categoryBits);
+		uint32_t layerB = CollisionLayers2D::GetLayerIndex(filterB.categoryBits);
+		if (layerA < CollisionLayers2D::MaxLayers && layerB < CollisionLayers2D::MaxLayers)
+			m_PairStats.Counts[std::min(layerA, layerB)][std::max(layerA, layerB)]++;
+
+		if (filterA.groupIndex == filterB.groupIndex && filterA.groupIndex != 0)
+			return filterA.groupIndex > 0;
+
+		return (filterA.maskBits & filterB.categoryBits) != 0 && (filterA.categoryBits & filterB.maskBits) != 0;
+	}
+}
@@ -0,0 +1,25 @@
+// --- CollisionFilter2D ------------------------------------------------------
+// Contact filter for the Box2D world. Applies the default group and
+//	category/mask rules and counts the candidate pairs the broadphase
+//	produces per layer combination, so expensive layer pairs show up in the
+//	debug stats.
+#pragma once
+
+#include <box2d/box2d.h>
+
+#include "Locus/Physics2D/CollisionLayers2D.h"
+
+namespace Locus
+{
+	class CollisionFilter2D : public b2ContactFilter
+	{
+	public:
+		virtual bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB) override;
+
+		void ResetPairCounts() { m_PairStats = {}; }
+		const CollisionPairStats2D& GetPairStats() const { return m_PairStats; }
+
+	private:
+		CollisionPairStats2D m_PairStats;
+	};
+}
@@ -0,0 +1,138 @@
+#include "Lpch.h"
+#include "CollisionLayers2D.h"
+
+#define YAML_CPP_STATIC_DEFINE
+#include <yaml-cpp/yaml.h>
+
+#include "Locus/Core/Application.h"
+
+namespace Locus
+{
+	struct CollisionLayersData
+	{
+		std::string Names[CollisionLayers2D::MaxLayers];
+		uint16_t Masks[CollisionLayers2D::MaxLayers];
+	};
+
+	static CollisionLayersData s_CLData;
+
+	namespace Utils
+	{
+		static std::filesystem::path GetProjectSettingsPath()
+		{
+			return Application::Get().GetProjectPath() / "ProjectSettings.yaml";
+		}
+	}
+
+	void CollisionLayers2D::Init()
+	{
+		for (uint32_t i = 0; i < MaxLayers; i++)
+		{
+			s_CLData.Names[i] = i == 0 ? "Default" : "Layer " + std::to_string(i);
+			s_CLData.Masks[i] = 0xFFFF;
+		}
+
+		std::filesystem::path path = Utils::GetProjectSettingsPath();
+		if (!std::filesystem::exists(path))
+			return;
+
+		YAML::Node data = YAML::LoadFile(path.string());
+		auto layers = data["CollisionLayers"];
+		if (!layers)
+			return;
+
+		for (auto layer : layers)
+		{
+			uint32_t index = layer["Index"].as<uint32_t>();
+			if (index >= MaxLayers)
+				continue;
+			s_CLData.Names[index] = layer["Name"].as<std::string>();
+			s_CLData.Masks[index] = layer["Mask"].as<uint16_t>();
+		}
+		LOCUS_CORE_TRACE("Loaded collision layers from {0}", path.string());
+	}
+
+	void CollisionLayers2D::Save()
+	{
+		// Keep other project settings.
+		std::filesystem::path path = Utils::GetProjectSettingsPath();
+		YAML::Node data = std::filesystem::exists(path) ? YAML::LoadFile(path.string()) : YAML::Node();
+
+		YAML::Node layers;
+		for (uint32_t i = 0; i < MaxLayers; i++)
+		{
+			YAML::Node layer;
+			layer["Index"] = i;
+			layer["Name"] = s_CLData.Names[i];
+			layer["Mask"] = s_CLData.Masks[i];
+			layers.push_back(layer);
+		}
+		data["CollisionLayers"] = layers;
+
+		YAML::Emitter out;
+		out << data;
+		std::ofstream fout(path);
+		fout << out.c_str();
+	}
+
+	const std::string& CollisionLayers2D::GetLayerName(uint32_t layer)
+	{
+		LOCUS_CORE_ASSERT(layer < MaxLayers, "Invalid collision layer!");
+		return s_CLData.Names[layer];
+	}
+
+	void CollisionLayers2D::SetLayerName(uint32_t layer, const std::string& name)
+	{
+		LOCUS_CORE_ASSERT(layer < MaxLayers, "Invalid collision layer!");
+		s_CLData.Names[layer] = name;
+	}
+
+	bool CollisionLayers2D::GetCollides(uint32_t layerA, uint32_t layerB)
+	{
+		LOCUS_CORE_ASSERT(layerA < MaxLayers && layerB < MaxLayers, "Invalid collision layer!");
+		return s_CLData.Masks[layerA] & (1 << layerB);
+	}
+
+	void CollisionLayers2D::SetCollides(uint32_t layerA, uint32_t layerB, bool collides)
+	{
+		LOCUS_CORE_ASSERT(layerA < MaxLayers && layerB < MaxLayers, "Invalid collision layer!");
+		if (collides)
+		{
+			s_CLData.Masks[layerA] |= (1 << layerB);
+			s_CLData.Masks[layerB] |= (1 << layerA);
+		}
+		else
+		{
+			s_CLData.Masks[layerA] &= ~(1 << layerB);
+			s_CLData.Masks[layerB] &= ~(1 << layerA);
+		}
+	}
+
+	uint16_t CollisionLayers2D::GetLayerMask(uint32_t layer)
+	{
+		LOCUS_CORE_ASSERT(layer < MaxLayers, "Invalid collision layer!");
+		return s_CLData.Masks[layer];
+	}
+
+	uint16_t CollisionLayers2D::GetEffectiveMask(uint16_t categoryBits, uint16_t maskBits)
+	{
+		// A collider in several layers collides with anything one of them collides with.
+		uint16_t layerMask = 0;
+		for (uint32_t i = 0; i < MaxLayers; i++)
+		{
+			if (categoryBits & (1 << i))
+				layerMask |= s_CLData.Masks[i];
+		}
+		return maskBits & layerMask;
+	}
+
+	uint32_t CollisionLayers2D::GetLayerIndex(uint16_t categoryBits)
+	{
+		for (uint32_t i = 0; i < MaxLayers; i++)
+		{
+			if (categoryBits & (1 << i))
+				return i;
+		}
+		return 0;
+	}
+}
@@ -0,0 +1,39 @@
+// --- CollisionLayers2D ------------------------------------------------------
+// Project wide collision layer matrix. Layer i is collision category bit i of
+//	the 2D colliders. The matrix decides which layers can collide and is
+//	combined with each collider's own mask when physics data is created.
+//	Saved to ProjectSettings.yaml in the project directory.
+#pragma once
+
+namespace Locus
+{
+	// Candidate pairs the broadphase produced, indexed by [lower layer][higher layer].
+	struct CollisionPairStats2D
+	{
+		uint32_t Counts[16][16] = {};
+	};
+
+	class CollisionLayers2D
+	{
+	public:
+		static const uint32_t MaxLayers = 16;
+
+		// Loads the matrix from the project settings. Every layer collides with every layer if there are none.
+		static void Init();
+		static void Save();
+
+		static const std::string& GetLayerName(uint32_t layer);
+		static void SetLayerName(uint32_t layer, const std::string& name);
+
+		static bool GetCollides(uint32_t layerA, uint32_t layerB);
+		// The matrix is symmetric, so this sets both entries.
+		static void SetCollides(uint32_t layerA, uint32_t layerB, bool collides);
+
+		// Bits of the layers a layer collides with.
+		static uint16_t GetLayerMask(uint32_t layer);
+		// The collider's mask limited to layers the matrix lets its categories collide with.
+		static uint16_t GetEffectiveMask(uint16_t categoryBits, uint16_t maskBits);
+		// Index of the lowest category bit. Used to attribute a fixture to a single layer.
+		static uint32_t GetLayerIndex(uint16_t categoryBits);
+	};
+}
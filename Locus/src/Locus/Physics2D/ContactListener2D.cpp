@@ -9,81 +9,78 @@
 
 namespace Locus
 {
-	void ContactListener2D::BeginContact(b2Contact* contact)
+	namespace Utils
 	{
-		Ref<Scene> scene = ScriptEngine::GetScene();
-		UUID aUUID = (UUID)contact->GetFixtureA()->GetBody()->GetUserData().pointer;
-		UUID bUUID = (UUID)contact->GetFixtureB()->GetBody()->GetUserData().pointer;
-		Entity aEntity = scene->GetEntityByUUID(aUUID);
-		Entity bEntity = scene->GetEntityByUUID(bUUID);
-
-		// Push pair of collided entities to stack if entity has a script component.
-		if (aEntity.IsValid()) // Checks for valid as entities can be destroyed on contact.
+		static ContactListener2D::ContactPair GetContactPair(b2Contact* contact)
 		{
-			if (aEntity.HasComponent<ScriptComponent>())
-				m_BeginContacts.push(std::make_pair(aUUID, bUUID));
+			b2Fixture* a = contact->GetFixtureA();
+			b2Fixture* b = contact->GetFixtureB();
+			return { (entt::entity)a->GetUserData().pointer, (entt::entity)b->GetUserData().pointer,
+				(UUID)a->GetBody()->GetUserData().pointer, (UUID)b->GetBody()->GetUserData().pointer };
 		}
+	}
 
-		if (bEntity.IsValid())
-		{
-			if (bEntity.HasComponent<ScriptComponent>())
-				m_BeginContacts.push(std::make_pair(bUUID, aUUID));
-		}
+	ContactListener2D::ContactListener2D(Scene* scene)
+		: m_Scene(scene)
+	{
+		// Sized for busy scenes so recording doesn't allocate during a step.
+		m_BeginContacts.reserve(1024);
+		m_EndContacts.reserve(1024);
+		m_EventEntities.reserve(2048);
+		m_EventOthers.reserve(2048);
+		m_EventOtherIDs.reserve(2048);
 	}
 
-	void ContactListener2D::EndContact(b2Contact* contact)
+	void ContactListener2D::BeginContact(b2Contact* contact)
 	{
-		Ref<Scene> scene = ScriptEngine::GetScene();
-		UUID aUUID = (UUID)contact->GetFixtureA()->GetBody()->GetUserData().pointer;
-		UUID bUUID = (UUID)contact->GetFixtureB()->GetBody()->GetUserData().pointer;
-		Entity aEntity = scene->GetEntityByUUID(aUUID);
-		Entity bEntity = scene->GetEntityByUUID(bUUID);
+		// Only record the pair. This can run on the physics thread, so entities are resolved in Execute().
+		m_BeginContacts.push_back(Utils::GetContactPair(contact));
+	}
 
-		// Push pair of collided entities to stack if entity has a script component.
-		// TODO: Also check if OnCollisionEnd() is defined.
-		if (aEntity.IsValid())
-		{
-			if (aEntity.HasComponent<ScriptComponent>())
-				m_EndContacts.push(std::make_pair(aUUID, bUUID));
-		}
-		
-		if (bEntity.IsValid())
-		{
-			if (bEntity.HasComponent<ScriptComponent>())
-				m_EndContacts.push(std::make_pair(bUUID, aUUID));
-		}
+	void ContactListener2D::EndContact(b2Contact* contact)
+	{
+		m_EndContacts.push_back(Utils::GetContactPair(contact));
 	}
 
 	void ContactListener2D::Execute()
 	{
-		while (!m_BeginContacts.empty())
+		if (m_BeginContacts.empty() && m_EndContacts.empty())
+			return;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		m_EventEntities.clear();
+		m_EventOthers.clear();
+		m_EventOtherIDs.clear();
+		GatherEvents(m_BeginContacts);
+		uint32_t beginCount = (uint32_t)m_EventEntities.size();
+		GatherEvents(m_EndContacts);
+		m_BeginContacts.clear();
+		m_EndContacts.clear();
+
+		ScriptEngine::DispatchCollisions(m_EventEntities.data(), m_EventOthers.data(), m_EventOtherIDs.data(), beginCount, (uint32_t)m_EventEntities.size());
+	}
+
+	void ContactListener2D::GatherEvents(const std::vector<ContactPair>& pairs)
+	{
+		for (const ContactPair& pair : pairs)
 		{
-			UUID aUUID = m_BeginContacts.front().first;
-			UUID bUUID = m_BeginContacts.front().second;
-			Entity aEntity = ScriptEngine::GetScene()->GetEntityByUUID(aUUID);
-			Ref<ScriptInstance> instance = ScriptEngine::GetScriptInstance(aUUID);
-			if (instance)
+			// Checks for valid as entities can be destroyed on contact.
+			Entity a = Entity(pair.A, m_Scene);
+			if (a.IsValid() && a.HasComponent<ScriptComponent>())
 			{
-				MonoMethod* method = ScriptEngine::GetEntityBaseClass()->GetMethod("OnCollisionBeginInternal", 1);
-				void* data = &bUUID;
-				ScriptEngine::InvokeMethod(instance, method, &data);
+				m_EventEntities.push_back(pair.A);
+				m_EventOthers.push_back(pair.B);
+				m_EventOtherIDs.push_back(pair.BID);
 			}
-			m_BeginContacts.pop();
-		}
 
-		while (!m_EndContacts.empty())
-		{
-			UUID aUUID = m_EndContacts.front().first;
-			UUID bUUID = m_EndContacts.front().second;
-			Entity aEntity = ScriptEngine::GetScene()->GetEntityByUUID(aUUID);
-			Ref<ScriptInstance> instance = ScriptEngine::GetScriptInstance(aUUID);
-			if (instance)
+			Entity b = Entity(pair.B, m_Scene);
+			if (b.IsValid() && b.HasComponent<ScriptComponent>())
 			{
-				MonoMethod* method = ScriptEngine::GetEntityBaseClass()->GetMethod("OnCollisionEndInternal", 1);
-				void* data = &bUUID;
-				ScriptEngine::InvokeMethod(instance, method, &data);
+				m_EventEntities.push_back(pair.B);
+				m_EventOthers.push_back(pair.A);
+				m_EventOtherIDs.push_back(pair.AID);
 			}
-			m_EndContacts.pop();
 		}
 	}
 }
@@ -1,7 +1,7 @@
 // --- ContactListener2D ------------------------------------------------------
 // The ContactListener2D class listens for any collisions between any two
-//	entities within the active scene. Calls the callback functions
-//	BeginContact() and EndContact() depending on the state of collision.
+//	entities within the active scene. Contacts are recorded into flat arrays
+//	during the step and sent to C# in one batched call per frame by Execute().
 #pragma once
 
 #include <box2d/box2d.h>
@@ -10,22 +10,47 @@
 
 namespace Locus
 {
+	class Scene;
+
 	class ContactListener2D : public b2ContactListener
 	{
 	public:
-		ContactListener2D() = default;
+		struct ContactPair
+		{
+			entt::entity A, B;
+			UUID AID, BID;
+		};
+
+	public:
+		ContactListener2D(Scene* scene);
 		virtual ~ContactListener2D() = default;
 
-		// Add collision pairs to stack for later execution.
+		// Add collision pairs to the arrays for later execution.
 		// Functions should not be called within Contact callbacks since
-		//	the callbacks are within the world->Step() function.
+		//	the callbacks are within the world->Step() function, which may
+		//	run on the physics thread.
 		virtual void BeginContact(b2Contact* contact) override;
 		virtual void EndContact(b2Contact* contact) override;
 
 		// Execute collision functions.
 		void Execute();
+
 	private:
-		std::queue<std::pair<UUID, UUID>> m_BeginContacts;
-		std::queue<std::pair<UUID, UUID>> m_EndContacts;
+		// Adds both directions of every pair whose entity has a script to the dispatch arrays.
+		void GatherEvents(const std::vector<ContactPair>& pairs);
+
+	private:
+		Scene* m_Scene = nullptr;
+
+		// Filled during the step. Fixture user data holds the entt handle and body user data the UUID, so
+		//	no lookups happen here.
+		std::vector<ContactPair> m_BeginContacts;
+		std::vector<ContactPair> m_EndContacts;
+
+		// Flattened events sent to C#. Begin events come first. Entities are entt handles so dispatch reads the
+		//	script instance straight from their ScriptComponent.
+		std::vector<entt::entity> m_EventEntities;
+		std::vector<entt::entity> m_EventOthers;
+		std::vector<UUID> m_EventOtherIDs;
 	};
 }
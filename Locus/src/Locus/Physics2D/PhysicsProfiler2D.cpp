@@ -0,0 +1,141 @@
+#include "Lpch.h"
+#include "PhysicsProfiler2D.h"
+
+#include <box2d/box2d.h>
+
+namespace Locus
+{
+	namespace Utils
+	{
+#if LOCUS_PROFILE
+		// b2Profile only has durations, so the phases are laid out in the order b2World::Step runs them.
+		static void WriteStepTrace(const b2Profile& profile, long long start)
+		{
+			uint32_t threadID = (uint32_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
+			long long collideEnd = start + (long long)(profile.collide * 1000.0f);
+			long long solveEnd = collideEnd + (long long)(profile.solve * 1000.0f);
+
+			Instrumentor::Get().WriteProfile({ "b2World::Step", start, start + (long long)(profile.step * 1000.0f), threadID });
+			Instrumentor::Get().WriteProfile({ "Box2D Collide", start, collideEnd, threadID });
+			Instrumentor::Get().WriteProfile({ "Box2D Solve", collideEnd, solveEnd, threadID });
+			Instrumentor::Get().WriteProfile({ "Box2D Broadphase", solveEnd - (long long)(profile.broadphase * 1000.0f), solveEnd, threadID });
+			Instrumentor::Get().WriteProfile({ "Box2D SolveTOI", solveEnd, solveEnd + (long long)(profile.solveTOI * 1000.0f), threadID });
+		}
+#endif
+	}
+
+	void PhysicsProfiler2D::Reset()
+	{
+		m_Stats.Step = 0.0f;
+		m_Stats.Collide = 0.0f;
+		m_Stats.Solve = 0.0f;
+		m_Stats.SolveInit = 0.0f;
+		m_Stats.SolveVelocity = 0.0f;
+		m_Stats.SolvePosition = 0.0f;
+		m_Stats.Broadphase = 0.0f;
+		m_Stats.SolveTOI = 0.0f;
+		m_Stats.Steps = 0;
+	}
+
+	void PhysicsProfiler2D::Step(b2World* world, float timestep, int velocityIterations, int positionIterations)
+	{
+#if LOCUS_PROFILE
+		long long start = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()).time_since_epoch().count();
+#endif
+		world->Step(timestep, velocityIterations, positionIterations);
+
+		const b2Profile& profile = world->GetProfile();
+		m_Stats.Step += profile.step;
+		m_Stats.Collide += profile.collide;
+		m_Stats.Solve += profile.solve;
+		m_Stats.SolveInit += profile.solveInit;
+		m_Stats.SolveVelocity += profile.solveVelocity;
+		m_Stats.SolvePosition += profile.solvePosition;
+		m_Stats.Broadphase += profile.broadphase;
+		m_Stats.SolveTOI += profile.solveTOI;
+		m_Stats.Steps++;
+#if LOCUS_PROFILE
+		Utils::WriteStepTrace(profile, start);
+#endif
+	}
+
+	void PhysicsProfiler2D::CaptureWorld(b2World* world)
+	{
+		if (!m_CaptureEnabled)
+			return;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		m_Stats.BodyCount = world->GetBodyCount();
+		m_Stats.ContactCount = world->GetContactCount();
+		m_Stats.ProxyCount = world->GetProxyCount();
+		m_Stats.AwakeBodyCount = 0;
+		m_Stats.TouchingContactCount = 0;
+		m_Stats.IslandCount = 0;
+		m_Stats.LargestIsland = 0;
+
+		for (b2Contact* contact = world->GetContactList(); contact; contact = contact->GetNext())
+		{
+			if (contact->IsTouching())
+				m_Stats.TouchingContactCount++;
+		}
+
+		// Box2D keeps its own island flag private, so bodies get a flag by their index in a sorted array.
+		m_Bodies.clear();
+		for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+		{
+			if (body->GetType() != b2_staticBody)
+				m_Bodies.push_back(body);
+		}
+		std::sort(m_Bodies.begin(), m_Bodies.end());
+		m_Visited.assign(m_Bodies.size(), 0);
+
+		// Same graph b2World::Solve builds: awake bodies joined by touching, non sensor contacts.
+		//	Static bodies end an island instead of joining two together.
+		for (uint32_t seed = 0; seed < (uint32_t)m_Bodies.size(); seed++)
+		{
+			b2Body* seedBody = m_Bodies[seed];
+			if (!seedBody->IsEnabled() || !seedBody->IsAwake())
+				continue;
+			m_Stats.AwakeBodyCount++;
+			if (m_Visited[seed])
+				continue;
+			m_Visited[seed] = 1;
+
+			uint32_t islandSize = 0;
+			m_IslandStack.clear();
+			m_IslandStack.push_back(seed);
+			while (!m_IslandStack.empty())
+			{
+				b2Body* body = m_Bodies[m_IslandStack.back()];
+				m_IslandStack.pop_back();
+				islandSize++;
+
+				for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next)
+				{
+					b2Contact* contact = edge->contact;
+					if (!contact->IsEnabled() || !contact->IsTouching())
+						continue;
+					if (contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor())
+						continue;
+					b2Body* other = edge->other;
+					if (other->GetType() == b2_staticBody)
+						continue;
+					uint32_t otherIndex = GetBodyIndex(other);
+					if (m_Visited[otherIndex])
+						continue;
+					m_Visited[otherIndex] = 1;
+					m_IslandStack.push_back(otherIndex);
+				}
+			}
+
+			m_Stats.IslandCount++;
+			m_Stats.LargestIsland = std::max(m_Stats.LargestIsland, islandSize);
+		}
+	}
+
+	uint32_t PhysicsProfiler2D::GetBodyIndex(b2Body* body) const
+	{
+		return (uint32_t)(std::lower_bound(m_Bodies.begin(), m_Bodies.end(), body) - m_Bodies.begin());
+	}
+}
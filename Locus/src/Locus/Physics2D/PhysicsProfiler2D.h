@@ -0,0 +1,67 @@
+// --- PhysicsProfiler2D ------------------------------------------------------
+// Records Box2D's per step profile (collide, solve, broadphase times) along
+//	with body, contact and island counts so the debug panel can tell whether
+//	a slow frame is solver or broadphase bound. Each step is also written to
+//	the instrumentation trace as nested Box2D phases.
+#pragma once
+
+#include <atomic>
+
+class b2World;
+class b2Body;
+
+namespace Locus
+{
+	struct PhysicsStats2D
+	{
+		// Milliseconds summed over the fixed steps of a frame.
+		float Step = 0.0f;
+		float Collide = 0.0f;
+		float Solve = 0.0f;
+		float SolveInit = 0.0f;
+		float SolveVelocity = 0.0f;
+		float SolvePosition = 0.0f;
+		float Broadphase = 0.0f;
+		float SolveTOI = 0.0f;
+		uint32_t Steps = 0;
+
+		// World state after the last step.
+		uint32_t BodyCount = 0;
+		uint32_t AwakeBodyCount = 0;
+		uint32_t ContactCount = 0;
+		uint32_t TouchingContactCount = 0;
+		uint32_t ProxyCount = 0;
+		uint32_t IslandCount = 0;
+		uint32_t LargestIsland = 0;
+	};
+
+	class PhysicsProfiler2D
+	{
+	public:
+		// Clears the times of the previous frame.
+		void Reset();
+		// Steps the world once and adds its profile.
+		void Step(b2World* world, float timestep, int velocityIterations, int positionIterations);
+		// Counts bodies, contacts and islands. Call once after the last step of a frame. Does nothing unless
+		//	enabled, since it walks every body and contact.
+		void CaptureWorld(b2World* world);
+
+		// Set by whoever displays the world stats. May be called while the physics thread steps.
+		void SetCaptureEnabled(bool enabled) { m_CaptureEnabled = enabled; }
+
+		const PhysicsStats2D& GetStats() const { return m_Stats; }
+
+	private:
+		// Index of a body in m_Bodies, which also indexes its visit flag.
+		uint32_t GetBodyIndex(b2Body* body) const;
+
+	private:
+		PhysicsStats2D m_Stats;
+		std::atomic<bool> m_CaptureEnabled = false;
+
+		// Scratch space for the island walk. m_Bodies holds every non static body sorted by address.
+		std::vector<b2Body*> m_Bodies;
+		std::vector<uint8_t> m_Visited;
+		std::vector<uint32_t> m_IslandStack;
+	};
+}
@@ -0,0 +1,71 @@
+#include "Lpch.h"
+#include "PhysicsQuery2D.h"
+
+#include <box2d/b2_fixture.h>
+#include <box2d/b2_body.h>
+
+namespace Locus
+{
+	namespace Utils
+	{
+		static bool PassesMask(b2Fixture* fixture, uint16_t mask)
+		{
+			return (fixture->GetFilterData().categoryBits & mask) != 0;
+		}
+	}
+
+	float RaycastClosestCallback2D::ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction)
+	{
+		// -1 ignores the fixture and keeps the ray unchanged.
+		if (!Utils::PassesMask(fixture, m_Mask))
+			return -1.0f;
+
+		Hit = true;
+		Result.Entity = (UUID)fixture->GetBody()->GetUserData().pointer;
+		Result.Point = { point.x, point.y };
+		Result.Normal = { normal.x, normal.y };
+		Result.Fraction = fraction;
+		return fraction;
+	}
+
+	float RaycastAllCallback2D::ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction)
+	{
+		if (!Utils::PassesMask(fixture, m_Mask))
+			return -1.0f;
+
+		RaycastHit2D& hit = m_Hits.emplace_back();
+		hit.Entity = (UUID)fixture->GetBody()->GetUserData().pointer;
+		hit.Point = { point.x, point.y };
+		hit.Normal = { normal.x, normal.y };
+		hit.Fraction = fraction;
+		return 1.0f;
+	}
+
+	bool OverlapCallback2D::ReportFixture(b2Fixture* fixture)
+	{
+		if (!Utils::PassesMask(fixture, m_Mask))
+			return true;
+
+		// The broadphase only tests AABBs.
+		if (m_Shape)
+		{
+			const b2Shape* shape = fixture->GetShape();
+			bool overlaps = false;
+			for (int32_t child = 0; child < shape->GetChildCount() && !overlaps; child++)
+				overlaps = b2TestOverlap(shape, child, m_Shape, 0, fixture->GetBody()->GetTransform(), m_Transform);
+			if (!overlaps)
+				return true;
+		}
+
+		// A body can report several fixtures.
+		UUID entity = (UUID)fixture->GetBody()->GetUserData().pointer;
+		for (uint32_t i = 0; i < Count; i++)
+		{
+			if (m_Results[i] == entity)
+				return true;
+		}
+
+		m_Results[Count++] = entity;
+		return Count < m_MaxCount;
+	}
+}
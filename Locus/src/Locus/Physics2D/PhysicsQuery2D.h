@@ -0,0 +1,69 @@
+// --- PhysicsQuery2D ---------------------------------------------------------
+// Box2D broadphase callbacks behind the Scene's raycast and overlap queries.
+//	Results are written into caller provided buffers so queries from scripts
+//	don't allocate.
+#pragma once
+
+#include <box2d/b2_world_callbacks.h>
+#include <box2d/b2_collision.h>
+#include <glm/glm.hpp>
+
+#include "Locus/Core/UUID.h"
+
+namespace Locus
+{
+	// Layout matches Locus.RaycastHit2D in C#.
+	struct RaycastHit2D
+	{
+		UUID Entity = 0;
+		glm::vec2 Point = { 0.0f, 0.0f };
+		glm::vec2 Normal = { 0.0f, 0.0f };
+		// Distance along the ray in units of the ray's length.
+		float Fraction = 0.0f;
+	};
+
+	// Keeps the closest hit by clipping the ray to every reported fixture.
+	class RaycastClosestCallback2D : public b2RayCastCallback
+	{
+	public:
+		RaycastClosestCallback2D(uint16_t mask) : m_Mask(mask) {}
+
+		virtual float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override;
+
+		bool Hit = false;
+		RaycastHit2D Result;
+	private:
+		uint16_t m_Mask;
+	};
+
+	// Collects every hit into a buffer. Hits are reported in broadphase order, not by distance.
+	class RaycastAllCallback2D : public b2RayCastCallback
+	{
+	public:
+		RaycastAllCallback2D(std::vector<RaycastHit2D>& hits, uint16_t mask) : m_Hits(hits), m_Mask(mask) {}
+
+		virtual float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override;
+
+	private:
+		std::vector<RaycastHit2D>& m_Hits;
+		uint16_t m_Mask;
+	};
+
+	// Collects entities whose fixtures overlap a shape, or its AABB if no shape is given.
+	class OverlapCallback2D : public b2QueryCallback
+	{
+	public:
+		OverlapCallback2D(UUID* results, uint32_t maxCount, uint16_t mask, const b2Shape* shape = nullptr, const b2Transform& transform = b2Transform())
+			: m_Results(results), m_MaxCount(maxCount), m_Mask(mask), m_Shape(shape), m_Transform(transform) {}
+
+		virtual bool ReportFixture(b2Fixture* fixture) override;
+
+		uint32_t Count = 0;
+	private:
+		UUID* m_Results;
+		uint32_t m_MaxCount;
+		uint16_t m_Mask;
+		const b2Shape* m_Shape;
+		b2Transform m_Transform;
+	};
+}
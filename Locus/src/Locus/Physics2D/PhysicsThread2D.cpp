@@ -0,0 +1,68 @@
+#include "Lpch.h"
+#include "PhysicsThread2D.h"
+
+namespace Locus
+{
+	PhysicsThread2D::PhysicsThread2D()
+	{
+		m_Thread = std::thread(&PhysicsThread2D::ThreadLoop, this);
+	}
+
+	PhysicsThread2D::~PhysicsThread2D()
+	{
+		Wait();
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_State = State::Stopping;
+		}
+		m_Condition.notify_all();
+		m_Thread.join();
+	}
+
+	void PhysicsThread2D::Kick(std::function<void()> job)
+	{
+		Wait();
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Job = std::move(job);
+			m_State = State::Kicked;
+		}
+		m_Condition.notify_all();
+	}
+
+	void PhysicsThread2D::Wait()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_State != State::Kicked; });
+	}
+
+	bool PhysicsThread2D::IsBusy()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_State == State::Kicked;
+	}
+
+	void PhysicsThread2D::ThreadLoop()
+	{
+		while (true)
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_State != State::Idle; });
+			if (m_State == State::Stopping)
+				break;
+			lock.unlock();
+
+			{
+				LOCUS_PROFILE_SCOPE("PhysicsThread2D Step");
+				m_Job();
+			}
+
+			lock.lock();
+			m_Job = nullptr;
+			m_State = State::Idle;
+			m_Condition.notify_all();
+		}
+	}
+}
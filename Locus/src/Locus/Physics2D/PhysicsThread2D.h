@@ -0,0 +1,66 @@
+// --- PhysicsThread2D --------------------------------------------------------
+// Worker thread that steps a scene's Box2D world while the main thread runs
+//	scripts and rendering. The main thread kicks one job per frame and waits
+//	for it at the next sync point, so the world must only be touched by the
+//	main thread while IsBusy() is false.
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <glm/glm.hpp>
+
+#include "Locus/Core/UUID.h"
+
+namespace Locus
+{
+	// Pose of a non static body after the last fixed step of a physics job.
+	struct PhysicsPose2D
+	{
+		UUID ID;
+		glm::vec2 PreviousPosition = { 0.0f, 0.0f };
+		float PreviousAngle = 0.0f;
+		glm::vec2 Position = { 0.0f, 0.0f };
+		float Angle = 0.0f;
+		glm::vec2 LinearVelocity = { 0.0f, 0.0f };
+	};
+
+	struct PhysicsPoseBuffer2D
+	{
+		std::vector<PhysicsPose2D> Poses;
+		// Interpolation factor between PreviousPosition and Position.
+		float Alpha = 1.0f;
+		// False if the job took no fixed step. Poses are left untouched in that case.
+		bool Stepped = false;
+	};
+
+	class PhysicsThread2D
+	{
+	public:
+		PhysicsThread2D();
+		~PhysicsThread2D();
+
+		// Runs job on the physics thread. Waits for the previous job first.
+		void Kick(std::function<void()> job);
+		// Blocks until the kicked job has finished.
+		void Wait();
+
+		bool IsBusy();
+
+	private:
+		void ThreadLoop();
+
+	private:
+		enum class State
+		{
+			Idle = 0, Kicked, Stopping
+		};
+
+		std::thread m_Thread;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		State m_State = State::Idle;
+		std::function<void()> m_Job;
+	};
+}
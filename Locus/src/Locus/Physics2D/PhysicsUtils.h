@@ -1,7 +1,18 @@
+// --- PhysicsUtils -----------------------------------------------------------
+// Helpers shared by the scene's Box2D setup and sync code.
+#pragma once
+
 #include <box2d/b2_body.h>
+#include <box2d/b2_fixture.h>
+#include <box2d/b2_polygon_shape.h>
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_edge_shape.h>
+#include <box2d/b2_chain_shape.h>
 
 #include "Locus/Core/Log.h"
+#include "Locus/Core/Hash.h"
 #include "Locus/Scene/Components.h"
+#include "Locus/Physics2D/CollisionLayers2D.h"
 
 namespace Locus
 {
@@ -19,5 +30,199 @@ namespace Locus
 			LOCUS_CORE_ASSERT(false, "Unknown Rigidbody2DType");
 			return b2_staticBody;
 		}
+
+		// Covers everything a compound collider's fixtures are built from, including the layer matrix.
+		static uint64_t HashCompoundCollider(const CompoundCollider2DComponent& cc2D, const glm::vec3& scale, float mass)
+		{
+			uint64_t hash = HashBytes(&scale, sizeof(scale));
+			hash = HashBytes(&mass, sizeof(mass), hash);
+			for (const ColliderShape2D& shape : cc2D.Shapes)
+			{
+				uint16_t maskBits = CollisionLayers2D::GetEffectiveMask(shape.CollisionCategory, shape.CollisionMask);
+				hash = HashBytes(&shape.Type, sizeof(shape.Type), hash);
+				hash = HashBytes(&shape.Friction, sizeof(shape.Friction), hash);
+				hash = HashBytes(&shape.Restitution, sizeof(shape.Restitution), hash);
+				hash = HashBytes(&shape.RestitutionThreshold, sizeof(shape.RestitutionThreshold), hash);
+				hash = HashBytes(&shape.CollisionCategory, sizeof(shape.CollisionCategory), hash);
+				hash = HashBytes(&maskBits, sizeof(maskBits), hash);
+				hash = HashBytes(&shape.Offset, sizeof(shape.Offset), hash);
+				hash = HashBytes(&shape.Size, sizeof(shape.Size), hash);
+				hash = HashBytes(&shape.Radius, sizeof(shape.Radius), hash);
+				hash = HashBytes(&shape.Loop, sizeof(shape.Loop), hash);
+				hash = HashBytes(shape.Vertices.data(), shape.Vertices.size() * sizeof(glm::vec2), hash);
+			}
+			// Never 0 so an empty component still counts as built.
+			return hash ? hash : 1;
+		}
+
+		// Box2D asserts on hulls that collapse to fewer than 3 points or have no area. Mirrors its welding
+		//	(points closer than half the linear slop merge) and checks the area of the convex hull.
+		static bool IsValidPolygon(const std::vector<b2Vec2>& vertices)
+		{
+			std::vector<b2Vec2> points;
+			for (const b2Vec2& vertex : vertices)
+			{
+				bool unique = true;
+				for (const b2Vec2& point : points)
+					unique &= b2DistanceSquared(vertex, point) >= (0.5f * b2_linearSlop) * (0.5f * b2_linearSlop);
+				if (unique)
+					points.push_back(vertex);
+			}
+			if (points.size() < 3)
+				return false;
+
+			// Monotone chain hull, then the shoelace area.
+			std::sort(points.begin(), points.end(), [](const b2Vec2& a, const b2Vec2& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+			std::vector<b2Vec2> hull(points.size() * 2);
+			size_t size = 0;
+			for (int pass = 0; pass < 2; pass++)
+			{
+				size_t start = size;
+				for (size_t i = 0; i < points.size(); i++)
+				{
+					const b2Vec2& point = pass == 0 ? points[i] : points[points.size() - 1 - i];
+					while (size >= start + 2 && b2Cross(hull[size - 1] - hull[size - 2], point - hull[size - 2]) <= 0.0f)
+						size--;
+					hull[size++] = point;
+				}
+				size--;
+			}
+			if (size < 3)
+				return false;
+
+			float area = 0.0f;
+			for (size_t i = 0; i < size; i++)
+				area += b2Cross(hull[i], hull[(i + 1) % size]);
+			return 0.5f * area > b2_linearSlop * b2_linearSlop;
+		}
+
+		// Box2D asserts when two consecutive chain vertices are within the linear slop.
+		static bool HasValidChainSpacing(const std::vector<b2Vec2>& vertices, bool loop)
+		{
+			size_t count = vertices.size();
+			size_t edgeCount = loop ? count : count - 1;
+			for (size_t i = 0; i < edgeCount; i++)
+			{
+				if (b2DistanceSquared(vertices[i], vertices[(i + 1) % count]) <= b2_linearSlop * b2_linearSlop)
+					return false;
+			}
+			return true;
+		}
+
+		// Creates the fixture of one compound collider shape. Returns nullptr if the shape is degenerate: too few or too many
+		//	vertices, a polygon without area or chain vertices closer than the linear slop.
+		static b2Fixture* CreateColliderShapeFixture(b2Body* body, const ColliderShape2D& shape, const glm::vec3& scale, float mass, entt::entity entity)
+		{
+			b2Vec2 offset = { shape.Offset.x * scale.x, shape.Offset.y * scale.y };
+			std::vector<b2Vec2> vertices;
+			vertices.reserve(shape.Vertices.size());
+			for (const glm::vec2& vertex : shape.Vertices)
+				vertices.push_back({ vertex.x * scale.x + offset.x, vertex.y * scale.y + offset.y });
+			int32_t count = (int32_t)vertices.size();
+
+			b2PolygonShape polygon;
+			b2CircleShape circle;
+			b2EdgeShape edge;
+			b2ChainShape chain;
+			b2FixtureDef fixtureDef;
+			switch (shape.Type)
+			{
+			case ColliderShape2DType::Box:
+			{
+				polygon.SetAsBox(shape.Size.x * scale.x / 2, shape.Size.y * scale.y / 2, offset, 0.0f);
+				fixtureDef.shape = &polygon;
+				break;
+			}
+			case ColliderShape2DType::Circle:
+			{
+				float maxScale = scale.x > scale.y ? scale.x : scale.y;
+				circle.m_p = { maxScale * shape.Offset.x, maxScale * shape.Offset.y };
+				circle.m_radius = maxScale * shape.Radius;
+				fixtureDef.shape = &circle;
+				break;
+			}
+			case ColliderShape2DType::Polygon:
+			{
+				if (count < 3 || count > b2_maxPolygonVertices)
+				{
+					LOCUS_CORE_WARN("Polygon colliders need 3 to {0} vertices", b2_maxPolygonVertices);
+					return nullptr;
+				}
+				if (!IsValidPolygon(vertices))
+				{
+					LOCUS_CORE_WARN("Polygon collider has no area. Its vertices are collinear or too close together");
+					return nullptr;
+				}
+				polygon.Set(vertices.data(), count);
+				fixtureDef.shape = &polygon;
+				break;
+			}
+			case ColliderShape2DType::Edge:
+			{
+				if (count < 2)
+				{
+					LOCUS_CORE_WARN("Edge colliders need 2 vertices");
+					return nullptr;
+				}
+				if (b2DistanceSquared(vertices[0], vertices[1]) <= b2_linearSlop * b2_linearSlop)
+				{
+					LOCUS_CORE_WARN("Edge collider vertices are too close together");
+					return nullptr;
+				}
+				edge.SetTwoSided(vertices[0], vertices[1]);
+				fixtureDef.shape = &edge;
+				break;
+			}
+			case ColliderShape2DType::Chain:
+			{
+				if (count < (shape.Loop ? 3 : 2))
+				{
+					LOCUS_CORE_WARN("Chain colliders need at least {0} vertices", shape.Loop ? 3 : 2);
+					return nullptr;
+				}
+				if (!HasValidChainSpacing(vertices, shape.Loop))
+				{
+					LOCUS_CORE_WARN("Chain collider has consecutive vertices closer than {0}", b2_linearSlop);
+					return nullptr;
+				}
+				if (shape.Loop)
+				{
+					chain.CreateLoop(vertices.data(), count);
+				}
+				else
+				{
+					// Ghost vertices continue the chain in a straight line so its ends have no false normals.
+					b2Vec2 prev = { 2.0f * vertices[0].x - vertices[1].x, 2.0f * vertices[0].y - vertices[1].y };
+					b2Vec2 next = { 2.0f * vertices[count - 1].x - vertices[count - 2].x, 2.0f * vertices[count - 1].y - vertices[count - 2].y };
+					chain.CreateChain(vertices.data(), count, prev, next);
+				}
+				fixtureDef.shape = &chain;
+				break;
+			}
+			}
+
+			fixtureDef.density = mass;
+			fixtureDef.friction = shape.Friction;
+			fixtureDef.restitution = shape.Restitution;
+			fixtureDef.restitutionThreshold = shape.RestitutionThreshold;
+			fixtureDef.filter.categoryBits = shape.CollisionCategory;
+			fixtureDef.filter.maskBits = CollisionLayers2D::GetEffectiveMask(shape.CollisionCategory, shape.CollisionMask);
+			fixtureDef.userData.pointer = (uintptr_t)entity;
+			return body->CreateFixture(&fixtureDef);
+		}
+
+		// Static bodies whose fixtures all have an empty mask can never collide, so they are disabled,
+		//	which removes their proxies from the broadphase. Disabled bodies are also skipped by queries.
+		static void UpdateBroadphasePresence(b2Body* body)
+		{
+			if (body->GetType() != b2_staticBody || !body->GetFixtureList())
+				return;
+
+			bool collides = false;
+			for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+				collides |= fixture->GetFilterData().maskBits != 0;
+			if (body->IsEnabled() != collides)
+				body->SetEnabled(collides);
+		}
 	}
 }
\ No newline at end of file
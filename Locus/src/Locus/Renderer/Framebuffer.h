@@ -56,7 +56,12 @@ namespace Locus
 		virtual void Unbind() = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
+		// Synchronous readback. Stalls until the GPU has finished all previous work.
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+		// Starts an asynchronous read of a single integer pixel. A newer request replaces a pending one.
+		virtual void RequestPixel(uint32_t attachmentIndex, int x, int y) = 0;
+		// Returns true once the requested pixel has been read back, usually one or two frames later.
+		virtual bool GetRequestedPixel(int& outPixel) = 0;
 		virtual void BindTexture(uint32_t attachmentIndex) = 0;
 
 		virtual void ClearAttachmentInt(uint32_t attachmentIndex, int value) = 0;
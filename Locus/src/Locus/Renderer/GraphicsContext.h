@@ -11,6 +11,10 @@ namespace Locus
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		// Binds/unbinds the context to the calling thread. Used to hand the context to the render thread.
+		virtual void MakeCurrent() = 0;
+		virtual void DetachCurrent() = 0;
+
 		static Scope<GraphicsContext> Create(void* window);
 	};
 }
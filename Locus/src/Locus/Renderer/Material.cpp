@@ -63,4 +63,20 @@ namespace Locus
 		m_AOTexture = aoTex;
 
 	}
+
+	ShaderDefines Material::GetFeatureDefines(uint32_t features)
+	{
+		ShaderDefines defines;
+		if (features & MaterialFeatureAlbedoMap)
+			defines.push_back("HAS_ALBEDO_MAP");
+		if (features & MaterialFeatureNormalMap)
+			defines.push_back("HAS_NORMAL_MAP");
+		if (features & MaterialFeatureMetallicMap)
+			defines.push_back("HAS_METALLIC_MAP");
+		if (features & MaterialFeatureRoughnessMap)
+			defines.push_back("HAS_ROUGHNESS_MAP");
+		if (features & MaterialFeatureAOMap)
+			defines.push_back("HAS_AO_MAP");
+		return defines;
+	}
 }
\ No newline at end of file
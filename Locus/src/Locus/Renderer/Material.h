@@ -7,6 +7,19 @@
 
 namespace Locus
 {
+	// Texture inputs a material uses. Each combination renders with its own PBR shader variant.
+	enum MaterialFeature
+	{
+		MaterialFeatureNone = 0,
+		MaterialFeatureAlbedoMap = BIT(0),
+		MaterialFeatureNormalMap = BIT(1),
+		MaterialFeatureMetallicMap = BIT(2),
+		MaterialFeatureRoughnessMap = BIT(3),
+		MaterialFeatureAOMap = BIT(4),
+
+		MaterialFeatureCount = 5
+	};
+
 	class Material
 	{
 	public:
@@ -18,6 +31,9 @@ namespace Locus
 		const std::string& GetName() const { return m_Name; }
 		const std::filesystem::path& GetPath() const { return m_Path; }
 
+		// Shader defines for a MaterialFeature bitmask.
+		static ShaderDefines GetFeatureDefines(uint32_t features);
+
 	public:
 		std::filesystem::path m_Path;
 		std::string m_Name;
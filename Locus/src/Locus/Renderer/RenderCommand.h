@@ -59,6 +59,11 @@ namespace Locus
 			s_RendererAPI->SetLineWidth(width);
 		}
 
+		inline static void SetFaceCulling(bool enabled)
+		{
+			s_RendererAPI->SetFaceCulling(enabled);
+		}
+
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
 	};
@@ -0,0 +1,69 @@
+#include "Lpch.h"
+#include "RenderCommandQueue.h"
+
+namespace Locus
+{
+	RenderCommandQueue::RenderCommandQueue()
+	{
+		m_Commands.reserve(1024);
+		m_Blocks.push_back({ new uint8_t[s_BlockSize], s_BlockSize, 0 });
+	}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		// Run anything left so captured resources are released.
+		Execute();
+
+		for (auto& block : m_Blocks)
+			delete[] block.Data;
+	}
+
+	void* RenderCommandQueue::Allocate(RenderCommandFn fn, uint32_t size)
+	{
+		uint8_t* storage = AllocateBytes(size);
+		m_Commands.push_back({ fn, storage });
+		return storage;
+	}
+
+	void* RenderCommandQueue::AllocateData(const void* data, uint32_t size)
+	{
+		uint8_t* storage = AllocateBytes(size);
+		memcpy(storage, data, size);
+		return storage;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		for (auto& command : m_Commands)
+			command.Fn(command.Storage);
+
+		m_Commands.clear();
+		for (auto& block : m_Blocks)
+			block.Offset = 0;
+		m_CurrentBlock = 0;
+	}
+
+	uint8_t* RenderCommandQueue::AllocateBytes(uint32_t size)
+	{
+		// 16 byte alignment covers every functor and vertex type we record.
+		size = (size + 15) & ~15u;
+
+		// Blocks are never reallocated so pointers handed out stay valid until Execute().
+		while (m_Blocks[m_CurrentBlock].Offset + size > m_Blocks[m_CurrentBlock].Size)
+		{
+			m_CurrentBlock++;
+			if (m_CurrentBlock == m_Blocks.size())
+			{
+				uint32_t blockSize = std::max(size, s_BlockSize);
+				m_Blocks.push_back({ new uint8_t[blockSize], blockSize, 0 });
+			}
+		}
+
+		Block& block = m_Blocks[m_CurrentBlock];
+		uint8_t* storage = block.Data + block.Offset;
+		block.Offset += size;
+		return storage;
+	}
+}
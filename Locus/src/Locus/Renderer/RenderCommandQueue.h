@@ -0,0 +1,50 @@
+// --- RenderCommandQueue -----------------------------------------------------
+// Recorded list of render commands. Commands are type erased functors stored
+// in block allocated memory that is reused every frame, so recording does not
+// allocate once the blocks have grown to the size of a frame.
+#pragma once
+
+namespace Locus
+{
+	class RenderCommandQueue
+	{
+	public:
+		typedef void(*RenderCommandFn)(void*);
+
+		RenderCommandQueue();
+		~RenderCommandQueue();
+
+		// Returns storage for a functor of the given size. fn is called with it on Execute().
+		void* Allocate(RenderCommandFn fn, uint32_t size);
+		// Copies data into the queue. The copy stays valid until Execute() returns.
+		void* AllocateData(const void* data, uint32_t size);
+
+		// Runs all commands in the order they were recorded and resets the queue.
+		void Execute();
+
+		inline uint32_t GetCommandCount() const { return (uint32_t)m_Commands.size(); }
+
+	private:
+		uint8_t* AllocateBytes(uint32_t size);
+
+	private:
+		struct Command
+		{
+			RenderCommandFn Fn;
+			void* Storage;
+		};
+
+		struct Block
+		{
+			uint8_t* Data = nullptr;
+			uint32_t Size = 0;
+			uint32_t Offset = 0;
+		};
+
+		static const uint32_t s_BlockSize = 4 * 1024 * 1024;
+
+		std::vector<Command> m_Commands;
+		std::vector<Block> m_Blocks;
+		uint32_t m_CurrentBlock = 0;
+	};
+}
@@ -0,0 +1,163 @@
+#include "Lpch.h"
+#include "RenderThread.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Locus/Renderer/GraphicsContext.h"
+
+namespace Locus
+{
+	enum class RenderThreadState
+	{
+		Idle = 0, Kicked, Stopping
+	};
+
+	struct RenderThreadData
+	{
+		GraphicsContext* Context = nullptr;
+		std::thread Thread;
+		std::thread::id ThreadID;
+		bool Running = false;
+
+		// The main thread records into SubmitIndex while the render thread executes the other queue.
+		RenderCommandQueue Queues[2];
+		uint32_t SubmitIndex = 0;
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		RenderThreadState State = RenderThreadState::Idle;
+	};
+
+	static RenderThreadData s_RTData;
+
+	static void RenderThreadLoop()
+	{
+		s_RTData.Context->MakeCurrent();
+
+		while (true)
+		{
+			std::unique_lock<std::mutex> lock(s_RTData.Mutex);
+			s_RTData.Condition.wait(lock, []() { return s_RTData.State != RenderThreadState::Idle; });
+			if (s_RTData.State == RenderThreadState::Stopping)
+				break;
+			uint32_t executeIndex = (s_RTData.SubmitIndex + 1) % 2;
+			lock.unlock();
+
+			{
+				LOCUS_PROFILE_SCOPE("RenderThread Execute");
+				s_RTData.Queues[executeIndex].Execute();
+			}
+
+			lock.lock();
+			s_RTData.State = RenderThreadState::Idle;
+			s_RTData.Condition.notify_all();
+		}
+
+		s_RTData.Context->DetachCurrent();
+	}
+
+	void RenderThread::Start(GraphicsContext* context)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		LOCUS_CORE_ASSERT(!s_RTData.Running, "Render thread already running!");
+
+		// A context can only be current on one thread.
+		s_RTData.Context = context;
+		s_RTData.Context->DetachCurrent();
+
+		s_RTData.State = RenderThreadState::Idle;
+		s_RTData.SubmitIndex = 0;
+		s_RTData.Thread = std::thread(RenderThreadLoop);
+		s_RTData.ThreadID = s_RTData.Thread.get_id();
+		s_RTData.Running = true;
+
+		LOCUS_CORE_INFO("Render thread started");
+	}
+
+	void RenderThread::Stop()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		if (!s_RTData.Running)
+			return;
+
+		Flush();
+
+		{
+			std::lock_guard<std::mutex> lock(s_RTData.Mutex);
+			s_RTData.State = RenderThreadState::Stopping;
+		}
+		s_RTData.Condition.notify_all();
+		s_RTData.Thread.join();
+		s_RTData.Running = false;
+		s_RTData.ThreadID = std::thread::id();
+
+		s_RTData.Context->MakeCurrent();
+
+		LOCUS_CORE_INFO("Render thread stopped");
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_RTData.Running;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return std::this_thread::get_id() == s_RTData.ThreadID;
+	}
+
+	const void* RenderThread::CopyData(const void* data, uint32_t size)
+	{
+		if (!IsRecording())
+			return data;
+		return GetSubmitQueue().AllocateData(data, size);
+	}
+
+	void RenderThread::WaitForFrame()
+	{
+		if (!s_RTData.Running)
+			return;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		std::unique_lock<std::mutex> lock(s_RTData.Mutex);
+		s_RTData.Condition.wait(lock, []() { return s_RTData.State == RenderThreadState::Idle; });
+	}
+
+	void RenderThread::KickFrame()
+	{
+		if (!s_RTData.Running)
+			return;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		WaitForFrame();
+
+		{
+			std::lock_guard<std::mutex> lock(s_RTData.Mutex);
+			s_RTData.SubmitIndex = (s_RTData.SubmitIndex + 1) % 2;
+			s_RTData.State = RenderThreadState::Kicked;
+		}
+		s_RTData.Condition.notify_all();
+	}
+
+	void RenderThread::Flush()
+	{
+		KickFrame();
+		WaitForFrame();
+	}
+
+	bool RenderThread::IsRecording()
+	{
+		return s_RTData.Running && std::this_thread::get_id() != s_RTData.ThreadID;
+	}
+
+	RenderCommandQueue& RenderThread::GetSubmitQueue()
+	{
+		return s_RTData.Queues[s_RTData.SubmitIndex];
+	}
+}
@@ -0,0 +1,72 @@
+// --- RenderThread -----------------------------------------------------------
+// Dedicated render thread that owns the graphics context.
+// The main thread (front end) records commands with Submit() into one of two
+// command queues while the render thread (back end) replays the other, so
+// simulation of frame N+1 overlaps GPU submission of frame N.
+// Until Start() is called, and after Stop(), submitted commands execute
+// immediately on the calling thread.
+#pragma once
+
+#include "Locus/Renderer/RenderCommandQueue.h"
+
+namespace Locus
+{
+	class GraphicsContext;
+
+	class RenderThread
+	{
+	public:
+		// Hands the graphics context over to a new render thread.
+		static void Start(GraphicsContext* context);
+		// Executes remaining commands, joins the render thread and makes the context current on the calling thread again.
+		static void Stop();
+
+		static bool IsRunning();
+		static bool IsRenderThread();
+
+		// Records a command. Runs it immediately if the render thread is not running or if called from the render thread.
+		template<typename FuncT>
+		static void Submit(FuncT&& func)
+		{
+			if (!IsRecording())
+			{
+				func();
+				return;
+			}
+
+			using Functor = std::decay_t<FuncT>;
+			auto renderCommand = [](void* storage)
+			{
+				Functor* functor = (Functor*)storage;
+				(*functor)();
+				functor->~Functor();
+			};
+			void* storage = GetSubmitQueue().Allocate(renderCommand, sizeof(Functor));
+			new (storage) Functor(std::forward<FuncT>(func));
+		}
+
+		// Records a command and blocks until the render thread has executed it. Only use it for readbacks, resources
+		// are created without waiting (see RendererHandle).
+		template<typename FuncT>
+		static void SubmitAndWait(FuncT&& func)
+		{
+			Submit(std::forward<FuncT>(func));
+			Flush();
+		}
+
+		// Copies data into the current command queue so recorded commands can read it after the caller's buffer
+		// changes. Returns data unchanged when commands are executed immediately.
+		static const void* CopyData(const void* data, uint32_t size);
+
+		// Blocks until the render thread has finished the previously kicked frame.
+		static void WaitForFrame();
+		// Hands the commands recorded so far to the render thread and returns without waiting for them.
+		static void KickFrame();
+		// Kicks the recorded commands and waits for them to execute.
+		static void Flush();
+
+	private:
+		static bool IsRecording();
+		static RenderCommandQueue& GetSubmitQueue();
+	};
+}
@@ -34,6 +34,8 @@ namespace Locus
 		Ref<VertexBuffer> ScreenVB;
 		ScreenVertex ScreenVertexBuffer[6];
 
+		ShaderLibrary Shaders;
+
 		// Debug
 		std::vector<int> UBOBindings;
 	};
@@ -113,6 +115,12 @@ namespace Locus
 
 	}
 
+	void Renderer::SetModelTransform(const glm::mat4& transform)
+	{
+		glm::mat4 view = s_Data.CameraBuffer.View * transform;
+		s_Data.CameraUniformBuffer->SetData(&view, sizeof(glm::mat4), offsetof(RendererData::CameraData, View));
+	}
+
 	void Renderer::DrawPostProcess(Ref<Texture> texture, Ref<Shader> shader)
 	{
 		s_Data.CameraBuffer.ViewportSize = { texture->GetWidth(), texture->GetHeight() };
@@ -130,6 +138,11 @@ namespace Locus
 		RenderCommand::Resize(0, 0, width, height);
 	}
 
+	ShaderLibrary& Renderer::GetShaderLibrary()
+	{
+		return s_Data.Shaders;
+	}
+
 	std::vector<int>& Renderer::GetUBOBindings()
 	{
 		return s_Data.UBOBindings;
@@ -25,12 +25,18 @@ namespace Locus
 
 		static void EndScene();
 
+		// Folds a model transform into the camera's view matrix for draws whose vertices are kept in
+		//	local space. Set it back to identity after them.
+		static void SetModelTransform(const glm::mat4& transform);
+
 		// Renders a post process effect to the texture
 		static void DrawPostProcess(Ref<Texture> texture, Ref<Shader> shader);
 
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+		// Shaders in this library are hot reloaded when their source files change.
+		static ShaderLibrary& GetShaderLibrary();
 		static std::vector<int>& GetUBOBindings();
 	};
 }
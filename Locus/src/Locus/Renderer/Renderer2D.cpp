@@ -4,6 +4,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Locus/Core/Hash.h"
+#include "Locus/Renderer/Renderer.h"
 #include "Locus/Renderer/RendererStats.h"
 #include "Locus/Renderer/RenderCommand.h"
 #include "Locus/Renderer/VertexArray.h"
@@ -11,8 +13,6 @@
 #include "Locus/Renderer/UniformBuffer.h"
 #include "Locus/Resource/TextureManager.h"
 
-#include <glad/glad.h>
-
 namespace Locus
 {
 	struct QuadVertex
@@ -51,6 +51,7 @@ namespace Locus
 
 		Ref<VertexArray> QuadVA;
 		Ref<VertexBuffer> QuadVB;
+		Ref<IndexBuffer> QuadIB;
 		Ref<Shader> QuadShader;
 
 		Ref<VertexArray> CircleVA;
@@ -81,6 +82,11 @@ namespace Locus
 
 		glm::vec4 QuadVertexPositions[4];
 		glm::vec2 TexCoords[4];
+
+		// Used to cull tilemap chunks.
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		std::vector<QuadVertex> ChunkVertices;
+		std::vector<std::pair<glm::ivec2, TilemapChunk*>> VisibleChunks;
 	};
 
 	static Renderer2DData s_Data;
@@ -119,6 +125,7 @@ namespace Locus
 		}
 		Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, s_Data.MaxIndices);
 		s_Data.QuadVA->SetIndexBuffer(quadIB);
+		s_Data.QuadIB = quadIB;
 		delete[] quadIndices;
 		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
 
@@ -157,9 +164,12 @@ namespace Locus
 		uint64_t whiteTextureData = 0xfffffffff;
 		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
 
-		s_Data.QuadShader = Shader::Create("resources/shaders/2DQuad.glsl");
-		s_Data.CircleShader = Shader::Create("resources/shaders/2DCircle.glsl");
-		s_Data.LineShader = Shader::Create("resources/shaders/2DLine.glsl");
+		auto shaders = Shader::CreateBatch({ "resources/shaders/2DQuad.glsl", "resources/shaders/2DCircle.glsl", "resources/shaders/2DLine.glsl" });
+		s_Data.QuadShader = shaders[0];
+		s_Data.CircleShader = shaders[1];
+		s_Data.LineShader = shaders[2];
+		for (auto& shader : shaders)
+			Renderer::GetShaderLibrary().Add(shader);
 		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
 
 		// Initialize quad data
@@ -187,6 +197,7 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
+		s_Data.ViewProjection = camera.GetViewProjectionMatrix();
 		StartBatch();
 	}
 
@@ -194,6 +205,7 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
+		s_Data.ViewProjection = camera.GetProjection() * glm::inverse(transform);
 		StartBatch();
 	}
 
@@ -220,7 +232,7 @@ namespace Locus
 
 	void Renderer2D::Flush()
 	{
-		glDisable(GL_CULL_FACE); // temp
+		RenderCommand::SetFaceCulling(false); // temp
 		if (s_Data.QuadIndexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
@@ -258,7 +270,7 @@ namespace Locus
 
 			RendererStats::GetStats().DrawCalls++;
 		}
-		glEnable(GL_CULL_FACE);
+		RenderCommand::SetFaceCulling(true);
 	}
 
 	void Renderer2D::DrawQuadMask(const glm::mat4& transform, Ref<Shader> shader)
@@ -422,6 +434,184 @@ namespace Locus
 			DrawQuad(transform, src.Color, entityID);
 	}
 
+	namespace Utils
+	{
+		// Conservative test of a local space rectangle against the clip volume.
+		static bool IsRectVisible(const glm::mat4& mvp, const glm::vec2& min, const glm::vec2& max)
+		{
+			glm::vec4 corners[4] = {
+				mvp * glm::vec4(min.x, min.y, 0.0f, 1.0f),
+				mvp * glm::vec4(max.x, min.y, 0.0f, 1.0f),
+				mvp * glm::vec4(max.x, max.y, 0.0f, 1.0f),
+				mvp * glm::vec4(min.x, max.y, 0.0f, 1.0f)
+			};
+
+			bool left = true, right = true, bottom = true, top = true;
+			for (const glm::vec4& corner : corners)
+			{
+				// Corners behind the camera can't be tested in clip space.
+				if (corner.w <= 0.0f)
+					return true;
+				left &= corner.x < -corner.w;
+				right &= corner.x > corner.w;
+				bottom &= corner.y < -corner.w;
+				top &= corner.y > corner.w;
+			}
+			return !(left || right || bottom || top);
+		}
+
+		// Range of chunk coordinates that covers the part of the tilemap's plane inside the clip volume.
+		//	The four side edges of the volume are intersected with the plane. Returns false if one of them
+		//	misses it between the near and far planes, e.g. when the camera looks toward the horizon.
+		static bool GetVisibleChunkRange(const glm::mat4& mvp, const glm::vec2& chunkExtent, glm::ivec2& outMin, glm::ivec2& outMax)
+		{
+			glm::mat4 inverse = glm::inverse(mvp);
+			glm::vec2 min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest());
+			for (float x : { -1.0f, 1.0f })
+			{
+				for (float y : { -1.0f, 1.0f })
+				{
+					glm::vec4 nearPoint = inverse * glm::vec4(x, y, -1.0f, 1.0f);
+					glm::vec4 farPoint = inverse * glm::vec4(x, y, 1.0f, 1.0f);
+					glm::vec3 a = glm::vec3(nearPoint) / nearPoint.w;
+					glm::vec3 b = glm::vec3(farPoint) / farPoint.w;
+					if (a.z != 0.0f && (a.z > 0.0f) == (b.z > 0.0f))
+						return false;
+
+					float t = a.z == b.z ? 0.0f : a.z / (a.z - b.z);
+					glm::vec2 point = glm::mix(glm::vec2(a), glm::vec2(b), t);
+					min = glm::min(min, point);
+					max = glm::max(max, point);
+				}
+			}
+
+			// Chunk coordinates of tile coordinates always fit.
+			const glm::vec2 limit((float)(INT32_MAX / TilemapChunk::Size));
+			outMin = glm::ivec2(glm::clamp(glm::floor(min / chunkExtent), -limit, limit));
+			outMax = glm::ivec2(glm::clamp(glm::floor(max / chunkExtent), -limit, limit));
+			return true;
+		}
+
+		static uint64_t HashTilemapSettings(const TilemapComponent& tilemap, int entityID)
+		{
+			uint64_t hash = HashBytes(&tilemap.TileSize, sizeof(tilemap.TileSize));
+			hash = HashBytes(&tilemap.TilesetSize, sizeof(tilemap.TilesetSize), hash);
+			hash = HashBytes(&tilemap.Color, sizeof(tilemap.Color), hash);
+			hash = HashBytes(&entityID, sizeof(entityID), hash);
+			return hash;
+		}
+	}
+
+	void Renderer2D::DrawTilemap(const glm::mat4& transform, TilemapComponent& tilemap, int entityID)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		Ref<Texture2D> texture = TextureManager::GetTexture(tilemap.Tileset);
+		if (!texture)
+			texture = s_Data.WhiteTexture;
+
+		// Chunks are drawn with their own buffers, so anything batched so far goes first to keep draw order.
+		FlushAndReset();
+		s_Data.WhiteTexture->Bind(0);
+		texture->Bind(1);
+		s_Data.QuadShader->Bind();
+
+		const int32_t size = TilemapChunk::Size;
+		glm::vec2 chunkExtent = tilemap.TileSize * (float)size;
+		glm::ivec2 tilesetSize = glm::max(tilemap.TilesetSize, glm::ivec2(1));
+		glm::vec2 tileUV = 1.0f / glm::vec2(tilesetSize);
+		glm::mat4 mvp = s_Data.ViewProjection * transform;
+		uint64_t settingsHash = Utils::HashTilemapSettings(tilemap, entityID);
+
+		// Only the chunks in view are looked up, unless the view covers more coordinates than the map has chunks.
+		auto& chunks = tilemap.Map.GetChunks();
+		s_Data.VisibleChunks.clear();
+		glm::ivec2 rangeMin, rangeMax;
+		if (Utils::GetVisibleChunkRange(mvp, chunkExtent, rangeMin, rangeMax) &&
+			(uint64_t)(rangeMax.x - rangeMin.x + 1) * (uint64_t)(rangeMax.y - rangeMin.y + 1) < chunks.size())
+		{
+			for (int32_t y = rangeMin.y; y <= rangeMax.y; y++)
+			{
+				for (int32_t x = rangeMin.x; x <= rangeMax.x; x++)
+				{
+					auto it = chunks.find(Tilemap::GetChunkKey(x, y));
+					if (it != chunks.end())
+						s_Data.VisibleChunks.push_back({ { x, y }, &it->second });
+				}
+			}
+		}
+		else
+		{
+			for (auto& [key, chunk] : chunks)
+				s_Data.VisibleChunks.push_back({ Tilemap::GetChunkCoord(key), &chunk });
+		}
+
+		// Vertices are in tilemap space, so moving the tilemap only changes the view matrix.
+		Renderer::SetModelTransform(transform);
+		for (auto& [coord, chunkPtr] : s_Data.VisibleChunks)
+		{
+			TilemapChunk& chunk = *chunkPtr;
+			glm::vec2 min = glm::vec2(coord) * chunkExtent;
+			if (chunk.TileCount == 0 || !Utils::IsRectVisible(mvp, min, min + chunkExtent))
+				continue;
+
+			if (chunk.Dirty || chunk.RuntimeSettingsHash != settingsHash)
+			{
+				LOCUS_PROFILE_SCOPE("Build Tilemap Chunk");
+
+				s_Data.ChunkVertices.clear();
+				for (int32_t y = 0; y < size; y++)
+				{
+					for (int32_t x = 0; x < size; x++)
+					{
+						uint16_t tile = chunk.Tiles[y * size + x];
+						if (tile == 0)
+							continue;
+
+						// Tileset rows count down from the top of the texture.
+						int32_t index = tile - 1;
+						glm::vec2 uvMin = { (index % tilesetSize.x) * tileUV.x, 1.0f - (index / tilesetSize.x + 1) * tileUV.y };
+						glm::vec2 tileMin = min + glm::vec2(x, y) * tilemap.TileSize;
+						for (uint32_t i = 0; i < 4; i++)
+						{
+							QuadVertex& vertex = s_Data.ChunkVertices.emplace_back();
+							glm::vec2 corner = glm::vec2(s_Data.QuadVertexPositions[i]) + 0.5f;
+							vertex.Position = glm::vec3(tileMin + corner * tilemap.TileSize, 0.0f);
+							vertex.Color = tilemap.Color;
+							vertex.TexCoord = uvMin + s_Data.TexCoords[i] * tileUV;
+							vertex.TexIndex = 1.0f;
+							vertex.TilingFactor = 1.0f;
+							vertex.EntityID = entityID;
+						}
+					}
+				}
+
+				// The chunk's buffer is reused. It is only reallocated when the chunk outgrows it,
+				//	at which point it doubles, up to a full chunk.
+				uint32_t dataSize = (uint32_t)(s_Data.ChunkVertices.size() * sizeof(QuadVertex));
+				if (!chunk.RuntimeVertexBuffer || dataSize > chunk.RuntimeVertexBufferSize)
+				{
+					uint32_t fullSize = size * size * 4 * sizeof(QuadVertex);
+					chunk.RuntimeVertexBufferSize = glm::min(glm::max(dataSize, chunk.RuntimeVertexBufferSize * 2), fullSize);
+					chunk.RuntimeVertexBuffer = VertexBuffer::Create(chunk.RuntimeVertexBufferSize);
+					chunk.RuntimeVertexBuffer->SetLayout(s_Data.QuadVB->GetLayout());
+					chunk.RuntimeVertexArray = VertexArray::Create();
+					chunk.RuntimeVertexArray->AddVertexBuffer(chunk.RuntimeVertexBuffer);
+					chunk.RuntimeVertexArray->SetIndexBuffer(s_Data.QuadIB);
+				}
+				chunk.RuntimeVertexBuffer->SetData(s_Data.ChunkVertices.data(), dataSize);
+				chunk.RuntimeQuadCount = (uint32_t)s_Data.ChunkVertices.size() / 4;
+				chunk.RuntimeSettingsHash = settingsHash;
+				chunk.Dirty = false;
+			}
+
+			RenderCommand::DrawIndexed(chunk.RuntimeVertexArray, chunk.RuntimeQuadCount * 6);
+			RendererStats::GetStats().DrawCalls++;
+			RendererStats::GetStats().QuadCount += chunk.RuntimeQuadCount;
+		}
+		Renderer::SetModelTransform(glm::mat4(1.0f));
+	}
+
 	void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int entityID)
 	{
 		LOCUS_PROFILE_FUNCTION();
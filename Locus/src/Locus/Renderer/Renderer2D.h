@@ -28,6 +28,8 @@ namespace Locus
 		static void SetLineWidth(float width);
 
 		static void DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID);
+		// Draws the visible chunks of a tilemap with one draw call each. Chunk vertices are rebuilt only after edits.
+		static void DrawTilemap(const glm::mat4& transform, TilemapComponent& tilemap, int entityID);
 		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityID = -1);
 		static void DrawDebugCircle(const glm::mat4& transform, const glm::vec4& color, uint32_t sides = 32);
 		static void DrawLine(const glm::vec3& point1, const glm::vec3& point2, const glm::vec4& color, int entityID = -1);
@@ -6,6 +6,7 @@
 
 #include "Locus/Scene/Entity.h"
 #include "Locus/Scene/Scene.h"
+#include "Locus/Renderer/Renderer.h"
 #include "Locus/Renderer/RendererStats.h"
 #include "Locus/Renderer/RenderCommand.h"
 #include "Locus/Renderer/VertexArray.h"
@@ -21,11 +22,13 @@ namespace Locus
 		static const uint32_t MaxCubeVertices = MaxInstances * 36;
 		static const uint32_t MaxTextureSlots = 32;
 		static const uint32_t MaxMaterialSlots = 32;
+		static const uint32_t PBRVariantCount = 1 << MaterialFeatureCount;
 
-		Ref<Shader> PBRShader;
+		// PBR shader variants indexed by MaterialFeature bitmask. Compiled on first use.
+		std::array<Ref<Shader>, PBRVariantCount> PBRVariants;
 
-		// Model
-		std::unordered_map<Ref<VertexArray>, std::vector<InstanceData>> Models;
+		// Model instances batched per PBR variant.
+		std::array<std::unordered_map<Ref<VertexArray>, std::vector<InstanceData>>, PBRVariantCount> Models;
 
 		// Cube
 		Ref<VertexArray> CubeVA;
@@ -116,8 +119,10 @@ namespace Locus
 		s_R3DData.GridVB->SetData(&gridVertexData, sizeof(int) * 6);
 
 		// --- Initializations ------------------------------------------------
-		s_R3DData.PBRShader = Shader::Create("resources/shaders/PBRShader.glsl");
 		s_R3DData.GridShader = Shader::Create("resources/shaders/GridShader.glsl");
+		Renderer::GetShaderLibrary().Add(s_R3DData.GridShader);
+		// Untextured variant is used by the default material so compile it up front.
+		GetPBRVariant(MaterialFeatureNone);
 
 		// Define cube vertices and normals
 		MeshVertex* cubeVertices = new MeshVertex[36];
@@ -345,7 +350,8 @@ namespace Locus
 		s_R3DData.TextureSlotIndex = 1;
 		s_R3DData.MaterialSlotIndex = 1;
 		s_R3DData.InstanceIndex = 0;
-		s_R3DData.Models.clear();
+		for (auto& models : s_R3DData.Models)
+			models.clear();
 	}
 
 	void Renderer3D::Flush()
@@ -358,17 +364,24 @@ namespace Locus
 		// Materials
 		s_R3DData.MaterialUniformBuffer->SetData(&s_R3DData.MaterialBuffer[0], sizeof(Renderer3DData::MaterialBufferData) * s_R3DData.MaterialSlotIndex);
 
-		s_R3DData.PBRShader->Bind();
-
-		for (auto& [ va, instanceData ] : s_R3DData.Models)
+		for (uint32_t features = 0; features < Renderer3DData::PBRVariantCount; features++)
 		{
-			// VertexBuffer[1] in our model is where the instanced data is.
-			va->GetVertexBuffers()[1]->SetData(instanceData.data(), static_cast<uint32_t>(instanceData.size() * sizeof(InstanceData)));
-			if (va->GetIndexBuffer())
-				RenderCommand::DrawIndexedInstanced(va, va->GetIndexBuffer()->GetCount(), static_cast<uint32_t>(instanceData.size()));
-			else
-				RenderCommand::DrawArrayInstanced(va, 36, static_cast<uint32_t>(instanceData.size())); // Temp for cubes
-			RendererStats::GetStats().DrawCalls++;
+			auto& models = s_R3DData.Models[features];
+			if (models.empty())
+				continue;
+
+			GetPBRVariant(features)->Bind();
+
+			for (auto& [ va, instanceData ] : models)
+			{
+				// VertexBuffer[1] in our model is where the instanced data is.
+				va->GetVertexBuffers()[1]->SetData(instanceData.data(), static_cast<uint32_t>(instanceData.size() * sizeof(InstanceData)));
+				if (va->GetIndexBuffer())
+					RenderCommand::DrawIndexedInstanced(va, va->GetIndexBuffer()->GetCount(), static_cast<uint32_t>(instanceData.size()));
+				else
+					RenderCommand::DrawArrayInstanced(va, 36, static_cast<uint32_t>(instanceData.size())); // Temp for cubes
+				RendererStats::GetStats().DrawCalls++;
+			}
 		}
 	}
 
@@ -381,7 +394,8 @@ namespace Locus
 		s_R3DData.TextureSlotIndex = 1;
 		s_R3DData.MaterialSlotIndex = 1;
 		s_R3DData.InstanceIndex = 0;
-		s_R3DData.Models.clear();
+		for (auto& models : s_R3DData.Models)
+			models.clear();
 	}
 
 	void Renderer3D::DrawCube(const glm::mat4& transform, Ref<Material> material, int entityID)
@@ -401,6 +415,7 @@ namespace Locus
 
 		// Add texture to texture slot. Handles duplicates.
 		int materialIndex = 0;
+		uint32_t features = MaterialFeatureNone;
 		if (material)
 		{
 			int albedoTexIndex = ProcessTextureSlot(material->m_AlbedoTexture.Get());
@@ -411,6 +426,18 @@ namespace Locus
 
 			// Material uniform data
 			materialIndex = ProcessMaterialSlot(material, albedoTexIndex, normalTexIndex, metallicTexIndex, roughnessTexIndex, aoTexIndex);
+
+			// Shader variant
+			if (albedoTexIndex)
+				features |= MaterialFeatureAlbedoMap;
+			if (normalTexIndex)
+				features |= MaterialFeatureNormalMap;
+			if (metallicTexIndex)
+				features |= MaterialFeatureMetallicMap;
+			if (roughnessTexIndex)
+				features |= MaterialFeatureRoughnessMap;
+			if (aoTexIndex)
+				features |= MaterialFeatureAOMap;
 		}
 
 		// Instance data
@@ -418,7 +445,7 @@ namespace Locus
 		data.ModelMatrix = transform;
 		data.MaterialIndex = materialIndex;
 		data.EntityID = entityID;
-		s_R3DData.Models[va].push_back(data);
+		s_R3DData.Models[features][va].push_back(data);
 		
 		s_R3DData.InstanceIndex++;
 	}
@@ -451,6 +478,14 @@ namespace Locus
 		RendererStats::GetStats().DrawCalls++;
 	}
 
+	const Ref<Shader>& Renderer3D::GetPBRVariant(uint32_t features)
+	{
+		auto& shader = s_R3DData.PBRVariants[features];
+		if (!shader)
+			shader = Renderer::GetShaderLibrary().LoadVariant("resources/shaders/PBRShader.glsl", Material::GetFeatureDefines(features));
+		return shader;
+	}
+
 	int Renderer3D::ProcessTextureSlot(Ref<Texture2D> texture)
 	{
 		LOCUS_PROFILE_FUNCTION();
@@ -34,6 +34,8 @@ namespace Locus
 		static uint32_t GetMaxInstances();
 
 	private:
+		// Returns the PBR shader variant for a MaterialFeature bitmask, compiling it on first use.
+		static const Ref<Shader>& GetPBRVariant(uint32_t features);
 		static int ProcessTextureSlot(Ref<Texture2D> texture);
 		static int ProcessMaterialSlot(Ref<Material> material, int albedoIndex, int normalIndex, int metallicIndex, int roughnessIndex, int aoIndex);
 	};
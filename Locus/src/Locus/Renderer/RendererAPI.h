@@ -31,6 +31,7 @@ namespace Locus
 
 		virtual void Resize(int x, int y, int width, int height) = 0;
 		virtual void SetLineWidth(float width) = 0;
+		virtual void SetFaceCulling(bool enabled) = 0;
 
 		inline static API GetAPI() { return s_API; }
 
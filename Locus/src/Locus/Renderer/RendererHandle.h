@@ -0,0 +1,53 @@
+// --- RendererHandle ---------------------------------------------------------
+// Name of a graphics object that is created on the render thread.
+// Constructors record the create command and return right away with a pending
+// handle. Recorded commands copy the handle and read the name with operator*
+// when they execute, which is always after the create command. Get() reads the
+// name on the main thread and only waits for the render thread while the
+// create command has not run yet.
+#pragma once
+
+#include <atomic>
+
+#include "Locus/Renderer/RenderThread.h"
+
+namespace Locus
+{
+	class RendererHandle
+	{
+	public:
+		// Wraps an existing name (or none) and never waits.
+		RendererHandle(uint32_t name = 0)
+			: m_Name(CreateRef<std::atomic<uint32_t>>(name)) {}
+
+		// Handle for an object whose create command is about to be recorded.
+		static RendererHandle Pending() { return RendererHandle(s_Pending); }
+
+		// Render thread. Stores the created name, or 0 if creation failed.
+		void Set(uint32_t name) const { m_Name->store(name, std::memory_order_release); }
+
+		// Reads the name inside a recorded command. Returns 0 while the object is pending.
+		uint32_t operator*() const
+		{
+			uint32_t name = m_Name->load(std::memory_order_acquire);
+			return name == s_Pending ? 0 : name;
+		}
+
+		bool IsPending() const { return m_Name->load(std::memory_order_acquire) == s_Pending; }
+
+		// Main thread. Waits for the render thread if the object has not been created yet.
+		uint32_t Get() const
+		{
+			if (IsPending() && RenderThread::IsRunning() && !RenderThread::IsRenderThread())
+				RenderThread::Flush();
+			return **this;
+		}
+
+		bool operator==(const RendererHandle& other) const { return m_Name == other.m_Name; }
+
+	private:
+		static constexpr uint32_t s_Pending = UINT32_MAX;
+
+		Ref<std::atomic<uint32_t>> m_Name;
+	};
+}
@@ -18,25 +18,39 @@ namespace Locus
 		return nullptr;
 	}
 
-	Ref<Shader> Shader::Create(const std::string& filepath)
+	Ref<Shader> Shader::Create(const std::string& filepath, const ShaderDefines& defines)
 	{
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None: LOCUS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-		case RendererAPI::API::OpenGL: return CreateRef<OpenGLShader>(filepath);
+		case RendererAPI::API::OpenGL: return CreateRef<OpenGLShader>(filepath, defines);
 		}
 
 		LOCUS_CORE_ASSERT(false, "Unknown Renderer API!");
 		return nullptr;
 	}
 
-	
+	std::vector<Ref<Shader>> Shader::CreateBatch(const std::vector<std::string>& filepaths)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: LOCUS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return {};
+		case RendererAPI::API::OpenGL: return OpenGLShader::CreateBatch(filepaths);
+		}
+
+		LOCUS_CORE_ASSERT(false, "Unknown Renderer API!");
+		return {};
+	}
 
 	// --- ShaderLibrary ---------------------------------------------------------
 	void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
 	{
 		LOCUS_CORE_ASSERT(!Exists(name), "Shader already exists!");
 		m_Shaders[name] = shader;
+
+		std::error_code error;
+		if (!shader->GetFilePath().empty())
+			m_WriteTimes[name] = std::filesystem::last_write_time(shader->GetFilePath(), error);
 	}
 
 	void ShaderLibrary::Add(const Ref<Shader>& shader)
@@ -59,6 +73,24 @@ namespace Locus
 		return shader;
 	}
 
+	Locus::Ref<Locus::Shader> ShaderLibrary::LoadVariant(const std::string& filepath, const ShaderDefines& defines)
+	{
+		// Key: filepath|DEFINE_A|DEFINE_B with the defines sorted so the order they are given in doesn't matter.
+		ShaderDefines sortedDefines = defines;
+		std::sort(sortedDefines.begin(), sortedDefines.end());
+		std::string key = filepath;
+		for (const auto& define : sortedDefines)
+			key += "|" + define;
+
+		auto it = m_Shaders.find(key);
+		if (it != m_Shaders.end())
+			return it->second;
+
+		auto shader = Shader::Create(filepath, sortedDefines);
+		Add(key, shader);
+		return shader;
+	}
+
 	Locus::Ref<Locus::Shader> ShaderLibrary::Get(const std::string& name)
 	{
 		LOCUS_CORE_ASSERT(Exists(name), "Shader not found!");
@@ -69,4 +101,30 @@ namespace Locus
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
+
+	void ShaderLibrary::CheckForChanges()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		for (auto& [name, shader] : m_Shaders)
+			shader->ApplyReload();
+
+		if (m_PollTimer.ElapsedMillis() < s_PollIntervalMillis)
+			return;
+		m_PollTimer.Reset();
+
+		for (auto& [name, writeTime] : m_WriteTimes)
+		{
+			auto& shader = m_Shaders[name];
+			// last_write_time can fail while an editor is replacing the file. Try again next poll.
+			std::error_code error;
+			auto currentWriteTime = std::filesystem::last_write_time(shader->GetFilePath(), error);
+			if (error || currentWriteTime == writeTime)
+				continue;
+
+			writeTime = currentWriteTime;
+			LOCUS_CORE_INFO("Shader {0} changed. Recompiling...", name);
+			shader->ReloadAsync();
+		}
+	}
 }
@@ -1,15 +1,22 @@
 // --- Shader -----------------------------------------------------------------
 // Shader interface and ShaderLibrary class.
 // Shader can be creates with either a filepath or a string of shader code.
+// ShaderLibrary watches the source files of its shaders and hot reloads them.
 #pragma once
 
 #include <string>
 #include <unordered_map>
+#include <filesystem>
+
+#include "Locus/Core/Timer.h"
 
 #include <glm/glm.hpp>
 
 namespace Locus
 {
+	// Preprocessor defines a shader variant is compiled with. Entries are "NAME" or "NAME=VALUE".
+	using ShaderDefines = std::vector<std::string>;
+
 	class Shader
 	{
 	public:
@@ -19,9 +26,21 @@ namespace Locus
 		virtual void Unbind() const = 0;
 		
 		virtual const std::string& GetName() const = 0;
+		// Empty for shaders created from source strings.
+		virtual const std::string& GetFilePath() const = 0;
+
+		// Recompiles the source file on a worker thread. The current program stays bound until
+		// ApplyReload() swaps in the new one.
+		virtual void ReloadAsync() = 0;
+		// Main thread. Polls the reload and returns true once a recompiled program was swapped in.
+		// Never waits: the program is swapped on a later call once the render thread has linked it.
+		// A failed compile keeps the previous program.
+		virtual bool ApplyReload() = 0;
 
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
-		static Ref<Shader> Create(const std::string& filepath);
+		static Ref<Shader> Create(const std::string& filepath, const ShaderDefines& defines = {});
+		// Compiles several shader files concurrently. Returned in the same order as filepaths.
+		static std::vector<Ref<Shader>> CreateBatch(const std::vector<std::string>& filepaths);
 	};
 
 
@@ -36,10 +55,22 @@ namespace Locus
 		void Add(const Ref<Shader>& shader);
 		Ref<Shader> Load(const std::string& filepath);
 		Ref<Shader> Load(const std::string& name, const std::string& filepath);
+		// Returns the variant of the shader compiled with the given defines. Variants are compiled
+		// the first time they are requested and cached by file and define set.
+		Ref<Shader> LoadVariant(const std::string& filepath, const ShaderDefines& defines);
 
 		Ref<Shader> Get(const std::string& name);
 		bool Exists(const std::string& name) const;
+
+		// Polls shader source files for changes, starts background recompiles and swaps in finished ones.
+		// Call once per frame on the main thread.
+		void CheckForChanges();
 	private:
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+
+		// --- Hot reload ---
+		std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+		Timer m_PollTimer;
+		static constexpr float s_PollIntervalMillis = 250.0f;
 	};
 }
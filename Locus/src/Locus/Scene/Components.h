@@ -6,6 +6,7 @@
 //	Child
 //	SpriteRenderer
 //	CircleRenderer
+//	Tilemap
 //	CubeRenderer
 //	MeshRenderer
 //	PointLight
@@ -15,6 +16,7 @@
 //	Rigidbody2D
 //	BoxCollider2D
 //	CircleCollider2D
+//	CompoundCollider2D
 //	NativeScript
 //	Script
 // 
@@ -35,6 +37,7 @@
 #include "Locus/Renderer/Texture.h"
 #include "Locus/Scene/SceneCamera.h"
 #include "Locus/Scene/Entity.h"
+#include "Locus/Scene/Tilemap.h"
 #include "Locus/Math/Math.h"
 #include "Locus/Resource/TextureManager.h"
 #include "Locus/Resource/MaterialManager.h"
@@ -43,6 +46,7 @@
 namespace Locus
 {
 	enum class Rigidbody2DType { Static = 0, Dynamic = 1, Kinematic = 2 };
+	enum class ColliderShape2DType { Box = 0, Circle = 1, Polygon = 2, Edge = 3, Chain = 4 };
 
 	struct IDComponent
 	{
@@ -142,6 +146,32 @@ namespace Locus
 		CircleRendererComponent(const CircleRendererComponent&) = default;
 	};
 
+	struct TilemapComponent
+	{
+		// Tileset texture split into a grid of tiles.
+		TextureHandle Tileset;
+		glm::ivec2 TilesetSize = { 1, 1 }; // Columns, rows
+		glm::vec2 TileSize = { 1.0f, 1.0f };
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		// Solid tiles are merged into box fixtures on a static body.
+		bool Collision = true;
+		float Friction = 0.3f; // 0 - 1
+		uint16_t CollisionCategory = 0x0001;
+		uint16_t CollisionMask = 0xFFFF;
+
+		Tilemap Map;
+
+		void* RuntimeBody = nullptr;
+		// Fixtures per chunk key, so editing a chunk rebuilds only its boxes.
+		std::unordered_map<uint64_t, std::vector<void*>> RuntimeChunkFixtures;
+		// Collision setting the fixtures were built with.
+		bool RuntimeCollision = false;
+
+		TilemapComponent() = default;
+		TilemapComponent(const TilemapComponent&) = default;
+	};
+
 	struct CubeRendererComponent
 	{
 		MaterialHandle Material;
@@ -211,6 +241,12 @@ namespace Locus
 		bool IsBullet = false;
 		
 		void* RuntimeBody = nullptr;
+		// Body pose before the last fixed step. Used to interpolate the rendered transform.
+		glm::vec2 PreviousPosition = { 0.0f, 0.0f };
+		float PreviousAngle = 0.0f;
+		// Body state at the last physics sync. Scripts read this while the world steps on the physics thread.
+		glm::vec2 SyncedPosition = { 0.0f, 0.0f };
+		glm::vec2 SyncedVelocity = { 0.0f, 0.0f };
 
 		Rigidbody2DComponent() = default;
 		Rigidbody2DComponent(const Rigidbody2DComponent&) = default;
@@ -254,13 +290,58 @@ namespace Locus
 		CircleCollider2DComponent(const CircleCollider2DComponent&) = default;
 	};
 
+	// One fixture of a CompoundCollider2DComponent.
+	struct ColliderShape2D
+	{
+		ColliderShape2DType Type = ColliderShape2DType::Box;
+
+		float Friction = 0.3f; // 0 - 1
+		float Restitution = 0.0f; // 0 - 1
+		float RestitutionThreshold = 1.0f;
+
+		uint16_t CollisionCategory = 0x0001;
+		uint16_t CollisionMask = 0xFFFF;
+
+		glm::vec2 Offset = { 0.0f, 0.0f };
+		// Box
+		glm::vec2 Size = { 1.0f, 1.0f };
+		// Circle
+		float Radius = 0.5f;
+		// Polygon (3 - 8 convex vertices), Edge (first two vertices) and Chain. Local to Offset.
+		std::vector<glm::vec2> Vertices;
+		// Chain. Connects the last vertex to the first.
+		bool Loop = false;
+	};
+
+	// Several fixtures on one body. Chains suit static level geometry where
+	//	thousands of boxes would each add a broadphase proxy.
+	struct CompoundCollider2DComponent
+	{
+		std::vector<ColliderShape2D> Shapes;
+
+		void* RuntimeBody = nullptr;
+		std::vector<void*> RuntimeFixtures;
+		// Hash of the shapes the fixtures were built from. Fixtures are rebuilt when it changes.
+		uint64_t RuntimeHash = 0;
+
+		CompoundCollider2DComponent() = default;
+		CompoundCollider2DComponent(const CompoundCollider2DComponent&) = default;
+	};
+
 	struct ScriptComponent
 	{
 		std::string ScriptClass;
 
+		// Owned by the ScriptEngine. Only valid while the scene is running.
+		void* RuntimeInstance = nullptr;
+
 		ScriptComponent() = default;
-		ScriptComponent(const ScriptComponent&) = default;
 		ScriptComponent(const std::string& scriptClass) : ScriptClass(scriptClass) {}
+		// Copies never share an instance with the source entity.
+		ScriptComponent(const ScriptComponent& other) : ScriptClass(other.ScriptClass) {}
+		ScriptComponent& operator=(const ScriptComponent& other) { ScriptClass = other.ScriptClass; RuntimeInstance = nullptr; return *this; }
+		ScriptComponent(ScriptComponent&&) = default;
+		ScriptComponent& operator=(ScriptComponent&&) = default;
 	};
 
 	enum class ComponentType
@@ -271,6 +352,7 @@ namespace Locus
 		Child,
 		SpriteRenderer,
 		CircleRenderer,
+		Tilemap,
 		CubeRenderer,
 		MeshRenderer,
 		PointLight,
@@ -280,6 +362,7 @@ namespace Locus
 		Rigidbody2D,
 		BoxCollider2D,
 		CircleCollider2D,
+		CompoundCollider2D,
 		Script
 	};
 
@@ -292,6 +375,7 @@ namespace Locus
 		Ref<TransformComponent> Transform;
 		Ref<SpriteRendererComponent> SpriteRenderer;
 		Ref<CircleRendererComponent> CircleRenderer;
+		Ref<TilemapComponent> Tilemap;
 		Ref<CubeRendererComponent> CubeRenderer;
 		Ref<MeshRendererComponent> MeshRenderer;
 		Ref<PointLightComponent> PointLight;
@@ -301,6 +385,7 @@ namespace Locus
 		Ref<Rigidbody2DComponent> Rigidbody2D;
 		Ref<BoxCollider2DComponent> BoxCollider2D;
 		Ref<CircleCollider2DComponent> CircleCollider2D;
+		Ref<CompoundCollider2DComponent> CompoundCollider2D;
 		Ref<ScriptComponent> Script;
 	};
 }
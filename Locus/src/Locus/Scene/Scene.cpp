@@ -16,15 +16,37 @@
 #include "Locus/Scene/Components.h"
 #include "Locus/Scene/Entity.h"
 #include "Locus/Scripting/ScriptEngine.h"
+#include "Locus/Scripting/ScriptProfiler.h"
 #include "Locus/Physics2D/ContactListener2D.h"
 #include "Locus/Physics2D/PhysicsUtils.h"
+#include "Locus/Physics2D/CollisionLayers2D.h"
+#include "Locus/Physics2D/CollisionFilter2D.h"
 #include "Locus/Resource/TextureManager.h"
 
 namespace Locus
 {
 	Scene::Scene()
 	{
-		m_ContactListener = CreateRef<ContactListener2D>();
+		m_ContactListener = CreateRef<ContactListener2D>(this);
+		m_CollisionFilter = CreateRef<CollisionFilter2D>();
+
+		// Physics is synced from change notifications instead of checking every entity each frame.
+		m_Registry.on_construct<Rigidbody2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_construct<BoxCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_construct<CircleCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_construct<CompoundCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_construct<TilemapComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_update<Rigidbody2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_update<BoxCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_update<CircleCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_update<CompoundCollider2DComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		m_Registry.on_update<TilemapComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+		// Entities disabled on start have no physics data until they are enabled.
+		m_Registry.on_update<TagComponent>().connect<&Scene::OnPhysicsComponentChanged>(this);
+
+		m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagComponentChanged>(this);
+		m_Registry.on_update<TagComponent>().connect<&Scene::OnTagComponentChanged>(this);
+		m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagComponentDestroyed>(this);
 	}
 
 	Entity Scene::CreateEntity(const std::string& name)
@@ -38,10 +60,11 @@ namespace Locus
 		entity.AddComponent<IDComponent>(uuid);
 		entity.AddComponent<TransformComponent>();
 		entity.GetComponent<TransformComponent>().Self = uuid;
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = name.empty() ? "Entity" : name;
+		// Filled in before it is added so the tag index sees the final values.
+		TagComponent tag(name.empty() ? "Entity" : name);
 		tag.Group = "Default";
 		tag.Enabled = true;
+		entity.AddComponent<TagComponent>(tag);
 		m_Entities[uuid] = entity;
 		return entity;
 	}
@@ -88,6 +111,7 @@ namespace Locus
 		newScene->m_SceneName = other->m_SceneName;
 		newScene->m_ViewportWidth = other->m_ViewportWidth;
 		newScene->m_ViewportHeight = other->m_ViewportHeight;
+		newScene->m_Physics2DSettings = other->m_Physics2DSettings;
 
 		other->m_Registry.each([&](auto entityID)
 			{
@@ -113,6 +137,7 @@ namespace Locus
 		CopyComponent<TransformComponent>(from, to);
 		CopyComponent<SpriteRendererComponent>(from, to);
 		CopyComponent<CircleRendererComponent>(from, to);
+		CopyComponent<TilemapComponent>(from, to);
 		CopyComponent<CubeRendererComponent>(from, to);
 		CopyComponent<MeshRendererComponent>(from, to);
 		CopyComponent<PointLightComponent>(from, to);
@@ -122,6 +147,7 @@ namespace Locus
 		CopyComponent<Rigidbody2DComponent>(from, to);
 		CopyComponent<BoxCollider2DComponent>(from, to);
 		CopyComponent<CircleCollider2DComponent>(from, to);
+		CopyComponent<CompoundCollider2DComponent>(from, to);
 		CopyComponent<ScriptComponent>(from, to);
 	}
 
@@ -138,6 +164,7 @@ namespace Locus
 
 		// 2D
 		Renderer2D::BeginScene(camera);
+		DrawTilemaps();
 		DrawSprites();
 		DrawCircles();
 		Renderer2D::EndScene();
@@ -166,44 +193,22 @@ namespace Locus
 	void Scene::OnRuntimeUpdate(Timestep deltaTime)
 	{
 		// --- Physics ---
-		{ // Check physics data for changes
-			auto view = m_Registry.view<IDComponent>();
-			for (auto e : view)
-			{
-				Entity entity = Entity(e, this);
-				UpdatePhysicsData(entity);
-			}
-		}
-
-		{ // Simulate physics
-			m_Box2DWorld->Step(deltaTime, 6, 2); // TODO: paremeterize
-			m_ContactListener->Execute();
-			auto view = m_Registry.view<Rigidbody2DComponent, TagComponent>();
-			for (auto e : view)
-			{
-				Entity entity = Entity(e, this);
-				if (entity.GetComponent<TagComponent>().Enabled)
-				{
-					auto& transform = entity.GetComponent<TransformComponent>();
-					auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-					b2Body* body = (b2Body*)rb2d.RuntimeBody;
-					const b2Vec2& position = body->GetPosition();
-					transform.LocalPosition = { position.x, position.y , 0.0f };
-					transform.SetLocalRotation({ 0, 0, glm::degrees(body->GetAngle()) });
-				}
-			}
-		}
+		StepPhysics(deltaTime);
 
 		// --- Update C# Scripts ---
 		{
+			// Walks the packed ScriptComponent storage. Instances are cached in the component so there are no UUID lookups.
+			LOCUS_PROFILE_SCOPE("Update Scripts");
 			auto view = m_Registry.view<ScriptComponent, TagComponent>();
 			for (auto e : view)
 			{
-				Entity entity = Entity(e, this);
-				if (entity.GetComponent<TagComponent>().Enabled)
-					ScriptEngine::OnUpdateEntityScript(entity, deltaTime);
+				auto [sc, tag] = view.get<ScriptComponent, TagComponent>(e);
+				if (tag.Enabled && sc.RuntimeInstance)
+					((ScriptInstance*)sc.RuntimeInstance)->InvokeOnUpdate(deltaTime);
 			}
+
+			ScriptEngine::OnUpdateSystems(deltaTime);
+			ScriptProfiler::EndFrame();
 		}
 
 		// --- Lighting ---
@@ -232,6 +237,7 @@ namespace Locus
 
 			// 2D
 			Renderer2D::BeginScene(*mainCamera, cameraTransform);
+			DrawTilemaps();
 			DrawSprites();
 			DrawCircles();
 			Renderer2D::EndScene();
@@ -253,32 +259,7 @@ namespace Locus
 	void Scene::OnPhysicsUpdate(Timestep deltaTime, EditorCamera& camera)
 	{
 		// --- Physics ---
-		{ // Check physics data for changes
-			auto view = m_Registry.view<IDComponent>();
-			for (auto e : view)
-			{
-				Entity entity = Entity(e, this);
-				UpdatePhysicsData(entity);
-			}
-		}
-		{ // Simulate physics
-			m_Box2DWorld->Step(deltaTime, 6, 2); // TODO: paremeterize
-			auto view = m_Registry.view<Rigidbody2DComponent, TagComponent>();
-			for (auto e : view)
-			{
-				Entity entity = Entity(e, this);
-				if (entity.GetComponent<TagComponent>().Enabled)
-				{
-					auto& transform = entity.GetComponent<TransformComponent>();
-					auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-					b2Body* body = (b2Body*)rb2d.RuntimeBody;
-					const b2Vec2& position = body->GetPosition();
-					transform.LocalPosition = { position.x, position.y , 0.0f };
-					transform.SetLocalRotation({ 0, 0, glm::degrees(body->GetAngle()) });
-				}
-			}
-		}
+		StepPhysics(deltaTime);
 
 		// --- Lighting ---
 		ClearLightingData();
@@ -291,6 +272,7 @@ namespace Locus
 
 		// 2D
 		Renderer2D::BeginScene(camera);
+		DrawTilemaps();
 		DrawSprites();
 		DrawCircles();
 		Renderer2D::EndScene();
@@ -312,6 +294,11 @@ namespace Locus
 		{
 			m_Box2DWorld = new b2World({ 0.0f, -9.8f });
 			m_Box2DWorld->SetContactListener(m_ContactListener.get());
+			m_Box2DWorld->SetContactFilter(m_CollisionFilter.get());
+			m_CollisionPairStats = {};
+			m_PhysicsStats = {};
+			m_PhysicsAccumulator = 0.0f;
+			m_DirtyPhysicsEntities.clear();
 
 			auto view = m_Registry.view<TagComponent>();
 			for (auto e : view)
@@ -320,6 +307,9 @@ namespace Locus
 				if (entity.GetComponent<TagComponent>().Enabled)
 					CreatePhysicsData(entity);
 			}
+
+			if (m_Physics2DSettings.Threaded)
+				StartPhysicsThread();
 		}
 
 		// --- C# Scripts ---
@@ -334,6 +324,8 @@ namespace Locus
 					ScriptEngine::OnCreateEntityScript(entity);
 				}
 			}
+
+			ScriptEngine::OnCreateSystems();
 		}
 	}
 
@@ -342,6 +334,11 @@ namespace Locus
 		// --- Physics ---
 		{
 			m_Box2DWorld = new b2World({ 0.0f, -9.8f });
+			m_Box2DWorld->SetContactFilter(m_CollisionFilter.get());
+			m_CollisionPairStats = {};
+			m_PhysicsStats = {};
+			m_PhysicsAccumulator = 0.0f;
+			m_DirtyPhysicsEntities.clear();
 
 			auto view = m_Registry.view<IDComponent>();
 			for (auto e : view)
@@ -350,17 +347,25 @@ namespace Locus
 				if (entity.GetComponent<TagComponent>().Enabled)
 					CreatePhysicsData(entity);
 			}
+
+			if (m_Physics2DSettings.Threaded)
+				StartPhysicsThread();
 		}
 	}
 
 	void Scene::OnRuntimeStop()
 	{
+		// Joins the physics thread before the world goes away. Queued commands are dropped.
+		m_PhysicsThread.reset();
+		m_PhysicsCommands.clear();
 		delete m_Box2DWorld;
 		m_Box2DWorld = nullptr;
 	}
 
 	void Scene::OnPhysicsStop()
 	{
+		m_PhysicsThread.reset();
+		m_PhysicsCommands.clear();
 		delete m_Box2DWorld;
 		m_Box2DWorld = nullptr;
 	}
@@ -398,6 +403,7 @@ namespace Locus
 
 			// 2D
 			Renderer2D::BeginScene(*mainCamera, cameraTransform);
+			DrawTilemaps();
 			DrawSprites();
 			DrawCircles();
 			Renderer2D::EndScene();
@@ -429,6 +435,7 @@ namespace Locus
 
 		// 2D
 		Renderer2D::BeginScene(camera);
+		DrawTilemaps();
 		DrawSprites();
 		DrawCircles();
 		Renderer2D::EndScene();
@@ -459,6 +466,7 @@ namespace Locus
 
 		// 2D
 		Renderer2D::BeginScene(camera, cameraTransform);
+		DrawTilemaps();
 		DrawSprites();
 		DrawCircles();
 		Renderer2D::EndScene();
@@ -471,6 +479,294 @@ namespace Locus
 		Renderer::EndScene();
 	}
 
+	void Scene::StepPhysics(Timestep deltaTime)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		if (m_PhysicsThread)
+		{
+			StepPhysicsThreaded(deltaTime);
+			return;
+		}
+
+		SyncPhysicsData();
+
+		const Physics2DSettings& settings = m_Physics2DSettings;
+		auto bodies = m_Registry.view<Rigidbody2DComponent>();
+
+		m_PhysicsAccumulator += deltaTime;
+		m_CollisionFilter->ResetPairCounts();
+		m_PhysicsProfiler.Reset();
+		uint32_t steps = 0;
+		while (m_PhysicsAccumulator >= settings.FixedTimestep && steps < settings.MaxSubsteps)
+		{
+			for (auto e : bodies)
+			{
+				auto& rb2d = bodies.get<Rigidbody2DComponent>(e);
+				b2Body* body = (b2Body*)rb2d.RuntimeBody;
+				if (!body)
+					continue;
+				rb2d.PreviousPosition = { body->GetPosition().x, body->GetPosition().y };
+				rb2d.PreviousAngle = body->GetAngle();
+			}
+
+			m_PhysicsProfiler.Step(m_Box2DWorld, settings.FixedTimestep, settings.VelocityIterations, settings.PositionIterations);
+			m_PhysicsAccumulator -= settings.FixedTimestep;
+			steps++;
+		}
+
+		// Drop the time the clamp couldn't simulate. Physics runs slower than real time instead of spiraling.
+		if (m_PhysicsAccumulator >= settings.FixedTimestep)
+			m_PhysicsAccumulator = std::fmod(m_PhysicsAccumulator, settings.FixedTimestep);
+		if (steps > 0)
+		{
+			m_PhysicsProfiler.CaptureWorld(m_Box2DWorld);
+			m_PhysicsStats = m_PhysicsProfiler.GetStats();
+			m_CollisionPairStats = m_CollisionFilter->GetPairStats();
+		}
+
+		// Write back poses blended between the last two steps by the leftover time.
+		float alpha = settings.Interpolate ? m_PhysicsAccumulator / settings.FixedTimestep : 1.0f;
+		auto view = m_Registry.view<Rigidbody2DComponent, TagComponent>();
+		for (auto e : view)
+		{
+			Entity entity = Entity(e, this);
+			if (entity.GetComponent<TagComponent>().Enabled)
+			{
+				auto& transform = entity.GetComponent<TransformComponent>();
+				auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+
+				b2Body* body = (b2Body*)rb2d.RuntimeBody;
+				if (!body)
+					continue;
+				const b2Vec2& position = body->GetPosition();
+				glm::vec2 interpolated = glm::mix(rb2d.PreviousPosition, glm::vec2(position.x, position.y), alpha);
+				float angle = rb2d.PreviousAngle + (body->GetAngle() - rb2d.PreviousAngle) * alpha;
+				transform.LocalPosition = { interpolated.x, interpolated.y, 0.0f };
+				transform.SetLocalRotation({ 0, 0, glm::degrees(angle) });
+			}
+		}
+
+		m_ContactListener->Execute();
+	}
+
+	void Scene::StepPhysicsThreaded(Timestep deltaTime)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		// --- Sync point ---
+		// The world is idle until the next kick, so contacts, queued commands and dirty entities are applied here.
+		m_PhysicsThread->Wait();
+		uint32_t stepIndex = (m_PoseReadIndex + 1) % 2;
+		if (m_PoseBuffers[stepIndex].Stepped)
+		{
+			m_PoseReadIndex = stepIndex;
+			m_PhysicsStats = m_PhysicsProfiler.GetStats();
+			m_CollisionPairStats = m_CollisionFilter->GetPairStats();
+		}
+		else
+			m_PoseBuffers[m_PoseReadIndex].Alpha = m_PoseBuffers[stepIndex].Alpha;
+
+		m_ContactListener->Execute();
+		for (auto& command : m_PhysicsCommands)
+			command();
+		m_PhysicsCommands.clear();
+		SyncPhysicsData();
+
+		// --- Kick ---
+		PhysicsPoseBuffer2D* output = &m_PoseBuffers[(m_PoseReadIndex + 1) % 2];
+		Physics2DSettings settings = m_Physics2DSettings;
+		float step = deltaTime;
+		m_PhysicsThread->Kick([this, output, settings, step]() { StepPhysicsWorld(step, settings, *output); });
+
+		// --- Write back ---
+		// Poses of the previous step, blended by its leftover time.
+		const PhysicsPoseBuffer2D& poses = m_PoseBuffers[m_PoseReadIndex];
+		for (const PhysicsPose2D& pose : poses.Poses)
+		{
+			Entity entity = GetEntityByUUID(pose.ID);
+			if (!entity.IsValid() || !entity.HasComponent<Rigidbody2DComponent>() || !entity.GetComponent<TagComponent>().Enabled)
+				continue;
+
+			auto& transform = entity.GetComponent<TransformComponent>();
+			auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+			glm::vec2 interpolated = glm::mix(pose.PreviousPosition, pose.Position, poses.Alpha);
+			float angle = pose.PreviousAngle + (pose.Angle - pose.PreviousAngle) * poses.Alpha;
+			transform.LocalPosition = { interpolated.x, interpolated.y, 0.0f };
+			transform.SetLocalRotation({ 0, 0, glm::degrees(angle) });
+			rb2d.SyncedPosition = pose.Position;
+			rb2d.SyncedVelocity = pose.LinearVelocity;
+		}
+	}
+
+	void Scene::StepPhysicsWorld(float deltaTime, const Physics2DSettings& settings, PhysicsPoseBuffer2D& output)
+	{
+		m_PhysicsAccumulator += deltaTime;
+		m_CollisionFilter->ResetPairCounts();
+		m_PhysicsProfiler.Reset();
+		uint32_t steps = std::min((uint32_t)(m_PhysicsAccumulator / settings.FixedTimestep), settings.MaxSubsteps);
+		output.Stepped = steps > 0;
+
+		if (output.Stepped)
+		{
+			for (uint32_t i = 0; i < steps; i++)
+			{
+				// Only the pose before the last step is needed for interpolation.
+				if (i == steps - 1)
+				{
+					output.Poses.clear();
+					for (b2Body* body = m_Box2DWorld->GetBodyList(); body; body = body->GetNext())
+					{
+						if (body->GetType() == b2_staticBody)
+							continue;
+						PhysicsPose2D& pose = output.Poses.emplace_back();
+						pose.ID = (UUID)body->GetUserData().pointer;
+						pose.PreviousPosition = { body->GetPosition().x, body->GetPosition().y };
+						pose.PreviousAngle = body->GetAngle();
+					}
+				}
+
+				m_PhysicsProfiler.Step(m_Box2DWorld, settings.FixedTimestep, settings.VelocityIterations, settings.PositionIterations);
+				m_PhysicsAccumulator -= settings.FixedTimestep;
+			}
+			m_PhysicsProfiler.CaptureWorld(m_Box2DWorld);
+
+			// Body list order and types don't change during a step, so poses line up with the list.
+			uint32_t index = 0;
+			for (b2Body* body = m_Box2DWorld->GetBodyList(); body; body = body->GetNext())
+			{
+				if (body->GetType() == b2_staticBody)
+					continue;
+				PhysicsPose2D& pose = output.Poses[index++];
+				pose.Position = { body->GetPosition().x, body->GetPosition().y };
+				pose.Angle = body->GetAngle();
+				pose.LinearVelocity = { body->GetLinearVelocity().x, body->GetLinearVelocity().y };
+			}
+		}
+
+		if (m_PhysicsAccumulator >= settings.FixedTimestep)
+			m_PhysicsAccumulator = std::fmod(m_PhysicsAccumulator, settings.FixedTimestep);
+		output.Alpha = settings.Interpolate ? m_PhysicsAccumulator / settings.FixedTimestep : 1.0f;
+	}
+
+	void Scene::StartPhysicsThread()
+	{
+		for (auto& buffer : m_PoseBuffers)
+		{
+			buffer.Poses.clear();
+			buffer.Alpha = 1.0f;
+			buffer.Stepped = false;
+		}
+		m_PoseReadIndex = 0;
+		m_PhysicsCommands.clear();
+		m_PhysicsThread = CreateScope<PhysicsThread2D>();
+	}
+
+	b2World* Scene::GetQueryWorld()
+	{
+		if (m_PhysicsThread)
+			m_PhysicsThread->Wait();
+		return m_Box2DWorld;
+	}
+
+	bool Scene::Raycast2D(const glm::vec2& origin, const glm::vec2& direction, float distance, RaycastHit2D& outHit, uint16_t mask)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		b2World* world = GetQueryWorld();
+		if (!world || distance <= 0.0f || glm::length(direction) == 0.0f)
+			return false;
+
+		glm::vec2 end = origin + glm::normalize(direction) * distance;
+		RaycastClosestCallback2D callback(mask);
+		world->RayCast(&callback, { origin.x, origin.y }, { end.x, end.y });
+		if (callback.Hit)
+			outHit = callback.Result;
+		return callback.Hit;
+	}
+
+	uint32_t Scene::RaycastAll2D(const glm::vec2& origin, const glm::vec2& direction, float distance, RaycastHit2D* outHits, uint32_t maxHits, uint16_t mask)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		b2World* world = GetQueryWorld();
+		if (!world || maxHits == 0 || distance <= 0.0f || glm::length(direction) == 0.0f)
+			return 0;
+
+		glm::vec2 end = origin + glm::normalize(direction) * distance;
+		m_RaycastHits.clear();
+		RaycastAllCallback2D callback(m_RaycastHits, mask);
+		world->RayCast(&callback, { origin.x, origin.y }, { end.x, end.y });
+
+		std::sort(m_RaycastHits.begin(), m_RaycastHits.end(), [](const RaycastHit2D& a, const RaycastHit2D& b) { return a.Fraction < b.Fraction; });
+		uint32_t count = std::min((uint32_t)m_RaycastHits.size(), maxHits);
+		std::copy(m_RaycastHits.begin(), m_RaycastHits.begin() + count, outHits);
+		return count;
+	}
+
+	uint32_t Scene::OverlapAABB2D(const glm::vec2& min, const glm::vec2& max, UUID* outEntities, uint32_t maxCount, uint16_t mask)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		b2World* world = GetQueryWorld();
+		if (!world || maxCount == 0)
+			return 0;
+
+		b2AABB aabb;
+		aabb.lowerBound = { min.x, min.y };
+		aabb.upperBound = { max.x, max.y };
+		OverlapCallback2D callback(outEntities, maxCount, mask);
+		world->QueryAABB(&callback, aabb);
+		return callback.Count;
+	}
+
+	uint32_t Scene::OverlapCircle2D(const glm::vec2& center, float radius, UUID* outEntities, uint32_t maxCount, uint16_t mask)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		b2World* world = GetQueryWorld();
+		if (!world || maxCount == 0)
+			return 0;
+
+		b2CircleShape circle;
+		circle.m_p = { 0.0f, 0.0f };
+		circle.m_radius = radius;
+		b2Transform transform({ center.x, center.y }, b2Rot(0.0f));
+
+		b2AABB aabb;
+		circle.ComputeAABB(&aabb, transform, 0);
+		OverlapCallback2D callback(outEntities, maxCount, mask, &circle, transform);
+		world->QueryAABB(&callback, aabb);
+		return callback.Count;
+	}
+
+	uint32_t Scene::OverlapBox2D(const glm::vec2& center, const glm::vec2& size, float angle, UUID* outEntities, uint32_t maxCount, uint16_t mask)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		b2World* world = GetQueryWorld();
+		if (!world || maxCount == 0)
+			return 0;
+
+		b2PolygonShape box;
+		box.SetAsBox(size.x / 2, size.y / 2);
+		b2Transform transform({ center.x, center.y }, b2Rot(glm::radians(angle)));
+
+		b2AABB aabb;
+		box.ComputeAABB(&aabb, transform, 0);
+		OverlapCallback2D callback(outEntities, maxCount, mask, &box, transform);
+		world->QueryAABB(&callback, aabb);
+		return callback.Count;
+	}
+
+	void Scene::SubmitPhysicsCommand(std::function<void()> func)
+	{
+		if (m_PhysicsThread && m_PhysicsThread->IsBusy())
+			m_PhysicsCommands.push_back(std::move(func));
+		else
+			func();
+	}
+
 	void Scene::ClearLightingData()
 	{
 		for (int i = 0; i < 16; i++)
@@ -583,6 +879,18 @@ namespace Locus
 		}
 	}
 
+	void Scene::DrawTilemaps()
+	{
+		auto view = m_Registry.view<TransformComponent, TilemapComponent, TagComponent>();
+		for (auto e : view)
+		{
+			Entity entity = Entity(e, this);
+			auto& tilemap = entity.GetComponent<TilemapComponent>();
+			if (entity.GetComponent<TagComponent>().Enabled)
+				Renderer2D::DrawTilemap(GetWorldTransform(entity), tilemap, (int)e);
+		}
+	}
+
 	void Scene::DrawCircles()
 	{
 		auto view = m_Registry.view<TransformComponent, CircleRendererComponent, TagComponent>();
@@ -648,6 +956,10 @@ namespace Locus
 			bodyDef.userData.pointer = (uintptr_t)entity.GetUUID();
 			entityBody = m_Box2DWorld->CreateBody(&bodyDef);
 			rb2D.RuntimeBody = entityBody;
+			rb2D.PreviousPosition = { bodyDef.position.x, bodyDef.position.y };
+			rb2D.PreviousAngle = bodyDef.angle;
+			rb2D.SyncedPosition = rb2D.PreviousPosition;
+			rb2D.SyncedVelocity = { 0.0f, 0.0f };
 			b2MassData massData = {};
 			massData.mass = rb2D.Mass;
 			massData.I = entityBody->GetInertia();
@@ -657,7 +969,9 @@ namespace Locus
 		else
 		{
 			// If entity has a collider but no rigidbody
-			if (entity.HasComponent<BoxCollider2DComponent>() || entity.HasComponent<CircleCollider2DComponent>())
+			bool tilemapCollision = entity.HasComponent<TilemapComponent>() && entity.GetComponent<TilemapComponent>().Collision;
+			if (entity.HasComponent<BoxCollider2DComponent>() || entity.HasComponent<CircleCollider2DComponent>()
+				|| entity.HasComponent<CompoundCollider2DComponent>() || tilemapCollision)
 			{
 				mass = 0.0f;
 
@@ -681,17 +995,18 @@ namespace Locus
 			b2PolygonShape box;
 			box.SetAsBox(size.x / 2, size.y / 2, offset, angle);
 			b2FixtureDef fixtureDef; // Move this to collider
-			fixtureDef.density = mass; // TODO: Calculate mass from body and implement multiple fixtures per body.
+			fixtureDef.density = mass; // TODO: Calculate mass from body.
 			fixtureDef.friction = b2D.Friction;
 			fixtureDef.restitution = b2D.Restitution;
 			fixtureDef.restitutionThreshold = b2D.RestitutionThreshold;
 			fixtureDef.shape = &box;
 			fixtureDef.filter.categoryBits = b2D.CollisionCategory;
-			fixtureDef.filter.maskBits = b2D.CollisionMask;
+			fixtureDef.filter.maskBits = CollisionLayers2D::GetEffectiveMask(b2D.CollisionCategory, b2D.CollisionMask);
+			fixtureDef.userData.pointer = (uintptr_t)(entt::entity)entity;
 			b2Fixture* fixture = entityBody->CreateFixture(&fixtureDef);
 			b2D.RuntimeFixture = fixture;
 		}
-		else if (entity.HasComponent<CircleCollider2DComponent>())
+		if (entity.HasComponent<CircleCollider2DComponent>())
 		{
 			auto& c2D = entity.GetComponent<CircleCollider2DComponent>();
 
@@ -709,10 +1024,107 @@ namespace Locus
 			circle.m_radius = radius;
 			fixtureDef.shape = &circle;
 			fixtureDef.filter.categoryBits = c2D.CollisionCategory;
-			fixtureDef.filter.maskBits = c2D.CollisionMask;
+			fixtureDef.filter.maskBits = CollisionLayers2D::GetEffectiveMask(c2D.CollisionCategory, c2D.CollisionMask);
+			fixtureDef.userData.pointer = (uintptr_t)(entt::entity)entity;
 			b2Fixture* fixture = entityBody->CreateFixture(&fixtureDef);
 			c2D.RuntimeFixture = fixture;
 		}
+
+		if (entity.HasComponent<CompoundCollider2DComponent>())
+			BuildCompoundCollider(entity, entityBody);
+
+		if (entity.HasComponent<TilemapComponent>() && entityBody)
+			BuildTilemapCollider(entity, entityBody);
+
+		if (entityBody)
+			Utils::UpdateBroadphasePresence(entityBody);
+	}
+
+	void Scene::BuildCompoundCollider(Entity entity, b2Body* body)
+	{
+		auto& tc = entity.GetComponent<TransformComponent>();
+		auto& cc2D = entity.GetComponent<CompoundCollider2DComponent>();
+		float mass = entity.HasComponent<Rigidbody2DComponent>() ? entity.GetComponent<Rigidbody2DComponent>().Mass : 0.0f;
+
+		for (void* fixture : cc2D.RuntimeFixtures)
+			body->DestroyFixture((b2Fixture*)fixture);
+		cc2D.RuntimeFixtures.clear();
+
+		for (const ColliderShape2D& shape : cc2D.Shapes)
+		{
+			if (b2Fixture* fixture = Utils::CreateColliderShapeFixture(body, shape, tc.LocalScale, mass, (entt::entity)entity))
+				cc2D.RuntimeFixtures.push_back(fixture);
+		}
+		cc2D.RuntimeBody = body;
+		cc2D.RuntimeHash = Utils::HashCompoundCollider(cc2D, tc.LocalScale, mass);
+	}
+
+	void Scene::BuildTilemapCollider(Entity entity, b2Body* body)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		auto& tilemap = entity.GetComponent<TilemapComponent>();
+		for (auto& [key, fixtures] : tilemap.RuntimeChunkFixtures)
+		{
+			for (void* fixture : fixtures)
+				body->DestroyFixture((b2Fixture*)fixture);
+		}
+		tilemap.RuntimeChunkFixtures.clear();
+		tilemap.RuntimeBody = body;
+		tilemap.RuntimeCollision = tilemap.Collision;
+		tilemap.Map.ClearCollisionDirty();
+		if (!tilemap.Collision)
+			return;
+
+		for (auto& [key, chunk] : tilemap.Map.GetChunks())
+			BuildTilemapChunkCollider(entity, body, key);
+	}
+
+	void Scene::UpdateTilemapCollider(Entity entity, b2Body* body)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		auto& tilemap = entity.GetComponent<TilemapComponent>();
+		if (tilemap.Collision)
+		{
+			for (uint64_t key : tilemap.Map.GetCollisionDirtyChunks())
+				BuildTilemapChunkCollider(entity, body, key);
+		}
+		tilemap.Map.ClearCollisionDirty();
+	}
+
+	void Scene::BuildTilemapChunkCollider(Entity entity, b2Body* body, uint64_t chunkKey)
+	{
+		auto& tc = entity.GetComponent<TransformComponent>();
+		auto& tilemap = entity.GetComponent<TilemapComponent>();
+		float mass = entity.HasComponent<Rigidbody2DComponent>() ? entity.GetComponent<Rigidbody2DComponent>().Mass : 0.0f;
+
+		auto it = tilemap.RuntimeChunkFixtures.find(chunkKey);
+		if (it != tilemap.RuntimeChunkFixtures.end())
+		{
+			for (void* fixture : it->second)
+				body->DestroyFixture((b2Fixture*)fixture);
+			tilemap.RuntimeChunkFixtures.erase(it);
+		}
+
+		std::vector<TileRect> rects;
+		tilemap.Map.MergeSolidTiles(chunkKey, rects);
+		if (rects.empty())
+			return;
+
+		// One box per merged rectangle instead of one per tile.
+		ColliderShape2D shape;
+		shape.Friction = tilemap.Friction;
+		shape.CollisionCategory = tilemap.CollisionCategory;
+		shape.CollisionMask = tilemap.CollisionMask;
+		std::vector<void*>& fixtures = tilemap.RuntimeChunkFixtures[chunkKey];
+		for (const TileRect& rect : rects)
+		{
+			shape.Size = glm::vec2(rect.Width, rect.Height) * tilemap.TileSize;
+			shape.Offset = (glm::vec2(rect.X, rect.Y) + glm::vec2(rect.Width, rect.Height) * 0.5f) * tilemap.TileSize;
+			if (b2Fixture* fixture = Utils::CreateColliderShapeFixture(body, shape, tc.LocalScale, mass, (entt::entity)entity))
+				fixtures.push_back(fixture);
+		}
 	}
 
 	void Scene::UpdatePhysicsData(Entity entity)
@@ -735,6 +1147,17 @@ namespace Locus
 			if (entity.GetComponent<CircleCollider2DComponent>().RuntimeFixture == nullptr)
 				CreatePhysicsData(entity);
 		}
+		if (entity.HasComponent<CompoundCollider2DComponent>())
+		{
+			if (entity.GetComponent<CompoundCollider2DComponent>().RuntimeBody == nullptr)
+				CreatePhysicsData(entity);
+		}
+		if (entity.HasComponent<TilemapComponent>())
+		{
+			auto& tilemap = entity.GetComponent<TilemapComponent>();
+			if (tilemap.RuntimeBody == nullptr && tilemap.Collision)
+				CreatePhysicsData(entity);
+		}
 
 		// Profile performance vs not checking each property for a change.
 		if (entity.HasComponent<Rigidbody2DComponent>())
@@ -778,17 +1201,14 @@ namespace Locus
 			b2Fixture* runtimeFixture = (b2Fixture*)b2D.RuntimeFixture;
 			b2PolygonShape* shape = (b2PolygonShape*)runtimeFixture->GetShape();
 
-			// TODO: Collision jittery when changed during runtime
-			shape->SetAsBox(size.x / 2, size.y / 2, offset, angle);
-			// Check if shape is changed
-			/*b2PolygonShape thisShape;
+			// Only rebuild the box if it changed. Rebuilding every sync made contacts jitter.
+			b2PolygonShape thisShape;
 			thisShape.SetAsBox(size.x / 2, size.y / 2, offset, angle);
 			if (thisShape.m_vertices[0] != shape->m_vertices[0] || thisShape.m_vertices[1] != shape->m_vertices[1]
 				|| thisShape.m_vertices[2] != shape->m_vertices[2] || thisShape.m_vertices[3] != shape->m_vertices[3])
 			{
-				for (int i = 0; i < 4; i++)
-					shape->m_vertices[i] = thisShape.m_vertices[i];
-			}*/
+				*shape = thisShape;
+			}
 			if (runtimeFixture->GetDensity() != mass)
 				runtimeFixture->SetDensity(mass);
 			if (runtimeFixture->GetFriction() != b2D.Friction)
@@ -797,12 +1217,14 @@ namespace Locus
 				runtimeFixture->SetRestitution(b2D.Restitution);
 			if (runtimeFixture->GetRestitutionThreshold() != b2D.RestitutionThreshold)
 				runtimeFixture->SetRestitutionThreshold(b2D.RestitutionThreshold);
-			if (runtimeFixture->GetFilterData().categoryBits != b2D.CollisionCategory || runtimeFixture->GetFilterData().maskBits != b2D.CollisionMask)
+			uint16_t maskBits = CollisionLayers2D::GetEffectiveMask(b2D.CollisionCategory, b2D.CollisionMask);
+			if (runtimeFixture->GetFilterData().categoryBits != b2D.CollisionCategory || runtimeFixture->GetFilterData().maskBits != maskBits)
 			{
 				b2Filter filter;
 				filter.categoryBits = b2D.CollisionCategory;
-				filter.maskBits = b2D.CollisionMask;
+				filter.maskBits = maskBits;
 				runtimeFixture->SetFilterData(filter);
+				Utils::UpdateBroadphasePresence(runtimeFixture->GetBody());
 			}
 		}
 
@@ -830,14 +1252,75 @@ namespace Locus
 				runtimeFixture->SetRestitution(c2D.Restitution);
 			if (runtimeFixture->GetRestitutionThreshold() != c2D.RestitutionThreshold)
 				runtimeFixture->SetRestitutionThreshold(c2D.RestitutionThreshold);
-			if (runtimeFixture->GetFilterData().categoryBits != c2D.CollisionCategory || runtimeFixture->GetFilterData().maskBits != c2D.CollisionMask)
+			uint16_t maskBits = CollisionLayers2D::GetEffectiveMask(c2D.CollisionCategory, c2D.CollisionMask);
+			if (runtimeFixture->GetFilterData().categoryBits != c2D.CollisionCategory || runtimeFixture->GetFilterData().maskBits != maskBits)
 			{
 				b2Filter filter;
 				filter.categoryBits = c2D.CollisionCategory;
-				filter.maskBits = c2D.CollisionMask;
+				filter.maskBits = maskBits;
 				runtimeFixture->SetFilterData(filter);
+				Utils::UpdateBroadphasePresence(runtimeFixture->GetBody());
+			}
+		}
+
+		if (entity.HasComponent<CompoundCollider2DComponent>())
+		{
+			// Shapes can be added, removed or retyped, so the fixtures are rebuilt instead of patched.
+			auto& cc2D = entity.GetComponent<CompoundCollider2DComponent>();
+			float mass = entity.HasComponent<Rigidbody2DComponent>() ? entity.GetComponent<Rigidbody2DComponent>().Mass : 0.0f;
+			if (cc2D.RuntimeHash != Utils::HashCompoundCollider(cc2D, tc.LocalScale, mass))
+			{
+				b2Body* body = (b2Body*)cc2D.RuntimeBody;
+				BuildCompoundCollider(entity, body);
+				Utils::UpdateBroadphasePresence(body);
 			}
 		}
+
+		if (entity.HasComponent<TilemapComponent>())
+		{
+			auto& tilemap = entity.GetComponent<TilemapComponent>();
+			if (tilemap.RuntimeBody)
+			{
+				b2Body* body = (b2Body*)tilemap.RuntimeBody;
+				if (tilemap.Map.IsCollisionDirty() || tilemap.Collision != tilemap.RuntimeCollision)
+				{
+					BuildTilemapCollider(entity, body);
+					Utils::UpdateBroadphasePresence(body);
+				}
+				else if (!tilemap.Map.GetCollisionDirtyChunks().empty())
+				{
+					UpdateTilemapCollider(entity, body);
+					Utils::UpdateBroadphasePresence(body);
+				}
+			}
+		}
+	}
+
+	void Scene::MarkPhysicsDirty(Entity entity)
+	{
+		// Nothing to sync while the simulation isn't running. Physics data is created on start.
+		if (!m_Box2DWorld)
+			return;
+		m_DirtyPhysicsEntities.insert((entt::entity)entity);
+	}
+
+	void Scene::SyncPhysicsData()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		for (auto e : m_DirtyPhysicsEntities)
+		{
+			// Entities can be destroyed or disabled after they were marked. Enabling marks them again.
+			if (!m_Registry.valid(e) || !m_Registry.get<TagComponent>(e).Enabled)
+				continue;
+			UpdatePhysicsData(Entity(e, this));
+		}
+		m_DirtyPhysicsEntities.clear();
+	}
+
+	void Scene::OnPhysicsComponentChanged(entt::registry& registry, entt::entity entity)
+	{
+		MarkPhysicsDirty(Entity(entity, this));
 	}
 
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
@@ -870,11 +1353,80 @@ namespace Locus
 
 	Entity Scene::GetEntityByUUID(UUID uuid)
 	{
-		if (m_Entities.find(uuid) != m_Entities.end())
-			return m_Entities[uuid];
+		auto it = m_Entities.find(uuid);
+		if (it != m_Entities.end())
+			return it->second;
 		return Entity::Null;
 	}
 
+	Entity Scene::GetEntityByHandle(entt::entity handle, UUID uuid)
+	{
+		// valid() compares the version so a destroyed handle is rejected even after its index is recycled.
+		if (m_Registry.valid(handle) && m_Registry.get<IDComponent>(handle).ID == uuid)
+			return Entity(handle, this);
+		return GetEntityByUUID(uuid);
+	}
+
+	void Scene::SetEntityTag(Entity entity, const std::string& tag)
+	{
+		m_Registry.patch<TagComponent>(entity, [&tag](TagComponent& tc) { tc.Tag = tag; });
+	}
+
+	void Scene::SetEntityGroup(Entity entity, const std::string& group)
+	{
+		m_Registry.patch<TagComponent>(entity, [&group](TagComponent& tc) { tc.Group = group; });
+	}
+
+	void Scene::SetEntityEnabled(Entity entity, bool enabled)
+	{
+		m_Registry.patch<TagComponent>(entity, [enabled](TagComponent& tc) { tc.Enabled = enabled; });
+	}
+
+	const std::set<entt::entity>& Scene::GetEntitiesWithTag(const std::string& tag) const
+	{
+		static const std::set<entt::entity> s_Empty;
+		auto it = m_TagIndex.find(tag);
+		return it != m_TagIndex.end() ? it->second : s_Empty;
+	}
+
+	const std::set<entt::entity>& Scene::GetEntitiesInGroup(const std::string& group) const
+	{
+		static const std::set<entt::entity> s_Empty;
+		auto it = m_GroupIndex.find(group);
+		return it != m_GroupIndex.end() ? it->second : s_Empty;
+	}
+
+	void Scene::OnTagComponentChanged(entt::registry& registry, entt::entity entity)
+	{
+		OnTagComponentDestroyed(registry, entity);
+
+		auto& tc = registry.get<TagComponent>(entity);
+		m_TagIndex[tc.Tag].insert(entity);
+		m_GroupIndex[tc.Group].insert(entity);
+		m_IndexedTags[entity] = { tc.Tag, tc.Group };
+	}
+
+	void Scene::OnTagComponentDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto it = m_IndexedTags.find(entity);
+		if (it == m_IndexedTags.end())
+			return;
+
+		// Empty buckets are erased so renamed tags don't accumulate.
+		auto removeFromBucket = [entity](auto& index, const std::string& key)
+		{
+			auto bucket = index.find(key);
+			if (bucket == index.end())
+				return;
+			bucket->second.erase(entity);
+			if (bucket->second.empty())
+				index.erase(bucket);
+		};
+		removeFromBucket(m_TagIndex, it->second.first);
+		removeFromBucket(m_GroupIndex, it->second.second);
+		m_IndexedTags.erase(it);
+	}
+
 	glm::mat4 Scene::GetWorldTransform(Entity entity)
 	{
 		glm::mat4 transform(1.0f);
@@ -928,6 +1480,12 @@ namespace Locus
 
 	}
 
+	template<>
+	void Scene::OnComponentAdded<TilemapComponent>(Entity entity, TilemapComponent& component)
+	{
+
+	}
+
 	template<>
 	void Scene::OnComponentAdded<CubeRendererComponent>(Entity entity, CubeRendererComponent& component)
 	{
@@ -983,6 +1541,12 @@ namespace Locus
 
 	}
 
+	template<>
+	void Scene::OnComponentAdded<CompoundCollider2DComponent>(Entity entity, CompoundCollider2DComponent& component)
+	{
+
+	}
+
 	template<>
 	void Scene::OnComponentAdded<ScriptComponent>(Entity entity, ScriptComponent& component)
 	{
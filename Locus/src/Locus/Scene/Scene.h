@@ -2,6 +2,8 @@
 // Scene class.
 #pragma once
 
+#include <set>
+
 #include <entt.hpp>
 
 #include "Locus/Core/Timestep.h"
@@ -9,13 +11,19 @@
 #include "Locus/Renderer/EditorCamera.h"
 #include "Locus/Renderer/Model.h"
 #include "Locus/Renderer/Material.h"
+#include "Locus/Physics2D/PhysicsThread2D.h"
+#include "Locus/Physics2D/PhysicsQuery2D.h"
+#include "Locus/Physics2D/CollisionLayers2D.h"
+#include "Locus/Physics2D/PhysicsProfiler2D.h"
 
 class b2World;
+class b2Body;
 
 namespace Locus
 {
 	class Entity;
 	class ContactListener2D;
+	class CollisionFilter2D;
 
 	struct PointLight
 	{
@@ -54,11 +62,44 @@ namespace Locus
 		SpotLight SpotLights[16];
 	};
 
+	// Fixed timestep settings for the 2D physics world.
+	struct Physics2DSettings
+	{
+		float FixedTimestep = 1.0f / 60.0f;
+		int32_t VelocityIterations = 6;
+		int32_t PositionIterations = 2;
+		// Upper bound on steps per frame so a hitch doesn't snowball into ever longer frames.
+		uint32_t MaxSubsteps = 8;
+		// Render bodies between the previous and current physics state.
+		bool Interpolate = true;
+		// Step the world on a worker thread, one frame ahead of rendering. Scripts see physics state as of
+		// the last sync point and their writes are applied at the next one. Takes effect on the next start.
+		bool Threaded = false;
+
+		static constexpr float MinFixedTimestep = 1.0f / 1000.0f;
+
+		// Clamps values the fixed step loop can't run with. Returns true if anything changed.
+		bool Clamp()
+		{
+			Physics2DSettings clamped = *this;
+			if (!(clamped.FixedTimestep >= MinFixedTimestep))
+				clamped.FixedTimestep = MinFixedTimestep;
+			clamped.VelocityIterations = std::max(clamped.VelocityIterations, 1);
+			clamped.PositionIterations = std::max(clamped.PositionIterations, 1);
+			clamped.MaxSubsteps = std::max(clamped.MaxSubsteps, 1u);
+
+			bool changed = clamped.FixedTimestep != FixedTimestep || clamped.VelocityIterations != VelocityIterations
+				|| clamped.PositionIterations != PositionIterations || clamped.MaxSubsteps != MaxSubsteps;
+			*this = clamped;
+			return changed;
+		}
+	};
+
 	class Scene
 	{
 	public:
 		Scene();
-		Scene(const std::string& sceneName) : m_SceneName(sceneName) {}
+		Scene(const std::string& sceneName) : Scene() { m_SceneName = sceneName; }
 		~Scene() = default;
 
 		// Creates an entity with a new UUID.
@@ -97,11 +138,49 @@ namespace Locus
 		void CreatePhysicsData(Entity entity);
 		// Update physics data during runtime.
 		void UpdatePhysicsData(Entity entity);
+		// Queues an entity whose physics components or scale changed. Only queued entities are synced to Box2D.
+		void MarkPhysicsDirty(Entity entity);
+		// Applies UpdatePhysicsData() to every queued entity.
+		void SyncPhysicsData();
+		// Runs func against the Box2D world now, or at the next sync point if the world is stepping on the physics thread.
+		void SubmitPhysicsCommand(std::function<void()> func);
+		bool IsPhysicsThreaded() const { return m_PhysicsThread != nullptr; }
+		// Broadphase pairs per layer combination over the last frame that stepped.
+		const CollisionPairStats2D& GetCollisionPairStats() const { return m_CollisionPairStats; }
+		// Box2D profile and world counts of the last frame that stepped.
+		const PhysicsStats2D& GetPhysicsStats() const { return m_PhysicsStats; }
+		// Body, contact and island counts in the physics stats are only gathered while enabled.
+		void SetPhysicsWorldStatsEnabled(bool enabled) { m_PhysicsProfiler.SetCaptureEnabled(enabled); }
+
+		// --- Physics queries ---
+		// Broadphase queries against the running Box2D world. Fixtures are skipped unless their collision
+		//	category is in mask. Queries return nothing while the simulation isn't running and wait for a
+		//	step in progress on the physics thread.
+		bool Raycast2D(const glm::vec2& origin, const glm::vec2& direction, float distance, RaycastHit2D& outHit, uint16_t mask = 0xFFFF);
+		// Writes up to maxHits hits sorted by distance and returns the number written.
+		uint32_t RaycastAll2D(const glm::vec2& origin, const glm::vec2& direction, float distance, RaycastHit2D* outHits, uint32_t maxHits, uint16_t mask = 0xFFFF);
+		// Overlap queries write up to maxCount entity UUIDs and return the number written.
+		uint32_t OverlapAABB2D(const glm::vec2& min, const glm::vec2& max, UUID* outEntities, uint32_t maxCount, uint16_t mask = 0xFFFF);
+		uint32_t OverlapCircle2D(const glm::vec2& center, float radius, UUID* outEntities, uint32_t maxCount, uint16_t mask = 0xFFFF);
+		uint32_t OverlapBox2D(const glm::vec2& center, const glm::vec2& size, float angle, UUID* outEntities, uint32_t maxCount, uint16_t mask = 0xFFFF);
 
 		void OnViewportResize(uint32_t width, uint32_t height);
 
 		Entity GetPrimaryCameraEntity();
 		Entity GetEntityByUUID(UUID uuid);
+		// Resolves a handle cached by a script in O(1). Falls back to the UUID if the handle was destroyed or reused.
+		Entity GetEntityByHandle(entt::entity handle, UUID uuid);
+
+		// --- Tag index ---
+		// Tags and groups are indexed through TagComponent signals. Every write goes through
+		//	SetEntityTag()/SetEntityGroup() or replaces the component, so the index is notified.
+		void SetEntityTag(Entity entity, const std::string& tag);
+		void SetEntityGroup(Entity entity, const std::string& group);
+		// Goes through the registry so physics data of an entity disabled on start is created.
+		void SetEntityEnabled(Entity entity, bool enabled);
+		// Buckets are ordered by handle, so lookups give the same result for the same scene.
+		const std::set<entt::entity>& GetEntitiesWithTag(const std::string& tag) const;
+		const std::set<entt::entity>& GetEntitiesInGroup(const std::string& group) const;
 		const std::string& GetSceneName() const { return m_SceneName; }
 
 		template<typename... T>
@@ -114,14 +193,29 @@ namespace Locus
 
 		const SceneLighting& GetLightingData() const { return m_SceneLighting; }
 
+		Physics2DSettings& GetPhysics2DSettings() { return m_Physics2DSettings; }
+
 		void SetSceneName(const std::string& name) { m_SceneName = name; }
 
 	private:
 
+		// Advances the physics world in fixed steps, writes body poses back to transforms and dispatches contacts.
+		void StepPhysics(Timestep deltaTime);
+		// Pipelined StepPhysics(). Waits for the previous step, applies queued commands, kicks the next step
+		//	and writes back the previous step's poses while it runs.
+		void StepPhysicsThreaded(Timestep deltaTime);
+		// Steps the world and records the poses of non static bodies. Runs on the physics thread, so it must
+		//	not touch the registry.
+		void StepPhysicsWorld(float deltaTime, const Physics2DSettings& settings, PhysicsPoseBuffer2D& output);
+		void StartPhysicsThread();
+		// Returns the world once it's safe to read from the main thread, or nullptr if there is none.
+		b2World* GetQueryWorld();
+
 		void ClearLightingData();
 		void ProcessPointLights();
 		void ProcessDirectionalLights();
 		void ProcessSpotLights();
+		void DrawTilemaps();
 		void DrawSprites();
 		void DrawCircles();
 		void DrawCubes();
@@ -129,14 +223,47 @@ namespace Locus
 
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
+
+		// Registry signal for added or replaced physics components.
+		void OnPhysicsComponentChanged(entt::registry& registry, entt::entity entity);
+		// Registry signals that keep the tag and group index up to date.
+		void OnTagComponentChanged(entt::registry& registry, entt::entity entity);
+		void OnTagComponentDestroyed(entt::registry& registry, entt::entity entity);
+		// Destroys the compound collider's fixtures and creates them again on body.
+		void BuildCompoundCollider(Entity entity, b2Body* body);
+		// Replaces the tilemap's fixtures with boxes merged from its solid tiles.
+		void BuildTilemapCollider(Entity entity, b2Body* body);
+		// Rebuilds the fixtures of the chunks edited since the last build.
+		void UpdateTilemapCollider(Entity entity, b2Body* body);
+		// Destroys one chunk's fixtures and creates them again from its solid tiles.
+		void BuildTilemapChunkCollider(Entity entity, b2Body* body, uint64_t chunkKey);
 	private:
 		std::string m_SceneName = "Untitled";
+		// Tag and group index. m_IndexedTags holds the keys each entity is currently filed under.
+		// Declared before the registry so they outlive its destroy signals.
+		std::unordered_map<std::string, std::set<entt::entity>> m_TagIndex;
+		std::unordered_map<std::string, std::set<entt::entity>> m_GroupIndex;
+		std::unordered_map<entt::entity, std::pair<std::string, std::string>> m_IndexedTags;
 		entt::registry m_Registry;
 		std::unordered_map<UUID, Entity> m_Entities;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
 		b2World* m_Box2DWorld = nullptr;
 		Ref<ContactListener2D> m_ContactListener;
+		Ref<CollisionFilter2D> m_CollisionFilter;
+		CollisionPairStats2D m_CollisionPairStats = {};
+		PhysicsProfiler2D m_PhysicsProfiler;
+		PhysicsStats2D m_PhysicsStats;
+		Physics2DSettings m_Physics2DSettings;
+		float m_PhysicsAccumulator = 0.0f;
+		std::unordered_set<entt::entity> m_DirtyPhysicsEntities;
+		// Threaded physics. The main thread reads m_PoseBuffers[m_PoseReadIndex] while the physics thread fills the other.
+		Scope<PhysicsThread2D> m_PhysicsThread;
+		PhysicsPoseBuffer2D m_PoseBuffers[2];
+		uint32_t m_PoseReadIndex = 0;
+		std::vector<std::function<void()>> m_PhysicsCommands;
+		// Reused by RaycastAll2D() to sort hits.
+		std::vector<RaycastHit2D> m_RaycastHits;
 
 		// Lighting
 		SceneLighting m_SceneLighting;
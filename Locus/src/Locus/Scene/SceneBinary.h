@@ -0,0 +1,199 @@
+// --- SceneBinary ------------------------------------------------------------
+// Binary scene format (.locusb). YAML (.locus) stays the source control
+//	format, binary is for fast loading of large levels.
+// Layout:
+//	SceneBinaryHeader
+//	Scene name, Physics2DSettings
+//	UUID of every entity
+//	One SceneBinaryTable per component type. A table lists the entity index
+//	of every component followed by the components' data.
+// Tables are read with a bounds checked reader straight from the memory
+//	mapped file. Every count is checked against the bytes left before it is
+//	allocated, and nothing is added to the scene until the whole file has
+//	validated. Unknown tables are skipped, so new component types don't
+//	break older readers. Bump the version when an existing table changes.
+#pragma once
+
+namespace Locus
+{
+	static constexpr char s_SceneBinaryMagic[4] = { 'L', 'S', 'C', 'N' };
+	// Version 1 used ComponentType values as table IDs.
+	static constexpr uint32_t s_SceneBinaryVersion = 2;
+
+	constexpr uint32_t SceneBinaryFourCC(char a, char b, char c, char d)
+	{
+		return (uint32_t)(uint8_t)a | (uint32_t)(uint8_t)b << 8 | (uint32_t)(uint8_t)c << 16 | (uint32_t)(uint8_t)d << 24;
+	}
+
+	// Table IDs are part of the format. They never change when components are added or reordered.
+	namespace SceneBinaryTableID
+	{
+		static constexpr uint32_t Tag                = SceneBinaryFourCC('T', 'A', 'G', ' ');
+		static constexpr uint32_t Transform          = SceneBinaryFourCC('X', 'F', 'R', 'M');
+		static constexpr uint32_t Child              = SceneBinaryFourCC('C', 'H', 'L', 'D');
+		static constexpr uint32_t SpriteRenderer     = SceneBinaryFourCC('S', 'P', 'R', 'T');
+		static constexpr uint32_t CircleRenderer     = SceneBinaryFourCC('C', 'I', 'R', 'C');
+		static constexpr uint32_t Tilemap            = SceneBinaryFourCC('T', 'M', 'A', 'P');
+		static constexpr uint32_t CubeRenderer       = SceneBinaryFourCC('C', 'U', 'B', 'E');
+		static constexpr uint32_t MeshRenderer       = SceneBinaryFourCC('M', 'E', 'S', 'H');
+		static constexpr uint32_t PointLight         = SceneBinaryFourCC('P', 'L', 'G', 'T');
+		static constexpr uint32_t DirectionalLight   = SceneBinaryFourCC('D', 'L', 'G', 'T');
+		static constexpr uint32_t SpotLight          = SceneBinaryFourCC('S', 'L', 'G', 'T');
+		static constexpr uint32_t Camera             = SceneBinaryFourCC('C', 'A', 'M', 'R');
+		static constexpr uint32_t Rigidbody2D        = SceneBinaryFourCC('R', 'B', '2', 'D');
+		static constexpr uint32_t BoxCollider2D      = SceneBinaryFourCC('B', 'X', '2', 'D');
+		static constexpr uint32_t CircleCollider2D   = SceneBinaryFourCC('C', 'C', '2', 'D');
+		static constexpr uint32_t CompoundCollider2D = SceneBinaryFourCC('C', 'P', '2', 'D');
+		static constexpr uint32_t Script             = SceneBinaryFourCC('S', 'C', 'R', 'P');
+	}
+
+	struct SceneBinaryHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t EntityCount;
+		uint32_t TableCount;
+	};
+
+	struct SceneBinaryTable
+	{
+		// SceneBinaryTableID
+		uint32_t Type;
+		uint32_t Count;
+		// Bytes after this struct. Used to skip unknown tables.
+		uint64_t Size;
+	};
+
+	class SceneBinaryWriter
+	{
+	public:
+		template<typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Use a specific overload for this type!");
+			WriteBytes(&value, sizeof(T));
+		}
+
+		void WriteString(const std::string& str)
+		{
+			Write((uint32_t)str.size());
+			WriteBytes(str.data(), str.size());
+		}
+
+		void WriteBytes(const void* data, size_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+		}
+
+		const std::vector<uint8_t>& GetBuffer() const { return m_Buffer; }
+		size_t GetSize() const { return m_Buffer.size(); }
+		void Clear() { m_Buffer.clear(); }
+
+	private:
+		std::vector<uint8_t> m_Buffer;
+	};
+
+	// Reads from memory it doesn't own. Reading past the end sets the error flag and returns zeros,
+	//	so a truncated file is detected once instead of checking every read.
+	class SceneBinaryReader
+	{
+	public:
+		SceneBinaryReader(const uint8_t* data, uint64_t size)
+			: m_Data(data), m_Size(size)
+		{
+		}
+
+		template<typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Use a specific overload for this type!");
+			T value;
+			ReadBytes(&value, sizeof(T));
+			return value;
+		}
+
+		std::string ReadString()
+		{
+			uint32_t size = Read<uint32_t>();
+			if (!CanRead(size))
+				return std::string();
+			std::string str((const char*)m_Data + m_Position, size);
+			m_Position += size;
+			return str;
+		}
+
+		void ReadBytes(void* data, size_t size)
+		{
+			if (!CanRead(size))
+			{
+				memset(data, 0, size);
+				return;
+			}
+			memcpy(data, m_Data + m_Position, size);
+			m_Position += size;
+		}
+
+		void Skip(uint64_t size)
+		{
+			if (CanRead(size))
+				m_Position += size;
+		}
+
+		// Reads an element count and checks that that many elements of at least elementSize bytes
+		//	fit in the rest of the data, so a corrupt count can't cause a huge allocation. Returns 0 on error.
+		uint32_t ReadCount(uint64_t elementSize)
+		{
+			uint32_t count = Read<uint32_t>();
+			return CanReadArray(count, elementSize) ? count : 0;
+		}
+
+		bool CanReadArray(uint64_t count, uint64_t elementSize)
+		{
+			if (m_Error || (elementSize > 0 && count > (m_Size - m_Position) / elementSize))
+			{
+				m_Error = true;
+				return false;
+			}
+			return true;
+		}
+
+		// Returns a reader over the next size bytes and moves past them. Reads through it can't
+		//	run into the data that follows.
+		SceneBinaryReader ReadBlock(uint64_t size)
+		{
+			if (!CanRead(size))
+			{
+				SceneBinaryReader block(nullptr, 0);
+				block.SetError();
+				return block;
+			}
+			SceneBinaryReader block(m_Data + m_Position, size);
+			m_Position += size;
+			return block;
+		}
+
+		uint64_t GetPosition() const { return m_Position; }
+		uint64_t GetRemaining() const { return m_Size - m_Position; }
+		bool HasError() const { return m_Error; }
+		// For data that was read fine but is invalid, eg. an out of range entity index.
+		void SetError() { m_Error = true; }
+
+	private:
+		bool CanRead(uint64_t size)
+		{
+			if (m_Error || size > m_Size - m_Position)
+			{
+				m_Error = true;
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		const uint8_t* m_Data;
+		uint64_t m_Size;
+		uint64_t m_Position = 0;
+		bool m_Error = false;
+	};
+}
@@ -1,14 +1,20 @@
 #include "Lpch.h"
 #include "SceneSerializer.h"
 
+#include <deque>
 #include <fstream>
+#include <future>
 
 #define YAML_CPP_STATIC_DEFINE
 #include <yaml-cpp/yaml.h>
+#include <yaml-cpp/eventhandler.h>
 
+#include "Locus/Core/Timer.h"
 #include "Locus/Scene/Entity.h"
 #include "Locus/Scene/Components.h"
+#include "Locus/Scene/SceneStaging.h"
 #include "Locus/Scripting/ScriptEngine.h"
+#include "Locus/Utils/PlatformUtils.h"
 
 // Needed to decode and encode custom datatypes using YAML
 namespace YAML {
@@ -149,6 +155,185 @@ namespace Locus
 		return out;
 	}
 
+	// Builds nodes from parser events instead of loading the whole document. The top level keys
+	//	are collected into a small header node. Each entry of "Entities" is handed out as soon as it
+	//	is complete and then released, so memory stays at about one entity no matter the scene size.
+	class SceneStreamHandler : public YAML::EventHandler
+	{
+	public:
+		using HeaderFn = std::function<bool(const YAML::Node&)>;
+		using EntityFn = std::function<void(YAML::Node&)>;
+
+		SceneStreamHandler(const HeaderFn& onHeader, const EntityFn& onEntity)
+			: m_OnHeader(onHeader), m_OnEntity(onEntity)
+		{
+		}
+
+		virtual void OnDocumentStart(const YAML::Mark& mark) override {}
+		virtual void OnDocumentEnd() override
+		{
+			// Scenes without entities.
+			if (!m_HeaderHandled && m_Header)
+				m_OnHeader(m_Header);
+		}
+
+		virtual void OnNull(const YAML::Mark& mark, YAML::anchor_t anchor) override { AddValue(YAML::Node(YAML::NodeType::Null)); }
+		// Scenes don't use anchors.
+		virtual void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override { AddValue(YAML::Node(YAML::NodeType::Null)); }
+		virtual void OnScalar(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override
+		{
+			Frame* frame = m_Stack.empty() ? nullptr : &m_Stack.back();
+			if (frame && frame->Type == FrameType::Map && !frame->HasKey)
+			{
+				frame->Key = value;
+				frame->HasKey = true;
+				return;
+			}
+			AddValue(YAML::Node(value));
+		}
+
+		virtual void OnSequenceStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value style) override
+		{
+			// The root "Entities" sequence is never built, its entries are passed on one by one.
+			if (m_Stack.size() == 1 && m_Stack.back().HasKey && m_Stack.back().Key == "Entities")
+			{
+				m_HeaderHandled = true;
+				m_Skip = !m_OnHeader(m_Stack.back().Node);
+				m_Stack.push_back({ FrameType::Entities });
+				return;
+			}
+			m_Stack.push_back({ FrameType::Sequence, YAML::Node(YAML::NodeType::Sequence) });
+			m_Stack.back().Node.SetStyle(style);
+		}
+
+		virtual void OnSequenceEnd() override { EndFrame(); }
+
+		virtual void OnMapStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value style) override
+		{
+			m_Stack.push_back({ FrameType::Map, YAML::Node(YAML::NodeType::Map) });
+			m_Stack.back().Node.SetStyle(style);
+		}
+
+		virtual void OnMapEnd() override { EndFrame(); }
+
+	private:
+		enum class FrameType { Map, Sequence, Entities };
+
+		struct Frame
+		{
+			FrameType Type;
+			YAML::Node Node;
+			std::string Key;
+			bool HasKey = false;
+		};
+
+		void EndFrame()
+		{
+			Frame frame = std::move(m_Stack.back());
+			m_Stack.pop_back();
+			if (frame.Type == FrameType::Entities)
+			{
+				// The key belonged to the sequence. Don't add it to the header.
+				m_Stack.back().HasKey = false;
+				return;
+			}
+			AddValue(frame.Node);
+		}
+
+		void AddValue(YAML::Node value)
+		{
+			if (m_Stack.empty())
+			{
+				m_Header = value;
+				return;
+			}
+
+			Frame& frame = m_Stack.back();
+			switch (frame.Type)
+			{
+			case FrameType::Map:
+				frame.Node[frame.Key] = value;
+				frame.HasKey = false;
+				break;
+			case FrameType::Sequence:
+				frame.Node.push_back(value);
+				break;
+			case FrameType::Entities:
+				if (!m_Skip)
+					m_OnEntity(value);
+				break;
+			}
+		}
+
+	private:
+		HeaderFn m_OnHeader;
+		EntityFn m_OnEntity;
+		std::vector<Frame> m_Stack;
+		YAML::Node m_Header;
+		bool m_HeaderHandled = false;
+		bool m_Skip = false;
+	};
+
+	// Streamed scenes are added to the registry every this many entities.
+	static constexpr uint32_t s_StreamBatchSize = 1024;
+	// Smallest part of a file worth decoding on its own thread.
+	static constexpr uint64_t s_MinChunkSize = 64 * 1024;
+	// Largest part of a file decoded as one piece, so large scenes are split into many chunks.
+	static constexpr uint64_t s_MaxChunkSize = 1024 * 1024;
+	// Text of the chunks being decoded or waiting to be inserted. Their YAML trees and staged
+	//	components are several times larger, so this bounds the memory used by a large scene.
+	static constexpr uint64_t s_MaxBytesInFlight = 16 * 1024 * 1024;
+
+	namespace Utils
+	{
+		// Splits the "Entities" sequence of a scene written by Serialize() into about chunkCount
+		//	pieces at entity boundaries. The rest of the file goes to header. Returns false for any
+		//	other layout.
+		static bool SplitSceneEntities(std::string_view text, uint32_t chunkCount, std::string& header, std::vector<std::string_view>& chunks)
+		{
+			constexpr std::string_view entitiesKey = "\nEntities:";
+			constexpr std::string_view entityStart = "\n  - Entity:";
+
+			size_t keyPos = text.find(entitiesKey);
+			if (keyPos == std::string_view::npos)
+				return false;
+			// The first entity must start on the line after the key.
+			size_t first = text.find(entityStart, keyPos + 1);
+			if (first == std::string_view::npos || first != text.find('\n', keyPos + 1))
+				return false;
+			first++;
+
+			// The sequence ends at the next line that isn't indented.
+			size_t end = first;
+			while (true)
+			{
+				end = text.find('\n', end);
+				if (end == std::string_view::npos)
+				{
+					end = text.size();
+					break;
+				}
+				end++;
+				if (end < text.size() && text[end] != ' ' && text[end] != '\r' && text[end] != '\n')
+					break;
+			}
+
+			header = std::string(text.substr(0, keyPos + 1));
+			header += text.substr(end);
+
+			size_t chunkSize = (end - first) / chunkCount + 1;
+			size_t start = first;
+			while (start < end)
+			{
+				size_t split = text.find(entityStart, start + chunkSize);
+				split = split < end ? split + 1 : end;
+				chunks.push_back(text.substr(start, split - start));
+				start = split;
+			}
+			return true;
+		}
+	}
+
 	SceneSerializer::SceneSerializer(const Ref<Scene>& scene)
 		: m_Scene(scene)
 	{
@@ -237,6 +422,39 @@ namespace Locus
 			out << YAML::EndMap;
 		}
 
+		// --- Tilemap Component ---
+		if (entity.HasComponent<TilemapComponent>())
+		{
+			auto& tmc = entity.GetComponent<TilemapComponent>();
+
+			out << YAML::Key << "TilemapComponent";
+			out << YAML::BeginMap; // Tilemap Component
+			out << YAML::Key << "Tileset" << YAML::Value << (std::string)tmc.Tileset;
+			out << YAML::Key << "TilesetColumns" << YAML::Value << tmc.TilesetSize.x;
+			out << YAML::Key << "TilesetRows" << YAML::Value << tmc.TilesetSize.y;
+			out << YAML::Key << "TileSize" << YAML::Value << tmc.TileSize;
+			out << YAML::Key << "Color" << YAML::Value << tmc.Color;
+			out << YAML::Key << "Collision" << YAML::Value << tmc.Collision;
+			out << YAML::Key << "Friction" << YAML::Value << tmc.Friction;
+			out << YAML::Key << "CollisionCategory" << YAML::Value << tmc.CollisionCategory;
+			out << YAML::Key << "CollisionMask" << YAML::Value << tmc.CollisionMask;
+			out << YAML::Key << "Chunks" << YAML::Value << YAML::BeginSeq;
+			for (auto& [key, chunk] : tmc.Map.GetChunks())
+			{
+				glm::ivec2 coord = Tilemap::GetChunkCoord(key);
+				out << YAML::BeginMap; // Chunk
+				out << YAML::Key << "X" << YAML::Value << coord.x;
+				out << YAML::Key << "Y" << YAML::Value << coord.y;
+				out << YAML::Key << "Tiles" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+				for (uint16_t tile : chunk.Tiles)
+					out << tile;
+				out << YAML::EndSeq;
+				out << YAML::EndMap; // Chunk
+			}
+			out << YAML::EndSeq;
+			out << YAML::EndMap; // End Tilemap Component
+		}
+
 		// --- Cube Renderer Component ---
 		if (entity.HasComponent<CubeRendererComponent>())
 		{
@@ -373,6 +591,37 @@ namespace Locus
 			out << YAML::EndMap; // BoxCollider2D Component
 		}
 
+		// --- CompoundCollider2D Component ---
+		if (entity.HasComponent<CompoundCollider2DComponent>())
+		{
+			auto& cc2D = entity.GetComponent<CompoundCollider2DComponent>();
+
+			out << YAML::Key << "CompoundCollider2DComponent";
+			out << YAML::BeginMap; // CompoundCollider2D Component
+			out << YAML::Key << "Shapes" << YAML::Value << YAML::BeginSeq;
+			for (auto& shape : cc2D.Shapes)
+			{
+				out << YAML::BeginMap; // Shape
+				out << YAML::Key << "Type" << YAML::Value << (int)shape.Type;
+				out << YAML::Key << "Friction" << YAML::Value << shape.Friction;
+				out << YAML::Key << "Restitution" << YAML::Value << shape.Restitution;
+				out << YAML::Key << "RestitutionThreshold" << YAML::Value << shape.RestitutionThreshold;
+				out << YAML::Key << "CollisionCategory" << YAML::Value << shape.CollisionCategory;
+				out << YAML::Key << "CollisionMask" << YAML::Value << shape.CollisionMask;
+				out << YAML::Key << "Offset" << YAML::Value << shape.Offset;
+				out << YAML::Key << "Size" << YAML::Value << shape.Size;
+				out << YAML::Key << "Radius" << YAML::Value << shape.Radius;
+				out << YAML::Key << "Loop" << YAML::Value << shape.Loop;
+				out << YAML::Key << "Vertices" << YAML::Value << YAML::BeginSeq;
+				for (auto& vertex : shape.Vertices)
+					out << vertex;
+				out << YAML::EndSeq;
+				out << YAML::EndMap; // Shape
+			}
+			out << YAML::EndSeq;
+			out << YAML::EndMap; // CompoundCollider2D Component
+		}
+
 		// --- Script Component ---
 		if (entity.HasComponent<ScriptComponent>())
 		{
@@ -383,32 +632,33 @@ namespace Locus
 			out << YAML::Key << "ScriptClass" << YAML::Value << sc.ScriptClass;
 
 			// Fields
-			auto& fieldInstances = ScriptEngine::GetFieldInstances(entity.GetUUID());
 			out << YAML::Key << "Fields";
 			out << YAML::BeginMap;
-			for (auto& [name, field] : fieldInstances)
+			if (ScriptFieldInstances* fieldInstances = ScriptEngine::FindFieldInstances(entity.GetUUID()); fieldInstances && fieldInstances->Class)
 			{
-				switch (field.Field.Type)
+				for (const ScriptClassField* field : fieldInstances->Class->GetFieldLayout())
 				{
-				case FieldType::SystemSingle: out << YAML::Key << name << YAML::Value << field.GetValue<float>(); break;
-				case FieldType::SystemDouble: out << YAML::Key << name << YAML::Value << field.GetValue<double>(); break;
-				case FieldType::SystemShort: out << YAML::Key << name << YAML::Value << field.GetValue<int16_t>(); break;
-				case FieldType::SystemInt: out << YAML::Key << name << YAML::Value << field.GetValue<int>(); break;
-				case FieldType::SystemLong: out << YAML::Key << name << YAML::Value << field.GetValue<int64_t>(); break;
-				case FieldType::SystemUShort: out << YAML::Key << name << YAML::Value << field.GetValue<uint16_t>(); break;
-				case FieldType::SystemUInt: out << YAML::Key << name << YAML::Value << field.GetValue<uint32_t>(); break;
-				case FieldType::SystemULong: out << YAML::Key << name << YAML::Value << field.GetValue<uint64_t>(); break;
-				case FieldType::SystemBoolean: out << YAML::Key << name << YAML::Value << field.GetValue<bool>(); break;
-				case FieldType::SystemChar: out << YAML::Key << name << YAML::Value << field.GetValue<char>(); break;
-				//case FieldType::SystemString: out << YAML::Key << name << YAML::Value << field.GetValue<std::string>(); break;
-
-				case FieldType::LocusVec2: out << YAML::Key << name << YAML::Value << field.GetValue<glm::vec2>(); break;
-				case FieldType::LocusVec3: out << YAML::Key << name << YAML::Value << field.GetValue<glm::vec3>(); break;
-				//case FieldType::LocusVec4: out << YAML::Key << name << YAML::Value << field.GetValue<glm::vec4>(); break;
-				case FieldType::LocusEntity: out << YAML::Key << name << YAML::Value << field.GetValue<UUID>(); break;
-
+					const std::string& name = field->FieldName;
+					switch (field->Type)
+					{
+					case FieldType::SystemSingle: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<float>(*field); break;
+					case FieldType::SystemDouble: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<double>(*field); break;
+					case FieldType::SystemShort: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<int16_t>(*field); break;
+					case FieldType::SystemInt: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<int>(*field); break;
+					case FieldType::SystemLong: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<int64_t>(*field); break;
+					case FieldType::SystemUShort: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<uint16_t>(*field); break;
+					case FieldType::SystemUInt: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<uint32_t>(*field); break;
+					case FieldType::SystemULong: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<uint64_t>(*field); break;
+					case FieldType::SystemBoolean: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<bool>(*field); break;
+					case FieldType::SystemChar: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<char>(*field); break;
+					//case FieldType::SystemString: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<std::string>(*field); break;
+
+					case FieldType::LocusVec2: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<glm::vec2>(*field); break;
+					case FieldType::LocusVec3: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<glm::vec3>(*field); break;
+					//case FieldType::LocusVec4: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<glm::vec4>(*field); break;
+					case FieldType::LocusEntity: out << YAML::Key << name << YAML::Value << fieldInstances->GetValue<UUID>(*field); break;
+					}
 				}
-
 			}
 			out << YAML::EndMap; // Fields
 
@@ -418,25 +668,70 @@ namespace Locus
 		out << YAML::EndMap; // End Entity
 	}
 
-	void SceneSerializer::Serialize(const std::string& path)
+	bool SceneSerializer::IsBinaryPath(const std::string& path)
 	{
-		YAML::Emitter out;
+		return std::filesystem::path(path).extension() == ".locusb";
+	}
+
+	bool SceneSerializer::Serialize(const std::string& path)
+	{
+		if (IsBinaryPath(path))
+			return SerializeBinary(path);
+
+		// Emits straight into the file so the scene is never held as one string.
+		std::string tempPath = path + ".tmp";
+		std::ofstream fout(tempPath);
+		YAML::Emitter out(fout);
 		out << YAML::BeginMap; // Scene
 		out << YAML::Key << "Scene" << YAML::Value << m_Scene->GetSceneName();
+
+		// Physics settings
+		const Physics2DSettings& physics = m_Scene->GetPhysics2DSettings();
+		out << YAML::Key << "Physics2D" << YAML::Value << YAML::BeginMap;
+		out << YAML::Key << "FixedTimestep" << YAML::Value << physics.FixedTimestep;
+		out << YAML::Key << "VelocityIterations" << YAML::Value << physics.VelocityIterations;
+		out << YAML::Key << "PositionIterations" << YAML::Value << physics.PositionIterations;
+		out << YAML::Key << "MaxSubsteps" << YAML::Value << physics.MaxSubsteps;
+		out << YAML::Key << "Interpolate" << YAML::Value << physics.Interpolate;
+		out << YAML::Key << "Threaded" << YAML::Value << physics.Threaded;
+		out << YAML::EndMap;
+
 		// Array of Entities
 		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
 		m_Scene->m_Registry.each([&](auto entityID)
 		{
 			Entity entity = Entity(entityID, m_Scene.get());
-				if (!entity)
+			if (!entity)
 				return;
 			SerializeEntity(out, entity);
 		});
 		out << YAML::EndSeq;
 
 		out << YAML::EndMap; // End Scene
-		std::ofstream fout(path);
-		fout << out.c_str();
+		if (!out.good())
+			LOCUS_CORE_ERROR("Failed to serialize scene {0}: {1}", path, out.GetLastError());
+		fout.close();
+		return ReplaceSceneFile(tempPath, path, out.good() && !fout.fail());
+	}
+
+	bool SceneSerializer::ReplaceSceneFile(const std::string& tempPath, const std::string& path, bool written)
+	{
+		std::error_code error;
+		if (!written)
+		{
+			LOCUS_CORE_ERROR("Failed to write scene {0}. The previous file was kept.", path);
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			LOCUS_CORE_ERROR("Failed to replace scene {0}: {1}", path, error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
 	}
 
 	void SceneSerializer::SerializeRunTime(const std::string& path)
@@ -445,276 +740,480 @@ namespace Locus
 		LOCUS_CORE_ASSERT(false, "Not implemented");
 	}
 
-	bool SceneSerializer::Deserialize(const std::string& path)
+	void SceneSerializer::DecodeEntity(YAML::Node& entity, SceneStaging& staging)
 	{
-		YAML::Node data = YAML::LoadFile(path);
-		if (!data["Scene"])
-			return false;
+		// --- Entity uuid ---
+		uint64_t uuid = entity["Entity"].as<uint64_t>();
+		uint32_t index = (uint32_t)staging.UUIDs.size();
+		staging.UUIDs.push_back(uuid);
 
-		// Deserialize scene data
-		std::string sceneName = data["Scene"].as<std::string>();
-		m_Scene->SetSceneName(sceneName);
-		LOCUS_CORE_TRACE("Deserializing scene '{0}'", sceneName);
+		// --- Tag Component ---
+		TagComponent& tag = staging.Get<TagComponent>().Add(index);
+		tag.Tag = "Entity";
+		tag.Group = "Default";
+		auto tagComponent = entity["TagComponent"];
+		if (tagComponent)
+		{
+			std::string name = tagComponent["Tag"].as<std::string>();
+			if (!name.empty())
+				tag.Tag = name;
+			tag.Enabled = tagComponent["Enabled"].as<bool>();
+			tag.Group = tagComponent["Group"].as<std::string>();
+		}
 
-		// Deserialize every entity data
-		auto entities = data["Entities"];
-		if (entities)
+		// --- Transform Component ---
+		TransformComponent& tc = staging.Get<TransformComponent>().Add(index);
+		tc.Self = uuid;
+		auto transformComponent = entity["TransformComponent"];
+		if (transformComponent) 
 		{
-			for (auto entity : entities)
+			tc.Self = transformComponent["Self"].as<uint64_t>();
+			tc.Parent = transformComponent["Parent"].as<uint64_t>();
+			tc.LocalPosition = transformComponent["LocalPosition"].as<glm::vec3>();
+			tc.LocalRotation = transformComponent["LocalRotation"].as<glm::vec3>();
+			tc.LocalRotationQuat = transformComponent["LocalRotationQuat"].as<glm::quat>();
+			tc.LocalScale = transformComponent["LocalScale"].as<glm::vec3>();
+		}
+
+		// --- Child Component ---
+		auto childComponent = entity["ChildComponent"];
+		if (childComponent)
+		{
+			auto& cc = staging.Get<ChildComponent>().Add(index);
+			cc.ChildCount = childComponent["ChildCount"].as<uint32_t>();
+			auto childEntities = childComponent["ChildEntities"];
+			for (uint32_t i = 0; i < cc.ChildCount; i++)
 			{
-				// --- Entity uuid ---
-				uint64_t uuid = entity["Entity"].as<uint64_t>();
-
-				// --- Tag Component ---
-				std::string name;
-				bool enabled = true;
-				auto tagComponent = entity["TagComponent"];
-				if (tagComponent)
-				{
-					name = tagComponent["Tag"].as<std::string>();
-					enabled = tagComponent["Enabled"].as<bool>();
-				}
+				std::string childWithVal = "Child" + std::to_string(i);
+				UUID uuid = childEntities[childWithVal].as<uint64_t>();
+				cc.ChildEntities.push_back(uuid);
+			}
+		}
 
-				LOCUS_CORE_TRACE("Deserializing Entity: {0}, ID: {1}", name, uuid);
-				Entity deserializedEntity = m_Scene->CreateEntityWithUUID(uuid, name);
-				deserializedEntity.GetComponent<TagComponent>().Enabled = tagComponent["Enabled"].as<bool>();
-				deserializedEntity.GetComponent<TagComponent>().Group = tagComponent["Group"].as<std::string>();
+		// --- Sprite Renderer Component ---
+		auto spriteRendererComponent = entity["SpriteRendererComponent"];
+		if (spriteRendererComponent)
+		{
+			auto& src = staging.Get<SpriteRendererComponent>().Add(index);
+			if (spriteRendererComponent["Texture"])
+				src.Texture = TextureHandle(spriteRendererComponent["Texture"].as<std::string>());
+			src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
+			src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+		}
 
-				// --- Transform Component ---
-				auto transformComponent = entity["TransformComponent"];
-				if (transformComponent) 
+		// --- Circle Renderer Component ---
+		auto circleRendererComponent = entity["CircleRendererComponent"];
+		if (circleRendererComponent)
+		{
+			auto& crc = staging.Get<CircleRendererComponent>().Add(index);
+			crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
+			crc.Thickness = circleRendererComponent["Thickness"].as<float>();
+			crc.Fade = circleRendererComponent["Fade"].as<float>();
+		}
+
+		// --- Tilemap Component ---
+		auto tilemapComponent = entity["TilemapComponent"];
+		if (tilemapComponent)
+		{
+			auto& tmc = staging.Get<TilemapComponent>().Add(index);
+			if (tilemapComponent["Tileset"])
+				tmc.Tileset = TextureHandle(tilemapComponent["Tileset"].as<std::string>());
+			tmc.TilesetSize = { tilemapComponent["TilesetColumns"].as<int>(), tilemapComponent["TilesetRows"].as<int>() };
+			tmc.TileSize = tilemapComponent["TileSize"].as<glm::vec2>();
+			tmc.Color = tilemapComponent["Color"].as<glm::vec4>();
+			tmc.Collision = tilemapComponent["Collision"].as<bool>();
+			tmc.Friction = tilemapComponent["Friction"].as<float>();
+			tmc.CollisionCategory = tilemapComponent["CollisionCategory"].as<uint16_t>();
+			tmc.CollisionMask = tilemapComponent["CollisionMask"].as<uint16_t>();
+			for (auto chunkNode : tilemapComponent["Chunks"])
+			{
+				glm::ivec2 origin = glm::ivec2(chunkNode["X"].as<int32_t>(), chunkNode["Y"].as<int32_t>()) * TilemapChunk::Size;
+				auto tiles = chunkNode["Tiles"];
+				for (int32_t i = 0; i < (int32_t)tiles.size() && i < TilemapChunk::Size * TilemapChunk::Size; i++)
 				{
-					auto& tc = deserializedEntity.GetComponent<TransformComponent>();
-					tc.Self = transformComponent["Self"].as<uint64_t>();
-					tc.Parent = transformComponent["Parent"].as<uint64_t>();
-					tc.LocalPosition = transformComponent["LocalPosition"].as<glm::vec3>();
-					tc.LocalRotation = transformComponent["LocalRotation"].as<glm::vec3>();
-					tc.LocalRotationQuat = transformComponent["LocalRotationQuat"].as<glm::quat>();
-					tc.LocalScale = transformComponent["LocalScale"].as<glm::vec3>();
+					uint16_t tile = tiles[i].as<uint16_t>();
+					if (tile)
+						tmc.Map.SetTile(origin.x + i % TilemapChunk::Size, origin.y + i / TilemapChunk::Size, tile);
 				}
+			}
+		}
+
+		// --- Cube Renderer Component ---
+		auto cubeRendererComponent = entity["CubeRendererComponent"];
+		if (cubeRendererComponent)
+		{
+			auto& crc = staging.Get<CubeRendererComponent>().Add(index);
+			if (cubeRendererComponent["Material"])
+				crc.Material = MaterialHandle(cubeRendererComponent["Material"].as<std::string>());
+		}
+
+		// --- Mesh Renderer Component ---
+		auto meshRendererComponent = entity["MeshRendererComponent"];
+		if (meshRendererComponent)
+		{
+			auto& mrc = staging.Get<MeshRendererComponent>().Add(index);
+			if (meshRendererComponent["Model"])
+				mrc.Model = ModelHandle(meshRendererComponent["Model"].as<std::string>());
+			if (meshRendererComponent["Material"])
+				mrc.Material = MaterialHandle(meshRendererComponent["Material"].as<std::string>());
+		}
+
+		// --- Point Light Component ---
+		auto pointLightComponent = entity["PointLightComponent"];
+		if (pointLightComponent)
+		{
+			auto& plc = staging.Get<PointLightComponent>().Add(index);
+			plc.Color = pointLightComponent["Color"].as<glm::vec4>();
+			plc.Intensity = pointLightComponent["Intensity"].as<float>();
+		}
+
+		// --- Directional Light Component ---
+		auto directionalLightComponent = entity["DirectionalLightComponent"];
+		if (directionalLightComponent)
+		{
+			auto& dlc = staging.Get<DirectionalLightComponent>().Add(index);
+			dlc.Color = directionalLightComponent["Color"].as<glm::vec4>();
+			dlc.Intensity = directionalLightComponent["Intensity"].as<float>();
+		}
+
+		// --- Spot Light Component ---
+		auto spotLightComponent = entity["SpotLightComponent"];
+		if (spotLightComponent)
+		{
+			auto& slc = staging.Get<SpotLightComponent>().Add(index);
+			slc.Color = spotLightComponent["Color"].as<glm::vec4>();
+			slc.Intensity = spotLightComponent["Intensity"].as<float>();
+			slc.CutOff = spotLightComponent["CutOff"].as<float>();
+			slc.OuterCutOff = spotLightComponent["OuterCutOff"].as<float>();
+		}
+
+		// --- Camera Component ---
+		auto cameraComponent = entity["CameraComponent"];
+		if (cameraComponent)
+		{
+			auto& cc = staging.Get<CameraComponent>().Add(index);
+			auto& camera = cc.Camera;
+			auto& cameraProps = cameraComponent["Camera"];
+			camera.SetBackgroundColor(cameraProps["BackgroundColor"].as<glm::vec4>());
+			camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
+			camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+			camera.SetOrthographicNearClip(cameraProps["OrthographicNearClip"].as<float>());
+			camera.SetOrthographicFarClip(cameraProps["OrthographicFarClip"].as<float>());
+			camera.SetPerspectiveFOV(cameraProps["PerspectiveFOV"].as<float>());
+			camera.SetPerspectiveNearClip(cameraProps["PerspectiveNearClip"].as<float>());
+			camera.SetPerspectiveFarClip(cameraProps["PerspectiveFarClip"].as<float>());
+
+			cc.Primary = cameraComponent["Primary"].as<bool>();
+			cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+		}
+
+		// --- Rigidbody2D Component ---
+		auto rigidBody2DComponent = entity["Rigidbody2DComponent"];
+		if (rigidBody2DComponent)
+		{
+			auto& rb2D = staging.Get<Rigidbody2DComponent>().Add(index);
+			rb2D.BodyType = (Rigidbody2DType)rigidBody2DComponent["BodyType"].as<int>();
+			rb2D.Mass = rigidBody2DComponent["Mass"].as<float>();
+			rb2D.GravityScale = rigidBody2DComponent["GravityScale"].as<float>();
+			rb2D.LinearDamping = rigidBody2DComponent["LinearDamping"].as<float>();
+			rb2D.AngularDamping = rigidBody2DComponent["AngularDamping"].as<float>();
+			rb2D.FixedRotation = rigidBody2DComponent["FixedRotation"].as<bool>();
+			rb2D.IsBullet = rigidBody2DComponent["IsBullet"].as<bool>();
+		}
 
-				// --- Child Component ---
-				auto childComponent = entity["ChildComponent"];
-				if (childComponent)
+		// --- BoxCollider2D Component ---
+		auto boxCollider2DComponent = entity["BoxCollider2DComponent"];
+		if (boxCollider2DComponent)
+		{
+			auto& bc2D = staging.Get<BoxCollider2DComponent>().Add(index);
+			bc2D.Friction = boxCollider2DComponent["Friction"].as<float>();
+			bc2D.Restitution = boxCollider2DComponent["Restitution"].as<float>();
+			bc2D.RestitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
+			bc2D.CollisionCategory = boxCollider2DComponent["CollisionCategory"].as<uint16_t>();
+			bc2D.CollisionMask = boxCollider2DComponent["CollisionMask"].as<uint16_t>();
+			bc2D.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
+			bc2D.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
+		}
+
+		// --- CircleCollider2D Component ---
+		auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
+		if (circleCollider2DComponent)
+		{
+			auto& c2D = staging.Get<CircleCollider2DComponent>().Add(index);
+			c2D.Friction = circleCollider2DComponent["Friction"].as<float>();
+			c2D.Restitution = circleCollider2DComponent["Restitution"].as<float>();
+			c2D.RestitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
+			c2D.CollisionCategory = circleCollider2DComponent["CollisionCategory"].as<uint16_t>();
+			c2D.CollisionMask = circleCollider2DComponent["CollisionMask"].as<uint16_t>();
+			c2D.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
+			c2D.Radius = circleCollider2DComponent["Radius"].as<float>();
+		}
+
+		// --- CompoundCollider2D Component ---
+		auto compoundCollider2DComponent = entity["CompoundCollider2DComponent"];
+		if (compoundCollider2DComponent)
+		{
+			auto& cc2D = staging.Get<CompoundCollider2DComponent>().Add(index);
+			for (auto shapeNode : compoundCollider2DComponent["Shapes"])
+			{
+				ColliderShape2D& shape = cc2D.Shapes.emplace_back();
+				shape.Type = (ColliderShape2DType)shapeNode["Type"].as<int>();
+				shape.Friction = shapeNode["Friction"].as<float>();
+				shape.Restitution = shapeNode["Restitution"].as<float>();
+				shape.RestitutionThreshold = shapeNode["RestitutionThreshold"].as<float>();
+				shape.CollisionCategory = shapeNode["CollisionCategory"].as<uint16_t>();
+				shape.CollisionMask = shapeNode["CollisionMask"].as<uint16_t>();
+				shape.Offset = shapeNode["Offset"].as<glm::vec2>();
+				shape.Size = shapeNode["Size"].as<glm::vec2>();
+				shape.Radius = shapeNode["Radius"].as<float>();
+				shape.Loop = shapeNode["Loop"].as<bool>();
+				for (auto vertex : shapeNode["Vertices"])
+					shape.Vertices.push_back(vertex.as<glm::vec2>());
+			}
+		}
+
+		// --- Script Component ---
+		auto scriptComponent = entity["ScriptComponent"];
+		if (scriptComponent)
+		{
+			auto& sc = staging.Get<ScriptComponent>().Add(index);
+			sc.ScriptClass = scriptComponent["ScriptClass"].as<std::string>();
+			ScriptFieldInstances& fieldInstances = staging.ScriptFields.emplace_back();
+			Ref<ScriptClass> scriptClass = ScriptEngine::GetScriptClass(sc.ScriptClass);
+			if (scriptClass)
+			{
+				fieldInstances.Class = scriptClass;
+				fieldInstances.Data = scriptClass->GetFieldDefaults();
+			}
+			else
+			{
+				sc.ScriptClass = std::string();
+			}
+
+			// Fields missing from the file keep their default.
+			auto fields = scriptComponent["Fields"];
+			if (scriptClass && fields)
+			{
+				for (const ScriptClassField* field : scriptClass->GetFieldLayout())
 				{
-					auto& cc = deserializedEntity.AddComponent<ChildComponent>();
-					cc.ChildCount = childComponent["ChildCount"].as<uint32_t>();
-					auto childEntities = childComponent["ChildEntities"];
-					for (uint32_t i = 0; i < cc.ChildCount; i++)
+					auto fieldNode = fields[field->FieldName];
+					if (!fieldNode)
+						continue;
+
+					switch (field->Type)
 					{
-						std::string childWithVal = "Child" + std::to_string(i);
-						UUID uuid = childEntities[childWithVal].as<uint64_t>();
-						cc.ChildEntities.push_back(uuid);
+					case FieldType::SystemSingle:  fieldInstances.SetValue<float>(*field, fieldNode.as<float>());         break;
+					case FieldType::SystemDouble:  fieldInstances.SetValue<double>(*field, fieldNode.as<double>());       break;
+					case FieldType::SystemShort:   fieldInstances.SetValue<int16_t>(*field, fieldNode.as<int16_t>());     break;
+					case FieldType::SystemInt:     fieldInstances.SetValue<int>(*field, fieldNode.as<int>());             break;
+					case FieldType::SystemLong:    fieldInstances.SetValue<int64_t>(*field, fieldNode.as<int64_t>());     break;
+					case FieldType::SystemUShort:  fieldInstances.SetValue<uint16_t>(*field, fieldNode.as<uint16_t>());   break;
+					case FieldType::SystemUInt:    fieldInstances.SetValue<uint32_t>(*field, fieldNode.as<uint32_t>());   break;
+					case FieldType::SystemULong:   fieldInstances.SetValue<uint64_t>(*field, fieldNode.as<uint64_t>());   break;
+					case FieldType::SystemBoolean: fieldInstances.SetValue<bool>(*field, fieldNode.as<bool>());           break;
+					case FieldType::SystemChar:    fieldInstances.SetValue<char>(*field, fieldNode.as<char>());           break;
+					//case FieldType::SystemString: fieldInstances.SetValue<std::string>(*field, fieldNode.as<std::string>()); break;
+
+					case FieldType::LocusVec2:     fieldInstances.SetValue<glm::vec2>(*field, fieldNode.as<glm::vec2>()); break;
+					case FieldType::LocusVec3:     fieldInstances.SetValue<glm::vec3>(*field, fieldNode.as<glm::vec3>()); break;
+					//case FieldType::LocusVec4: fieldInstances.SetValue<glm::vec4>(*field, fieldNode.as<glm::vec4>());     break;
+					case FieldType::LocusEntity:   fieldInstances.SetValue<uint64_t>(*field, fieldNode.as<uint64_t>());   break;
 					}
 				}
+			}
+		}
+	}
 
-				// --- Sprite Renderer Component ---
-				auto spriteRendererComponent = entity["SpriteRendererComponent"];
-				if (spriteRendererComponent)
-				{
-					auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
-					if (spriteRendererComponent["Texture"])
-						src.Texture = TextureHandle(spriteRendererComponent["Texture"].as<std::string>());
-					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
-					src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
-				}
+	bool SceneSerializer::DeserializeHeader(const YAML::Node& data)
+	{
+		if (!data["Scene"])
+			return false;
 
-				// --- Circle Renderer Component ---
-				auto circleRendererComponent = entity["CircleRendererComponent"];
-				if (circleRendererComponent)
-				{
-					auto& crc = deserializedEntity.AddComponent<CircleRendererComponent>();
-					crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
-					crc.Thickness = circleRendererComponent["Thickness"].as<float>();
-					crc.Fade = circleRendererComponent["Fade"].as<float>();
-				}
+		// Deserialize scene data
+		std::string sceneName = data["Scene"].as<std::string>();
+		m_Scene->SetSceneName(sceneName);
+		LOCUS_CORE_TRACE("Deserializing scene '{0}'", sceneName);
 
-				// --- Cube Renderer Component ---
-				auto cubeRendererComponent = entity["CubeRendererComponent"];
-				if (cubeRendererComponent)
-				{
-					auto& crc = deserializedEntity.AddComponent<CubeRendererComponent>();
-					if (cubeRendererComponent["Material"])
-						crc.Material = MaterialHandle(cubeRendererComponent["Material"].as<std::string>());
-				}
+		// Older scenes have no physics settings and keep the defaults.
+		if (auto physicsNode = data["Physics2D"])
+		{
+			Physics2DSettings& physics = m_Scene->GetPhysics2DSettings();
+			physics.FixedTimestep = physicsNode["FixedTimestep"].as<float>();
+			physics.VelocityIterations = physicsNode["VelocityIterations"].as<int32_t>();
+			physics.PositionIterations = physicsNode["PositionIterations"].as<int32_t>();
+			physics.MaxSubsteps = physicsNode["MaxSubsteps"].as<uint32_t>();
+			physics.Interpolate = physicsNode["Interpolate"].as<bool>();
+			if (physicsNode["Threaded"])
+				physics.Threaded = physicsNode["Threaded"].as<bool>();
+			if (physics.Clamp())
+				LOCUS_CORE_WARN("Scene '{0}' has invalid physics settings. Clamped to the minimum values.", sceneName);
+		}
+		return true;
+	}
 
-				// --- Mesh Renderer Component ---
-				auto meshRendererComponent = entity["MeshRendererComponent"];
-				if (meshRendererComponent)
-				{
-					auto& mrc = deserializedEntity.AddComponent<MeshRendererComponent>();
-					if (meshRendererComponent["Model"])
-						mrc.Model = ModelHandle(meshRendererComponent["Model"].as<std::string>());
-					if (meshRendererComponent["Material"])
-						mrc.Material = MaterialHandle(meshRendererComponent["Material"].as<std::string>());
-				}
+	void SceneSerializer::InsertStaging(SceneStaging& staging)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		entt::registry& registry = m_Scene->m_Registry;
+		uint32_t entityCount = (uint32_t)staging.UUIDs.size();
+		if (entityCount == 0)
+			return;
+
+		// --- Entities ---
+		std::vector<entt::entity> entities(entityCount);
+		registry.create(entities.begin(), entities.end());
+		std::vector<IDComponent> ids(entityCount);
+		for (uint32_t i = 0; i < entityCount; i++)
+			ids[i].ID = staging.UUIDs[i];
+		registry.insert<IDComponent>(entities.begin(), entities.end(), ids.begin());
+		m_Scene->m_Entities.reserve(m_Scene->m_Entities.size() + entityCount);
+		for (uint32_t i = 0; i < entityCount; i++)
+			m_Scene->m_Entities[staging.UUIDs[i]] = Entity(entities[i], m_Scene.get());
+
+		// --- Script fields ---
+		// Field instances belong to the ScriptEngine, so they are only handed over here on the main thread.
+		auto& scripts = staging.Get<ScriptComponent>();
+		for (size_t i = 0; i < staging.ScriptFields.size(); i++)
+		{
+			ScriptFieldInstances& fields = staging.ScriptFields[i];
+			if (fields.Class)
+				ScriptEngine::GetFieldInstances(staging.UUIDs[scripts.Entities[i]], fields.Class).Data = std::move(fields.Data);
+		}
 
-				// --- Point Light Component ---
-				auto pointLightComponent = entity["PointLightComponent"];
-				if (pointLightComponent)
-				{
-					auto& plc = deserializedEntity.AddComponent<PointLightComponent>();
-					plc.Color = pointLightComponent["Color"].as<glm::vec4>();
-					plc.Intensity = pointLightComponent["Intensity"].as<float>();
-				}
+		// Inserted components skip Scene::OnComponentAdded().
+		if (m_Scene->m_ViewportWidth > 0 && m_Scene->m_ViewportHeight > 0)
+		{
+			for (CameraComponent& cc : staging.Get<CameraComponent>().Components)
+				cc.Camera.SetViewportSize(m_Scene->m_ViewportWidth, m_Scene->m_ViewportHeight);
+		}
 
-				// --- Directional Light Component ---
-				auto directionalLightComponent = entity["DirectionalLightComponent"];
-				if (directionalLightComponent)
-				{
-					auto& dlc = deserializedEntity.AddComponent<DirectionalLightComponent>();
-					dlc.Color = directionalLightComponent["Color"].as<glm::vec4>();
-					dlc.Intensity = directionalLightComponent["Intensity"].as<float>();
-				}
+		// --- Components ---
+		std::vector<entt::entity> handles;
+		staging.EachComponents([&](auto& staged)
+		{
+			using T = typename std::decay_t<decltype(staged)>::Type;
+			if (staged.Components.empty())
+				return;
+			handles.resize(staged.Entities.size());
+			for (size_t i = 0; i < staged.Entities.size(); i++)
+				handles[i] = entities[staged.Entities[i]];
+			registry.insert<T>(handles.begin(), handles.end(), std::make_move_iterator(staged.Components.begin()));
+		});
 
-				// --- Spot Light Component ---
-				auto spotLightComponent = entity["SpotLightComponent"];
-				if (spotLightComponent)
-				{
-					auto& slc = deserializedEntity.AddComponent<SpotLightComponent>();
-					slc.Color = spotLightComponent["Color"].as<glm::vec4>();
-					slc.Intensity = spotLightComponent["Intensity"].as<float>();
-					slc.CutOff = spotLightComponent["CutOff"].as<float>();
-					slc.OuterCutOff = spotLightComponent["OuterCutOff"].as<float>();
-				}
+		// Every entity has a tag and transform. Binary files written by hand or by older tools might not.
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			if (!registry.all_of<TransformComponent>(entities[i]))
+				registry.emplace<TransformComponent>(entities[i]).Self = staging.UUIDs[i];
+			if (!registry.all_of<TagComponent>(entities[i]))
+			{
+				TagComponent tag("Entity");
+				tag.Group = "Default";
+				registry.emplace<TagComponent>(entities[i], tag);
+			}
+		}
+	}
 
-				// --- Camera Component ---
-				auto cameraComponent = entity["CameraComponent"];
-				if (cameraComponent)
-				{
-					auto& cc = deserializedEntity.AddComponent<CameraComponent>();
-					auto& camera = cc.Camera;
-					auto& cameraProps = cameraComponent["Camera"];
-					camera.SetBackgroundColor(cameraProps["BackgroundColor"].as<glm::vec4>());
-					camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
-					camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-					camera.SetOrthographicNearClip(cameraProps["OrthographicNearClip"].as<float>());
-					camera.SetOrthographicFarClip(cameraProps["OrthographicFarClip"].as<float>());
-					camera.SetPerspectiveFOV(cameraProps["PerspectiveFOV"].as<float>());
-					camera.SetPerspectiveNearClip(cameraProps["PerspectiveNearClip"].as<float>());
-					camera.SetPerspectiveFarClip(cameraProps["PerspectiveFarClip"].as<float>());
-
-					cc.Primary = cameraComponent["Primary"].as<bool>();
-					cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
-				}
+	bool SceneSerializer::Deserialize(const std::string& path)
+	{
+		if (IsBinaryPath(path))
+			return DeserializeBinary(path);
 
-				// --- Rigidbody2D Component ---
-				auto rigidBody2DComponent = entity["Rigidbody2DComponent"];
-				if (rigidBody2DComponent)
-				{
-					auto& rb2D = deserializedEntity.AddComponent<Rigidbody2DComponent>();
-					rb2D.BodyType = (Rigidbody2DType)rigidBody2DComponent["BodyType"].as<int>();
-					rb2D.Mass = rigidBody2DComponent["Mass"].as<float>();
-					rb2D.GravityScale = rigidBody2DComponent["GravityScale"].as<float>();
-					rb2D.LinearDamping = rigidBody2DComponent["LinearDamping"].as<float>();
-					rb2D.AngularDamping = rigidBody2DComponent["AngularDamping"].as<float>();
-					rb2D.FixedRotation = rigidBody2DComponent["FixedRotation"].as<bool>();
-					rb2D.IsBullet = rigidBody2DComponent["IsBullet"].as<bool>();
-				}
+		LOCUS_PROFILE_FUNCTION();
+		Timer timer;
 
-				// --- BoxCollider2D Component ---
-				auto boxCollider2DComponent = entity["BoxCollider2DComponent"];
-				if (boxCollider2DComponent)
-				{
-					auto& bc2D = deserializedEntity.AddComponent<BoxCollider2DComponent>();
-					bc2D.Friction = boxCollider2DComponent["Friction"].as<float>();
-					bc2D.Restitution = boxCollider2DComponent["Restitution"].as<float>();
-					bc2D.RestitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
-					bc2D.CollisionCategory = boxCollider2DComponent["CollisionCategory"].as<uint16_t>();
-					bc2D.CollisionMask = boxCollider2DComponent["CollisionMask"].as<uint16_t>();
-					bc2D.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
-					bc2D.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
-				}
+		// Scenes in the layout Serialize() writes are split into chunks of entities that are decoded
+		//	in parallel. Anything else, eg. a hand edited file, is streamed.
+		uint32_t threadCount = m_ThreadCount ? m_ThreadCount : std::max(std::thread::hardware_concurrency(), 1u);
+		MappedFile file(path);
+		if (file.IsValid())
+		{
+			std::string_view text((const char*)file.GetData(), file.GetSize());
+			uint64_t maxChunkCount = std::max<uint64_t>(file.GetSize() / s_MinChunkSize, 1);
+			uint32_t chunkCount = (uint32_t)std::min<uint64_t>(std::max<uint64_t>(threadCount, file.GetSize() / s_MaxChunkSize + 1), maxChunkCount);
+			std::string header;
+			std::vector<std::string_view> chunks;
+			if (Utils::SplitSceneEntities(text, chunkCount, header, chunks))
+			{
+				if (!DeserializeHeader(YAML::Load(header)))
+					return false;
 
-				// --- CircleCollider2D Component ---
-				auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
-				if (circleCollider2DComponent)
+				auto decodeChunk = [](std::string_view chunk)
 				{
-					auto& c2D = deserializedEntity.AddComponent<CircleCollider2DComponent>();
-					c2D.Friction = circleCollider2DComponent["Friction"].as<float>();
-					c2D.Restitution = circleCollider2DComponent["Restitution"].as<float>();
-					c2D.RestitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
-					c2D.CollisionCategory = circleCollider2DComponent["CollisionCategory"].as<uint16_t>();
-					c2D.CollisionMask = circleCollider2DComponent["CollisionMask"].as<uint16_t>();
-					c2D.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
-					c2D.Radius = circleCollider2DComponent["Radius"].as<float>();
-				}
-
-				// --- Script Component ---
-				auto scriptComponent = entity["ScriptComponent"];
-				auto fields = scriptComponent["Fields"];
-				if (scriptComponent)
+					LOCUS_PROFILE_SCOPE("SceneSerializer::DecodeChunk");
+
+					SceneStaging staging;
+					YAML::Node entities = YAML::Load(std::string(chunk));
+					for (auto entity : entities)
+						DecodeEntity(entity, staging);
+					return staging;
+				};
+
+				// Workers decode ahead while the calling thread inserts. Chunks are inserted in file order,
+				//	each as soon as it is decoded, so entities keep their order in the registry and only
+				//	the chunks in flight are held in memory.
+				std::deque<std::future<SceneStaging>> tasks;
+				size_t nextChunk = 0;
+				uint64_t bytesInFlight = 0;
+				uint32_t entityCount = 0;
+				for (size_t i = 0; i < chunks.size(); i++)
 				{
-					auto& sc = deserializedEntity.AddComponent<ScriptComponent>();
-					sc.ScriptClass = scriptComponent["ScriptClass"].as<std::string>();
-
-					// Fields
-					if (fields && ScriptEngine::HasClass(sc.ScriptClass))
+					// The chunk being waited on is always in flight, even if it is larger than the cap.
+					while (nextChunk < chunks.size() && tasks.size() < threadCount &&
+						(tasks.empty() || bytesInFlight + chunks[nextChunk].size() <= s_MaxBytesInFlight))
 					{
-						Ref<ScriptClass> scriptClass = ScriptEngine::GetScriptClass(sc.ScriptClass);
-						auto& classFields = scriptClass->GetPublicFields();
-						auto& fieldInstances = ScriptEngine::GetFieldInstances(uuid);
-
-						for (auto& [fieldName, field] : classFields)
-						{
-							ScriptClassFieldInstance& scriptField = fieldInstances[fieldName];
-							scriptField.Field = field;
-
-							if (fields[fieldName])
-							{
-								switch (field.Type)
-								{
-								case FieldType::SystemSingle:  scriptField.SetValue<float>(fields[fieldName].as<float>());         break;
-								case FieldType::SystemDouble:  scriptField.SetValue<double>(fields[fieldName].as<double>());       break;
-								case FieldType::SystemShort:   scriptField.SetValue<int16_t>(fields[fieldName].as<int16_t>());     break;
-								case FieldType::SystemInt:     scriptField.SetValue<int>(fields[fieldName].as<int>());             break;
-								case FieldType::SystemLong:    scriptField.SetValue<int64_t>(fields[fieldName].as<int64_t>());     break;
-								case FieldType::SystemUShort:  scriptField.SetValue<uint16_t>(fields[fieldName].as<uint16_t>());   break;
-								case FieldType::SystemUInt:    scriptField.SetValue<uint32_t>(fields[fieldName].as<uint32_t>());   break;
-								case FieldType::SystemULong:   scriptField.SetValue<uint64_t>(fields[fieldName].as<uint64_t>());   break;
-								case FieldType::SystemBoolean: scriptField.SetValue<bool>(fields[fieldName].as<bool>());           break;
-								case FieldType::SystemChar:    scriptField.SetValue<char>(fields[fieldName].as<char>());           break;
-								//case FieldType::SystemString: scriptField.SetValue<std::string>(fields[fieldName].as<std::string>()); break;
-
-								case FieldType::LocusVec2:     scriptField.SetValue<glm::vec2>(fields[fieldName].as<glm::vec2>()); break;
-								case FieldType::LocusVec3:     scriptField.SetValue<glm::vec3>(fields[fieldName].as<glm::vec3>()); break;
-								//case FieldType::LocusVec4: scriptField.SetValue<glm::vec4>(fields[fieldName].as<glm::vec4>());     break;
-								case FieldType::LocusEntity:   scriptField.SetValue<uint64_t>(fields[fieldName].as<uint64_t>());   break;
-								}
-							}
-							else
-							{
-								switch (field.Type)
-								{
-								case FieldType::SystemSingle:  scriptField.SetValue<float>(scriptClass->GetFieldValue<float>(fieldName));         break;
-								case FieldType::SystemDouble:  scriptField.SetValue<double>(scriptClass->GetFieldValue<double>(fieldName));       break;
-								case FieldType::SystemShort:   scriptField.SetValue<int16_t>(scriptClass->GetFieldValue<int16_t>(fieldName));     break;
-								case FieldType::SystemInt:     scriptField.SetValue<int>(scriptClass->GetFieldValue<int>(fieldName));             break;
-								case FieldType::SystemLong:    scriptField.SetValue<int64_t>(scriptClass->GetFieldValue<int64_t>(fieldName));     break;
-								case FieldType::SystemUShort:  scriptField.SetValue<uint16_t>(scriptClass->GetFieldValue<uint16_t>(fieldName));   break;
-								case FieldType::SystemUInt:    scriptField.SetValue<uint32_t>(scriptClass->GetFieldValue<uint32_t>(fieldName));   break;
-								case FieldType::SystemULong:   scriptField.SetValue<uint64_t>(scriptClass->GetFieldValue<uint64_t>(fieldName));   break;
-								case FieldType::SystemBoolean: scriptField.SetValue<bool>(scriptClass->GetFieldValue<bool>(fieldName));           break;
-								case FieldType::SystemChar:    scriptField.SetValue<char>(scriptClass->GetFieldValue<char>(fieldName));           break;
-									//case FieldType::SystemString: scriptField.SetValue<std::string>(fields[fieldName].as<std::string>()); break;
-
-								case FieldType::LocusVec2:     scriptField.SetValue<glm::vec2>(scriptClass->GetFieldValue<glm::vec2>(fieldName)); break;
-								case FieldType::LocusVec3:     scriptField.SetValue<glm::vec3>(scriptClass->GetFieldValue<glm::vec3>(fieldName)); break;
-									//case FieldType::LocusVec4: scriptField.SetValue<glm::vec4>(fields[fieldName].as<glm::vec4>()); break;
-								case FieldType::LocusEntity:   scriptField.SetValue<uint64_t>(scriptClass->GetFieldValue<uint64_t>(fieldName));   break;
-								}
-							}
-						}
-					}
-					else
-					{
-						sc.ScriptClass = std::string();
+						bytesInFlight += chunks[nextChunk].size();
+						tasks.push_back(std::async(std::launch::async, decodeChunk, chunks[nextChunk]));
+						nextChunk++;
 					}
+
+					SceneStaging staging = tasks.front().get();
+					tasks.pop_front();
+					bytesInFlight -= chunks[i].size();
+					LOCUS_CORE_TRACE("Inserting scene chunk {0}/{1} ({2} entities)", i + 1, chunks.size(), staging.UUIDs.size());
+					entityCount += (uint32_t)staging.UUIDs.size();
+					InsertStaging(staging);
 				}
+
+				LOCUS_CORE_INFO("Loaded {0} entities from {1} in {2} ms ({3} chunks)", entityCount, path, timer.ElapsedMillis(), chunks.size());
+				return true;
 			}
 		}
 
-		return true;
+		std::ifstream fin(path);
+		if (!fin)
+		{
+			LOCUS_CORE_ERROR("Could not open scene {0}", path);
+			return false;
+		}
+
+		// Deserialize every entity data. Entities are parsed one at a time as the file is read and
+		//	added in batches, so memory stays bounded.
+		bool validScene = false;
+		SceneStaging staging;
+		auto onHeader = [&](const YAML::Node& data)
+		{
+			validScene = DeserializeHeader(data);
+			return validScene;
+		};
+		auto onEntity = [&](YAML::Node& entity)
+		{
+			DecodeEntity(entity, staging);
+			if (staging.UUIDs.size() >= s_StreamBatchSize)
+			{
+				InsertStaging(staging);
+				staging = SceneStaging();
+			}
+		};
+
+		SceneStreamHandler handler(onHeader, onEntity);
+		YAML::Parser parser(fin);
+		parser.HandleNextDocument(handler);
+		InsertStaging(staging);
+
+		LOCUS_CORE_INFO("Loaded {0} in {1} ms (streamed)", path, timer.ElapsedMillis());
+		return validScene;
 	}
 
 	bool SceneSerializer::DeserializeRunTime(const std::string& path)
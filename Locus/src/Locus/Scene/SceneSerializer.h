@@ -1,5 +1,7 @@
 // --- SceneSerializer --------------------------------------------------------
 // Serializes and deserializes scene to/from a given .locus file.
+// .locusb files use the binary format described in SceneBinary.h. Its
+//	implementation is in SceneSerializerBinary.cpp.
 #pragma once
 
 #include "Locus/Scene/Scene.h"
@@ -7,26 +9,61 @@
 namespace YAML
 {
 	class Emitter;
+	class Node;
 }
 
 namespace Locus
 {
+	class SceneBinaryWriter;
+	class SceneBinaryReader;
+	struct SceneBinaryTable;
+	struct SceneStaging;
+
 	class SceneSerializer
 	{
 	public:
 		SceneSerializer(const Ref<Scene>& scene);
 		~SceneSerializer() = default;
 		
-		void Serialize(const std::string& path);
+		// Picks the format from the extension. Writes to path + ".tmp" and renames it over path once
+		//	the whole scene is written, so a failed save keeps the previous file. Returns false on failure.
+		bool Serialize(const std::string& path);
 		void SerializeRunTime(const std::string& path);
+		bool SerializeBinary(const std::string& path);
 
+		// Picks the format from the extension.
 		bool Deserialize(const std::string& path);
 		bool DeserializeRunTime(const std::string& path);
+		bool DeserializeBinary(const std::string& path);
+
+		static bool IsBinaryPath(const std::string& path);
+
+		// Threads used to decode .locus files. 0 uses every hardware thread.
+		void SetThreadCount(uint32_t threadCount) { m_ThreadCount = threadCount; }
 
 	private:
+		// Moves the written temporary file over path, or deletes it if writing failed.
+		static bool ReplaceSceneFile(const std::string& tempPath, const std::string& path, bool written);
 		void SerializeEntity(YAML::Emitter& out, Entity entity);
+		bool DeserializeHeader(const YAML::Node& data);
+		// Only writes to staging and reads script classes, safe to call from worker threads.
+		static void DecodeEntity(YAML::Node& entity, SceneStaging& staging);
+		// Creates the staged entities and adds their components. Used by both formats. Main thread only.
+		void InsertStaging(SceneStaging& staging);
+
+		// --- Binary ---
+		template<typename T>
+		void WriteComponentTable(SceneBinaryWriter& out, uint32_t type, const std::unordered_map<entt::entity, uint32_t>& indices, uint32_t& tableCount);
+		// Decodes every component of the table into staging. Only reads from the scene and ScriptEngine.
+		template<typename T>
+		static void ReadComponentTable(SceneBinaryReader& in, const SceneBinaryTable& table, SceneStaging& staging);
+		template<typename T>
+		static void EncodeComponent(SceneBinaryWriter& out, const T& component, UUID uuid);
+		template<typename T>
+		static void DecodeComponent(SceneBinaryReader& in, T& component, SceneStaging& staging);
 
 	private:
 		Ref<Scene> m_Scene;
+		uint32_t m_ThreadCount = 0;
 	};
 }
@@ -0,0 +1,661 @@
+#include "Lpch.h"
+#include "SceneSerializer.h"
+
+#include <fstream>
+
+#include "Locus/Core/Timer.h"
+#include "Locus/Scene/Entity.h"
+#include "Locus/Scene/Components.h"
+#include "Locus/Scene/SceneBinary.h"
+#include "Locus/Scene/SceneStaging.h"
+#include "Locus/Scripting/ScriptEngine.h"
+#include "Locus/Utils/PlatformUtils.h"
+
+namespace Locus
+{
+	// --- Encode -------------------------------------------------------------
+	template<>
+	void SceneSerializer::EncodeComponent<TagComponent>(SceneBinaryWriter& out, const TagComponent& tag, UUID uuid)
+	{
+		out.WriteString(tag.Tag);
+		out.WriteString(tag.Group);
+		out.Write(tag.Enabled);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<TransformComponent>(SceneBinaryWriter& out, const TransformComponent& tc, UUID uuid)
+	{
+		out.Write((uint64_t)tc.Self);
+		out.Write((uint64_t)tc.Parent);
+		out.Write(tc.LocalPosition);
+		out.Write(tc.LocalRotation);
+		out.Write(tc.LocalRotationQuat);
+		out.Write(tc.LocalScale);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<ChildComponent>(SceneBinaryWriter& out, const ChildComponent& cc, UUID uuid)
+	{
+		out.Write((uint32_t)cc.ChildEntities.size());
+		for (UUID child : cc.ChildEntities)
+			out.Write((uint64_t)child);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<SpriteRendererComponent>(SceneBinaryWriter& out, const SpriteRendererComponent& src, UUID uuid)
+	{
+		out.WriteString((std::string)src.Texture);
+		out.Write(src.Color);
+		out.Write(src.TilingFactor);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<CircleRendererComponent>(SceneBinaryWriter& out, const CircleRendererComponent& crc, UUID uuid)
+	{
+		out.Write(crc.Color);
+		out.Write(crc.Thickness);
+		out.Write(crc.Fade);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<TilemapComponent>(SceneBinaryWriter& out, const TilemapComponent& tmc, UUID uuid)
+	{
+		out.WriteString((std::string)tmc.Tileset);
+		out.Write(tmc.TilesetSize);
+		out.Write(tmc.TileSize);
+		out.Write(tmc.Color);
+		out.Write(tmc.Collision);
+		out.Write(tmc.Friction);
+		out.Write(tmc.CollisionCategory);
+		out.Write(tmc.CollisionMask);
+		// Chunks are written whole. Their tiles are copied back with one memcpy.
+		out.Write((uint32_t)tmc.Map.GetChunks().size());
+		for (auto& [key, chunk] : tmc.Map.GetChunks())
+		{
+			out.Write(key);
+			out.WriteBytes(chunk.Tiles, sizeof(chunk.Tiles));
+		}
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<CubeRendererComponent>(SceneBinaryWriter& out, const CubeRendererComponent& crc, UUID uuid)
+	{
+		out.WriteString((std::string)crc.Material);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<MeshRendererComponent>(SceneBinaryWriter& out, const MeshRendererComponent& mrc, UUID uuid)
+	{
+		out.WriteString((std::string)mrc.Model);
+		out.WriteString((std::string)mrc.Material);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<PointLightComponent>(SceneBinaryWriter& out, const PointLightComponent& plc, UUID uuid)
+	{
+		out.Write(plc.Color);
+		out.Write(plc.Intensity);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<DirectionalLightComponent>(SceneBinaryWriter& out, const DirectionalLightComponent& dlc, UUID uuid)
+	{
+		out.Write(dlc.Color);
+		out.Write(dlc.Intensity);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<SpotLightComponent>(SceneBinaryWriter& out, const SpotLightComponent& slc, UUID uuid)
+	{
+		out.Write(slc.Color);
+		out.Write(slc.Intensity);
+		out.Write(slc.CutOff);
+		out.Write(slc.OuterCutOff);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<CameraComponent>(SceneBinaryWriter& out, const CameraComponent& cc, UUID uuid)
+	{
+		const SceneCamera& camera = cc.Camera;
+		out.Write(camera.GetBackgroundColor());
+		out.Write((int32_t)camera.GetProjectionType());
+		out.Write(camera.GetOrthographicSize());
+		out.Write(camera.GetOrthographicNearClip());
+		out.Write(camera.GetOrthographicFarClip());
+		out.Write(camera.GetPerspectiveFOV());
+		out.Write(camera.GetPerspectiveNearClip());
+		out.Write(camera.GetPerspectiveFarClip());
+		out.Write(cc.Primary);
+		out.Write(cc.FixedAspectRatio);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<Rigidbody2DComponent>(SceneBinaryWriter& out, const Rigidbody2DComponent& rb2D, UUID uuid)
+	{
+		out.Write((int32_t)rb2D.BodyType);
+		out.Write(rb2D.Mass);
+		out.Write(rb2D.GravityScale);
+		out.Write(rb2D.LinearDamping);
+		out.Write(rb2D.AngularDamping);
+		out.Write(rb2D.FixedRotation);
+		out.Write(rb2D.IsBullet);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<BoxCollider2DComponent>(SceneBinaryWriter& out, const BoxCollider2DComponent& bc2D, UUID uuid)
+	{
+		out.Write(bc2D.Friction);
+		out.Write(bc2D.Restitution);
+		out.Write(bc2D.RestitutionThreshold);
+		out.Write(bc2D.CollisionCategory);
+		out.Write(bc2D.CollisionMask);
+		out.Write(bc2D.Offset);
+		out.Write(bc2D.Size);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<CircleCollider2DComponent>(SceneBinaryWriter& out, const CircleCollider2DComponent& c2D, UUID uuid)
+	{
+		out.Write(c2D.Friction);
+		out.Write(c2D.Restitution);
+		out.Write(c2D.RestitutionThreshold);
+		out.Write(c2D.CollisionCategory);
+		out.Write(c2D.CollisionMask);
+		out.Write(c2D.Offset);
+		out.Write(c2D.Radius);
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<CompoundCollider2DComponent>(SceneBinaryWriter& out, const CompoundCollider2DComponent& cc2D, UUID uuid)
+	{
+		out.Write((uint32_t)cc2D.Shapes.size());
+		for (const ColliderShape2D& shape : cc2D.Shapes)
+		{
+			out.Write((int32_t)shape.Type);
+			out.Write(shape.Friction);
+			out.Write(shape.Restitution);
+			out.Write(shape.RestitutionThreshold);
+			out.Write(shape.CollisionCategory);
+			out.Write(shape.CollisionMask);
+			out.Write(shape.Offset);
+			out.Write(shape.Size);
+			out.Write(shape.Radius);
+			out.Write(shape.Loop);
+			out.Write((uint32_t)shape.Vertices.size());
+			out.WriteBytes(shape.Vertices.data(), shape.Vertices.size() * sizeof(glm::vec2));
+		}
+	}
+
+	template<>
+	void SceneSerializer::EncodeComponent<ScriptComponent>(SceneBinaryWriter& out, const ScriptComponent& sc, UUID uuid)
+	{
+		out.WriteString(sc.ScriptClass);
+
+		// Fields are written by name so they survive changes to the class's field layout.
+		ScriptFieldInstances* fieldInstances = ScriptEngine::FindFieldInstances(uuid);
+		if (!fieldInstances || !fieldInstances->Class)
+		{
+			out.Write((uint32_t)0);
+			return;
+		}
+
+		const auto& layout = fieldInstances->Class->GetFieldLayout();
+		out.Write((uint32_t)layout.size());
+		for (const ScriptClassField* field : layout)
+		{
+			out.WriteString(field->FieldName);
+			out.Write((uint32_t)field->Type);
+			out.Write(field->Size);
+			out.WriteBytes(fieldInstances->Data.data() + field->Offset, field->Size);
+		}
+	}
+
+
+
+	// --- Decode -------------------------------------------------------------
+	template<>
+	void SceneSerializer::DecodeComponent<TagComponent>(SceneBinaryReader& in, TagComponent& tag, SceneStaging& staging)
+	{
+		tag.Tag = in.ReadString();
+		tag.Group = in.ReadString();
+		tag.Enabled = in.Read<bool>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<TransformComponent>(SceneBinaryReader& in, TransformComponent& tc, SceneStaging& staging)
+	{
+		tc.Self = in.Read<uint64_t>();
+		tc.Parent = in.Read<uint64_t>();
+		tc.LocalPosition = in.Read<glm::vec3>();
+		tc.LocalRotation = in.Read<glm::vec3>();
+		tc.LocalRotationQuat = in.Read<glm::quat>();
+		tc.LocalScale = in.Read<glm::vec3>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<ChildComponent>(SceneBinaryReader& in, ChildComponent& cc, SceneStaging& staging)
+	{
+		cc.ChildCount = in.ReadCount(sizeof(uint64_t));
+		cc.ChildEntities.reserve(cc.ChildCount);
+		for (uint32_t i = 0; i < cc.ChildCount && !in.HasError(); i++)
+			cc.ChildEntities.push_back(in.Read<uint64_t>());
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<SpriteRendererComponent>(SceneBinaryReader& in, SpriteRendererComponent& src, SceneStaging& staging)
+	{
+		src.Texture = TextureHandle(in.ReadString());
+		src.Color = in.Read<glm::vec4>();
+		src.TilingFactor = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<CircleRendererComponent>(SceneBinaryReader& in, CircleRendererComponent& crc, SceneStaging& staging)
+	{
+		crc.Color = in.Read<glm::vec4>();
+		crc.Thickness = in.Read<float>();
+		crc.Fade = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<TilemapComponent>(SceneBinaryReader& in, TilemapComponent& tmc, SceneStaging& staging)
+	{
+		tmc.Tileset = TextureHandle(in.ReadString());
+		tmc.TilesetSize = in.Read<glm::ivec2>();
+		tmc.TileSize = in.Read<glm::vec2>();
+		tmc.Color = in.Read<glm::vec4>();
+		tmc.Collision = in.Read<bool>();
+		tmc.Friction = in.Read<float>();
+		tmc.CollisionCategory = in.Read<uint16_t>();
+		tmc.CollisionMask = in.Read<uint16_t>();
+		uint32_t chunkCount = in.ReadCount(sizeof(uint64_t) + sizeof(TilemapChunk::Tiles));
+		auto& chunks = tmc.Map.GetChunks();
+		chunks.reserve(chunkCount);
+		for (uint32_t i = 0; i < chunkCount && !in.HasError(); i++)
+		{
+			uint64_t key = in.Read<uint64_t>();
+			TilemapChunk& chunk = chunks[key];
+			in.ReadBytes(chunk.Tiles, sizeof(chunk.Tiles));
+			chunk.TileCount = 0;
+			for (uint16_t tile : chunk.Tiles)
+				chunk.TileCount += tile ? 1 : 0;
+			// Tilemap never keeps empty chunks.
+			if (chunk.TileCount == 0)
+				chunks.erase(key);
+		}
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<CubeRendererComponent>(SceneBinaryReader& in, CubeRendererComponent& crc, SceneStaging& staging)
+	{
+		crc.Material = MaterialHandle(in.ReadString());
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<MeshRendererComponent>(SceneBinaryReader& in, MeshRendererComponent& mrc, SceneStaging& staging)
+	{
+		mrc.Model = ModelHandle(in.ReadString());
+		mrc.Material = MaterialHandle(in.ReadString());
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<PointLightComponent>(SceneBinaryReader& in, PointLightComponent& plc, SceneStaging& staging)
+	{
+		plc.Color = in.Read<glm::vec4>();
+		plc.Intensity = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<DirectionalLightComponent>(SceneBinaryReader& in, DirectionalLightComponent& dlc, SceneStaging& staging)
+	{
+		dlc.Color = in.Read<glm::vec4>();
+		dlc.Intensity = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<SpotLightComponent>(SceneBinaryReader& in, SpotLightComponent& slc, SceneStaging& staging)
+	{
+		slc.Color = in.Read<glm::vec4>();
+		slc.Intensity = in.Read<float>();
+		slc.CutOff = in.Read<float>();
+		slc.OuterCutOff = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<CameraComponent>(SceneBinaryReader& in, CameraComponent& cc, SceneStaging& staging)
+	{
+		SceneCamera& camera = cc.Camera;
+		camera.SetBackgroundColor(in.Read<glm::vec4>());
+		camera.SetProjectionType((SceneCamera::ProjectionType)in.Read<int32_t>());
+		camera.SetOrthographicSize(in.Read<float>());
+		camera.SetOrthographicNearClip(in.Read<float>());
+		camera.SetOrthographicFarClip(in.Read<float>());
+		camera.SetPerspectiveFOV(in.Read<float>());
+		camera.SetPerspectiveNearClip(in.Read<float>());
+		camera.SetPerspectiveFarClip(in.Read<float>());
+		cc.Primary = in.Read<bool>();
+		cc.FixedAspectRatio = in.Read<bool>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<Rigidbody2DComponent>(SceneBinaryReader& in, Rigidbody2DComponent& rb2D, SceneStaging& staging)
+	{
+		rb2D.BodyType = (Rigidbody2DType)in.Read<int32_t>();
+		rb2D.Mass = in.Read<float>();
+		rb2D.GravityScale = in.Read<float>();
+		rb2D.LinearDamping = in.Read<float>();
+		rb2D.AngularDamping = in.Read<float>();
+		rb2D.FixedRotation = in.Read<bool>();
+		rb2D.IsBullet = in.Read<bool>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<BoxCollider2DComponent>(SceneBinaryReader& in, BoxCollider2DComponent& bc2D, SceneStaging& staging)
+	{
+		bc2D.Friction = in.Read<float>();
+		bc2D.Restitution = in.Read<float>();
+		bc2D.RestitutionThreshold = in.Read<float>();
+		bc2D.CollisionCategory = in.Read<uint16_t>();
+		bc2D.CollisionMask = in.Read<uint16_t>();
+		bc2D.Offset = in.Read<glm::vec2>();
+		bc2D.Size = in.Read<glm::vec2>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<CircleCollider2DComponent>(SceneBinaryReader& in, CircleCollider2DComponent& c2D, SceneStaging& staging)
+	{
+		c2D.Friction = in.Read<float>();
+		c2D.Restitution = in.Read<float>();
+		c2D.RestitutionThreshold = in.Read<float>();
+		c2D.CollisionCategory = in.Read<uint16_t>();
+		c2D.CollisionMask = in.Read<uint16_t>();
+		c2D.Offset = in.Read<glm::vec2>();
+		c2D.Radius = in.Read<float>();
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<CompoundCollider2DComponent>(SceneBinaryReader& in, CompoundCollider2DComponent& cc2D, SceneStaging& staging)
+	{
+		// Bytes of a shape with no vertices.
+		constexpr uint64_t minShapeSize = sizeof(int32_t) + 4 * sizeof(float) + 2 * sizeof(uint16_t) + 2 * sizeof(glm::vec2) + sizeof(bool) + sizeof(uint32_t);
+		uint32_t shapeCount = in.ReadCount(minShapeSize);
+		cc2D.Shapes.reserve(shapeCount);
+		for (uint32_t i = 0; i < shapeCount && !in.HasError(); i++)
+		{
+			ColliderShape2D& shape = cc2D.Shapes.emplace_back();
+			shape.Type = (ColliderShape2DType)in.Read<int32_t>();
+			shape.Friction = in.Read<float>();
+			shape.Restitution = in.Read<float>();
+			shape.RestitutionThreshold = in.Read<float>();
+			shape.CollisionCategory = in.Read<uint16_t>();
+			shape.CollisionMask = in.Read<uint16_t>();
+			shape.Offset = in.Read<glm::vec2>();
+			shape.Size = in.Read<glm::vec2>();
+			shape.Radius = in.Read<float>();
+			shape.Loop = in.Read<bool>();
+			uint32_t vertexCount = in.ReadCount(sizeof(glm::vec2));
+			if (in.HasError())
+				break;
+			shape.Vertices.resize(vertexCount);
+			in.ReadBytes(shape.Vertices.data(), vertexCount * sizeof(glm::vec2));
+		}
+	}
+
+	template<>
+	void SceneSerializer::DecodeComponent<ScriptComponent>(SceneBinaryReader& in, ScriptComponent& sc, SceneStaging& staging)
+	{
+		sc.ScriptClass = in.ReadString();
+		Ref<ScriptClass> scriptClass = ScriptEngine::GetScriptClass(sc.ScriptClass);
+		ScriptFieldInstances& fieldInstances = staging.ScriptFields.emplace_back();
+		if (scriptClass)
+		{
+			fieldInstances.Class = scriptClass;
+			fieldInstances.Data = scriptClass->GetFieldDefaults();
+		}
+		else
+		{
+			sc.ScriptClass = std::string();
+		}
+
+		// Name length, type and size.
+		uint32_t fieldCount = in.ReadCount(3 * sizeof(uint32_t));
+		for (uint32_t i = 0; i < fieldCount && !in.HasError(); i++)
+		{
+			std::string name = in.ReadString();
+			FieldType type = (FieldType)in.Read<uint32_t>();
+			uint32_t size = in.Read<uint32_t>();
+
+			// Fields that were removed or changed type keep their default.
+			const ScriptClassField* field = nullptr;
+			if (scriptClass)
+			{
+				auto& fields = scriptClass->GetPublicFields();
+				auto fieldIt = fields.find(name);
+				if (fieldIt != fields.end() && fieldIt->second.Type == type && fieldIt->second.Size == size)
+					field = &fieldIt->second;
+			}
+
+			if (field)
+				in.ReadBytes(fieldInstances.Data.data() + field->Offset, size);
+			else
+				in.Skip(size);
+		}
+	}
+
+
+
+	// --- Tables -------------------------------------------------------------
+	template<typename T>
+	void SceneSerializer::WriteComponentTable(SceneBinaryWriter& out, uint32_t type, const std::unordered_map<entt::entity, uint32_t>& indices, uint32_t& tableCount)
+	{
+		auto view = m_Scene->m_Registry.view<T>();
+		if (view.empty())
+			return;
+
+		SceneBinaryWriter table;
+		for (auto e : view)
+			table.Write(indices.at(e));
+		for (auto e : view)
+			EncodeComponent<T>(table, view.template get<T>(e), m_Scene->m_Registry.get<IDComponent>(e).ID);
+
+		out.Write(SceneBinaryTable{ type, (uint32_t)view.size(), (uint64_t)table.GetSize() });
+		out.WriteBytes(table.GetBuffer().data(), table.GetSize());
+		tableCount++;
+	}
+
+	template<typename T>
+	void SceneSerializer::ReadComponentTable(SceneBinaryReader& in, const SceneBinaryTable& table, SceneStaging& staging)
+	{
+		// Each entity has at most one component per table and each type has one table, so a valid
+		//	count never exceeds the entity count.
+		StagedComponents<T>& staged = staging.Get<T>();
+		uint32_t entityCount = (uint32_t)staging.UUIDs.size();
+		if (!staged.Entities.empty() || table.Count > entityCount || !in.CanReadArray(table.Count, sizeof(uint32_t)))
+		{
+			in.SetError();
+			return;
+		}
+
+		staged.Entities.resize(table.Count);
+		in.ReadBytes(staged.Entities.data(), staged.Entities.size() * sizeof(uint32_t));
+		std::vector<bool> seen(entityCount, false);
+		for (uint32_t index : staged.Entities)
+		{
+			if (index >= entityCount || seen[index])
+			{
+				in.SetError();
+				return;
+			}
+			seen[index] = true;
+		}
+
+		staged.Components.resize(table.Count);
+		for (uint32_t i = 0; i < table.Count && !in.HasError(); i++)
+			DecodeComponent<T>(in, staged.Components[i], staging);
+	}
+
+	// --- SceneSerializer ----------------------------------------------------
+	bool SceneSerializer::SerializeBinary(const std::string& path)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		entt::registry& registry = m_Scene->m_Registry;
+		auto idView = registry.view<IDComponent>();
+
+		std::vector<uint64_t> uuids;
+		std::unordered_map<entt::entity, uint32_t> indices;
+		uuids.reserve(idView.size());
+		indices.reserve(idView.size());
+		for (auto e : idView)
+		{
+			indices[e] = (uint32_t)uuids.size();
+			uuids.push_back(idView.get<IDComponent>(e).ID);
+		}
+
+		SceneBinaryWriter out;
+		out.WriteString(m_Scene->GetSceneName());
+		const Physics2DSettings& physics = m_Scene->GetPhysics2DSettings();
+		out.Write(physics.FixedTimestep);
+		out.Write(physics.VelocityIterations);
+		out.Write(physics.PositionIterations);
+		out.Write(physics.MaxSubsteps);
+		out.Write(physics.Interpolate);
+		out.Write(physics.Threaded);
+		out.WriteBytes(uuids.data(), uuids.size() * sizeof(uint64_t));
+
+		uint32_t tableCount = 0;
+		WriteComponentTable<TagComponent>(out, SceneBinaryTableID::Tag, indices, tableCount);
+		WriteComponentTable<TransformComponent>(out, SceneBinaryTableID::Transform, indices, tableCount);
+		WriteComponentTable<ChildComponent>(out, SceneBinaryTableID::Child, indices, tableCount);
+		WriteComponentTable<SpriteRendererComponent>(out, SceneBinaryTableID::SpriteRenderer, indices, tableCount);
+		WriteComponentTable<CircleRendererComponent>(out, SceneBinaryTableID::CircleRenderer, indices, tableCount);
+		WriteComponentTable<TilemapComponent>(out, SceneBinaryTableID::Tilemap, indices, tableCount);
+		WriteComponentTable<CubeRendererComponent>(out, SceneBinaryTableID::CubeRenderer, indices, tableCount);
+		WriteComponentTable<MeshRendererComponent>(out, SceneBinaryTableID::MeshRenderer, indices, tableCount);
+		WriteComponentTable<PointLightComponent>(out, SceneBinaryTableID::PointLight, indices, tableCount);
+		WriteComponentTable<DirectionalLightComponent>(out, SceneBinaryTableID::DirectionalLight, indices, tableCount);
+		WriteComponentTable<SpotLightComponent>(out, SceneBinaryTableID::SpotLight, indices, tableCount);
+		WriteComponentTable<CameraComponent>(out, SceneBinaryTableID::Camera, indices, tableCount);
+		WriteComponentTable<Rigidbody2DComponent>(out, SceneBinaryTableID::Rigidbody2D, indices, tableCount);
+		WriteComponentTable<BoxCollider2DComponent>(out, SceneBinaryTableID::BoxCollider2D, indices, tableCount);
+		WriteComponentTable<CircleCollider2DComponent>(out, SceneBinaryTableID::CircleCollider2D, indices, tableCount);
+		WriteComponentTable<CompoundCollider2DComponent>(out, SceneBinaryTableID::CompoundCollider2D, indices, tableCount);
+		WriteComponentTable<ScriptComponent>(out, SceneBinaryTableID::Script, indices, tableCount);
+
+		SceneBinaryHeader header = {};
+		memcpy(header.Magic, s_SceneBinaryMagic, sizeof(header.Magic));
+		header.Version = s_SceneBinaryVersion;
+		header.EntityCount = (uint32_t)uuids.size();
+		header.TableCount = tableCount;
+
+		std::string tempPath = path + ".tmp";
+		std::ofstream fout(tempPath, std::ios::binary);
+		fout.write((const char*)&header, sizeof(header));
+		fout.write((const char*)out.GetBuffer().data(), out.GetSize());
+		fout.close();
+		return ReplaceSceneFile(tempPath, path, !fout.fail());
+	}
+
+	bool SceneSerializer::DeserializeBinary(const std::string& path)
+	{
+		LOCUS_PROFILE_FUNCTION();
+		Timer timer;
+
+		MappedFile file(path);
+		if (!file.IsValid())
+		{
+			LOCUS_CORE_ERROR("Could not open scene {0}", path);
+			return false;
+		}
+
+		SceneBinaryReader in(file.GetData(), file.GetSize());
+		SceneBinaryHeader header = in.Read<SceneBinaryHeader>();
+		if (in.HasError() || memcmp(header.Magic, s_SceneBinaryMagic, sizeof(header.Magic)) != 0)
+		{
+			LOCUS_CORE_ERROR("{0} is not a binary scene", path);
+			return false;
+		}
+		if (header.Version > s_SceneBinaryVersion)
+		{
+			LOCUS_CORE_ERROR("{0} was saved with a newer scene version ({1}). Supported: {2}", path, header.Version, s_SceneBinaryVersion);
+			return false;
+		}
+		if (header.Version < s_SceneBinaryVersion)
+		{
+			LOCUS_CORE_ERROR("{0} uses an old scene version ({1}). Save it again from its .locus scene", path, header.Version);
+			return false;
+		}
+
+		std::string sceneName = in.ReadString();
+		Physics2DSettings physics;
+		physics.FixedTimestep = in.Read<float>();
+		physics.VelocityIterations = in.Read<int32_t>();
+		physics.PositionIterations = in.Read<int32_t>();
+		physics.MaxSubsteps = in.Read<uint32_t>();
+		physics.Interpolate = in.Read<bool>();
+		physics.Threaded = in.Read<bool>();
+		if (!in.HasError() && physics.Clamp())
+			LOCUS_CORE_WARN("Scene '{0}' has invalid physics settings. Clamped to the minimum values.", sceneName);
+
+		SceneStaging staging;
+		if (in.CanReadArray(header.EntityCount, sizeof(uint64_t)))
+		{
+			staging.UUIDs.resize(header.EntityCount);
+			in.ReadBytes(staging.UUIDs.data(), staging.UUIDs.size() * sizeof(uint64_t));
+		}
+		if (in.HasError())
+		{
+			LOCUS_CORE_ERROR("Scene {0} is truncated", path);
+			return false;
+		}
+
+		// --- Component tables ---
+		for (uint32_t t = 0; t < header.TableCount && !in.HasError(); t++)
+		{
+			SceneBinaryTable table = in.Read<SceneBinaryTable>();
+			SceneBinaryReader tableIn = in.ReadBlock(table.Size);
+			switch (table.Type)
+			{
+			case SceneBinaryTableID::Tag:                ReadComponentTable<TagComponent>(tableIn, table, staging);                break;
+			case SceneBinaryTableID::Transform:          ReadComponentTable<TransformComponent>(tableIn, table, staging);          break;
+			case SceneBinaryTableID::Child:              ReadComponentTable<ChildComponent>(tableIn, table, staging);              break;
+			case SceneBinaryTableID::SpriteRenderer:     ReadComponentTable<SpriteRendererComponent>(tableIn, table, staging);     break;
+			case SceneBinaryTableID::CircleRenderer:     ReadComponentTable<CircleRendererComponent>(tableIn, table, staging);     break;
+			case SceneBinaryTableID::Tilemap:            ReadComponentTable<TilemapComponent>(tableIn, table, staging);            break;
+			case SceneBinaryTableID::CubeRenderer:       ReadComponentTable<CubeRendererComponent>(tableIn, table, staging);       break;
+			case SceneBinaryTableID::MeshRenderer:       ReadComponentTable<MeshRendererComponent>(tableIn, table, staging);       break;
+			case SceneBinaryTableID::PointLight:         ReadComponentTable<PointLightComponent>(tableIn, table, staging);         break;
+			case SceneBinaryTableID::DirectionalLight:   ReadComponentTable<DirectionalLightComponent>(tableIn, table, staging);   break;
+			case SceneBinaryTableID::SpotLight:          ReadComponentTable<SpotLightComponent>(tableIn, table, staging);          break;
+			case SceneBinaryTableID::Camera:             ReadComponentTable<CameraComponent>(tableIn, table, staging);             break;
+			case SceneBinaryTableID::Rigidbody2D:        ReadComponentTable<Rigidbody2DComponent>(tableIn, table, staging);        break;
+			case SceneBinaryTableID::BoxCollider2D:      ReadComponentTable<BoxCollider2DComponent>(tableIn, table, staging);      break;
+			case SceneBinaryTableID::CircleCollider2D:   ReadComponentTable<CircleCollider2DComponent>(tableIn, table, staging);   break;
+			case SceneBinaryTableID::CompoundCollider2D: ReadComponentTable<CompoundCollider2DComponent>(tableIn, table, staging); break;
+			case SceneBinaryTableID::Script:             ReadComponentTable<ScriptComponent>(tableIn, table, staging);             break;
+			default:
+				LOCUS_CORE_WARN("Skipping unknown component table {0:#010x} in {1}", table.Type, path);
+				continue;
+			}
+
+			// The table must be read exactly to its end.
+			if (tableIn.HasError() || tableIn.GetRemaining() != 0)
+				in.SetError();
+		}
+
+		if (in.HasError())
+		{
+			LOCUS_CORE_ERROR("Scene {0} is corrupted", path);
+			return false;
+		}
+
+		// The whole file is valid. Only now is the scene touched.
+		LOCUS_CORE_TRACE("Deserializing scene '{0}'", sceneName);
+		m_Scene->SetSceneName(sceneName);
+		m_Scene->GetPhysics2DSettings() = physics;
+		InsertStaging(staging);
+
+		LOCUS_CORE_INFO("Loaded {0} entities from {1} in {2} ms", header.EntityCount, path, timer.ElapsedMillis());
+		return true;
+	}
+}
@@ -0,0 +1,54 @@
+// --- SceneStaging -----------------------------------------------------------
+// Entities and components decoded from a scene file, waiting to be added to
+//	the registry with one insert per component type. The .locus and .locusb
+//	readers both fill it and SceneSerializer::InsertStaging() adds it. Nothing
+//	in here touches the scene, so it can be filled on worker threads or thrown
+//	away when a file turns out to be invalid.
+#pragma once
+
+#include <tuple>
+
+#include "Locus/Scene/Components.h"
+#include "Locus/Scripting/ScriptEngine.h"
+
+namespace Locus
+{
+	// Entities are indices into SceneStaging::UUIDs.
+	template<typename T>
+	struct StagedComponents
+	{
+		using Type = T;
+
+		std::vector<uint32_t> Entities;
+		std::vector<T> Components;
+
+		T& Add(uint32_t entity)
+		{
+			Entities.push_back(entity);
+			return Components.emplace_back();
+		}
+	};
+
+	struct SceneStaging
+	{
+		std::vector<uint64_t> UUIDs;
+
+		std::tuple<
+			StagedComponents<TagComponent>, StagedComponents<TransformComponent>, StagedComponents<ChildComponent>,
+			StagedComponents<SpriteRendererComponent>, StagedComponents<CircleRendererComponent>, StagedComponents<TilemapComponent>,
+			StagedComponents<CubeRendererComponent>, StagedComponents<MeshRendererComponent>,
+			StagedComponents<PointLightComponent>, StagedComponents<DirectionalLightComponent>, StagedComponents<SpotLightComponent>,
+			StagedComponents<CameraComponent>, StagedComponents<Rigidbody2DComponent>, StagedComponents<BoxCollider2DComponent>,
+			StagedComponents<CircleCollider2DComponent>, StagedComponents<CompoundCollider2DComponent>, StagedComponents<ScriptComponent>
+		> Components;
+		// Parallel to the ScriptComponents. Values are decoded into a copy of the class defaults and
+		//	handed to the ScriptEngine on insert. Class is null if the script class doesn't exist.
+		std::vector<ScriptFieldInstances> ScriptFields;
+
+		template<typename T>
+		StagedComponents<T>& Get() { return std::get<StagedComponents<T>>(Components); }
+
+		template<typename Fn>
+		void EachComponents(Fn fn) { std::apply([&fn](auto&... staged) { (fn(staged), ...); }, Components); }
+	};
+}
@@ -0,0 +1,117 @@
+#include "Lpch.h"
+#include "Tilemap.h"
+
+namespace Locus
+{
+	namespace Utils
+	{
+		// Floor division so negative tiles land in negative chunks.
+		static int32_t FloorDiv(int32_t value, int32_t divisor)
+		{
+			return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+		}
+	}
+
+	uint16_t Tilemap::GetTile(int32_t x, int32_t y) const
+	{
+		int32_t chunkX = Utils::FloorDiv(x, TilemapChunk::Size);
+		int32_t chunkY = Utils::FloorDiv(y, TilemapChunk::Size);
+		auto it = m_Chunks.find(GetChunkKey(chunkX, chunkY));
+		if (it == m_Chunks.end())
+			return 0;
+
+		int32_t localX = x - chunkX * TilemapChunk::Size;
+		int32_t localY = y - chunkY * TilemapChunk::Size;
+		return it->second.Tiles[localY * TilemapChunk::Size + localX];
+	}
+
+	void Tilemap::SetTile(int32_t x, int32_t y, uint16_t tile)
+	{
+		int32_t chunkX = Utils::FloorDiv(x, TilemapChunk::Size);
+		int32_t chunkY = Utils::FloorDiv(y, TilemapChunk::Size);
+		uint64_t key = GetChunkKey(chunkX, chunkY);
+		auto it = m_Chunks.find(key);
+		if (it == m_Chunks.end())
+		{
+			if (tile == 0)
+				return;
+			it = m_Chunks.emplace(key, TilemapChunk()).first;
+		}
+
+		TilemapChunk& chunk = it->second;
+		uint16_t& current = chunk.Tiles[(y - chunkY * TilemapChunk::Size) * TilemapChunk::Size + (x - chunkX * TilemapChunk::Size)];
+		if (current == tile)
+			return;
+
+		if (current == 0)
+			chunk.TileCount++;
+		else if (tile == 0)
+			chunk.TileCount--;
+		current = tile;
+		chunk.Dirty = true;
+		m_CollisionDirtyChunks.insert(key);
+
+		if (chunk.TileCount == 0)
+			m_Chunks.erase(it);
+	}
+
+	void Tilemap::Clear()
+	{
+		m_Chunks.clear();
+		m_CollisionDirtyChunks.clear();
+		m_CollisionDirty = true;
+	}
+
+	uint32_t Tilemap::GetTileCount() const
+	{
+		uint32_t count = 0;
+		for (auto& [key, chunk] : m_Chunks)
+			count += chunk.TileCount;
+		return count;
+	}
+
+	void Tilemap::MergeSolidTiles(uint64_t key, std::vector<TileRect>& rects) const
+	{
+		auto it = m_Chunks.find(key);
+		if (it == m_Chunks.end())
+			return;
+
+		const int32_t size = TilemapChunk::Size;
+		const TilemapChunk& chunk = it->second;
+		glm::ivec2 origin = GetChunkCoord(key) * size;
+		bool merged[size * size] = {};
+
+		for (int32_t y = 0; y < size; y++)
+		{
+			for (int32_t x = 0; x < size; x++)
+			{
+				if (chunk.Tiles[y * size + x] == 0 || merged[y * size + x])
+					continue;
+
+				// Grow right as far as possible, then grow up while the whole row is solid.
+				int32_t width = 1;
+				while (x + width < size && chunk.Tiles[y * size + x + width] != 0 && !merged[y * size + x + width])
+					width++;
+
+				int32_t height = 1;
+				while (y + height < size)
+				{
+					bool rowSolid = true;
+					for (int32_t i = 0; i < width && rowSolid; i++)
+					{
+						int32_t index = (y + height) * size + x + i;
+						rowSolid = chunk.Tiles[index] != 0 && !merged[index];
+					}
+					if (!rowSolid)
+						break;
+					height++;
+				}
+
+				for (int32_t j = 0; j < height; j++)
+					memset(&merged[(y + j) * size + x], 1, width);
+
+				rects.push_back({ origin.x + x, origin.y + y, width, height });
+			}
+		}
+	}
+}
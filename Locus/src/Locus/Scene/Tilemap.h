@@ -0,0 +1,88 @@
+// --- Tilemap ----------------------------------------------------------------
+// Tile storage for TilemapComponent. Tiles live in fixed size chunks that are
+//	created on first write, so large sparse maps stay cheap. Each chunk caches
+//	its vertex data in tilemap space, which Renderer2D rebuilds only after the
+//	chunk is edited. Solid tiles are greedily merged into rectangles for
+//	the tilemap's colliders, which are rebuilt per edited chunk.
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Locus/Renderer/VertexArray.h"
+
+namespace Locus
+{
+	struct TilemapChunk
+	{
+		static const int32_t Size = 32;
+
+		TilemapChunk() = default;
+		// Copies get their own render data so rebuilding one never rewrites the other's buffer.
+		TilemapChunk(const TilemapChunk& other) { *this = other; }
+		TilemapChunk& operator=(const TilemapChunk& other)
+		{
+			memcpy(Tiles, other.Tiles, sizeof(Tiles));
+			TileCount = other.TileCount;
+			RuntimeVertexArray = nullptr;
+			RuntimeVertexBuffer = nullptr;
+			RuntimeVertexBufferSize = 0;
+			RuntimeQuadCount = 0;
+			Dirty = true;
+			return *this;
+		}
+
+		// 0 is empty. Other values are the tileset index + 1.
+		uint16_t Tiles[Size * Size] = {};
+		uint32_t TileCount = 0;
+
+		// Render data cached by Renderer2D.
+		Ref<VertexArray> RuntimeVertexArray;
+		Ref<VertexBuffer> RuntimeVertexBuffer;
+		uint32_t RuntimeVertexBufferSize = 0;
+		uint32_t RuntimeQuadCount = 0;
+		// Hash of the tile size, tileset grid, color and entity the vertices were built with.
+		uint64_t RuntimeSettingsHash = 0;
+		bool Dirty = true;
+	};
+
+	// Rectangle of solid tiles in tile coordinates.
+	struct TileRect
+	{
+		int32_t X, Y, Width, Height;
+	};
+
+	class Tilemap
+	{
+	public:
+		Tilemap() = default;
+		// Copies have no colliders built from them yet.
+		Tilemap(const Tilemap& other) : m_Chunks(other.m_Chunks) {}
+		Tilemap& operator=(const Tilemap& other) { m_Chunks = other.m_Chunks; m_CollisionDirty = true; return *this; }
+
+		uint16_t GetTile(int32_t x, int32_t y) const;
+		void SetTile(int32_t x, int32_t y, uint16_t tile);
+		void Clear();
+
+		std::unordered_map<uint64_t, TilemapChunk>& GetChunks() { return m_Chunks; }
+		const std::unordered_map<uint64_t, TilemapChunk>& GetChunks() const { return m_Chunks; }
+		uint32_t GetTileCount() const;
+
+		// Set after Clear() or a copy. The owner rebuilds every chunk's colliders.
+		bool IsCollisionDirty() const { return m_CollisionDirty; }
+		// Keys of chunks edited since the owner last built colliders, including chunks that were erased.
+		const std::unordered_set<uint64_t>& GetCollisionDirtyChunks() const { return m_CollisionDirtyChunks; }
+		void ClearCollisionDirty() { m_CollisionDirty = false; m_CollisionDirtyChunks.clear(); }
+
+		// Greedily merges one chunk's solid tiles into rectangles in tile coordinates.
+		//	Appends nothing if the chunk doesn't exist.
+		void MergeSolidTiles(uint64_t key, std::vector<TileRect>& rects) const;
+
+		static uint64_t GetChunkKey(int32_t chunkX, int32_t chunkY) { return ((uint64_t)(uint32_t)chunkX << 32) | (uint32_t)chunkY; }
+		static glm::ivec2 GetChunkCoord(uint64_t key) { return { (int32_t)(uint32_t)(key >> 32), (int32_t)(uint32_t)key }; }
+
+	private:
+		std::unordered_map<uint64_t, TilemapChunk> m_Chunks;
+		std::unordered_set<uint64_t> m_CollisionDirtyChunks;
+		bool m_CollisionDirty = true;
+	};
+}
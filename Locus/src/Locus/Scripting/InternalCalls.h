@@ -12,21 +12,65 @@ namespace Locus
 {
 	static std::unordered_map<MonoType*, std::function<bool(Entity)>> s_HasComponentFunctions;
 	static std::unordered_map<MonoType*, std::function<void(Entity)>> s_AddComponentFunctions;
+	// Writes up to capacity enabled entities with the component and returns the total number found.
+	static std::unordered_map<MonoType*, std::function<uint32_t(Scene*, UUID*, uint32_t*, uint32_t)>> s_QueryComponentFunctions;
 
 	#define LINK_INTERNAL_CALL(func) mono_add_internal_call("Locus.InternalCalls::"#func, (void*)InternalCalls::func)
 
-	static Entity GetEntity(UUID entityID)
+	// Scripts pass the entt handle they were created with. It is checked against the registry and the UUID,
+	//	so this only falls back to the UUID lookup for stale handles.
+	static Entity GetEntity(UUID entityID, uint32_t entityHandle)
 	{
-		// Probably faster if C# Entity held entt id instead of UUID.
-		Ref<Scene> scene = ScriptEngine::GetScene();
+		Scene* scene = ScriptEngine::GetScene().get();
 		if (!scene)
 			return Entity::Null;
 
-		Entity entity = scene->GetEntityByUUID(entityID);
+		Entity entity = scene->GetEntityByHandle((entt::entity)entityHandle, entityID);
 		LOCUS_CORE_ASSERT(entity != Entity::Null, "GetEntity(): Invalid Entity!");
 		return entity;
 	}
 
+	// Calls func for each entity of a batch (EntityQuery in C#) that has component T.
+	//	The batch is passed as parallel id and handle arrays. Stale entities are skipped.
+	template<typename T, typename Func>
+	static void ForEachBatchComponent(MonoArray* ids, MonoArray* handles, int count, MonoArray* values, Func func)
+	{
+		Scene* scene = ScriptEngine::GetScene().get();
+		if (!scene)
+			return;
+
+		uint32_t batchCount = std::min({ (uint32_t)std::max(count, 0), (uint32_t)mono_array_length(ids),
+			(uint32_t)mono_array_length(handles), (uint32_t)mono_array_length(values) });
+		UUID* idData = mono_array_addr(ids, UUID, 0);
+		uint32_t* handleData = mono_array_addr(handles, uint32_t, 0);
+		for (uint32_t i = 0; i < batchCount; i++)
+		{
+			Entity entity = scene->GetEntityByHandle((entt::entity)handleData[i], idData[i]);
+			if (entity.IsValid() && entity.HasComponent<T>())
+				func(entity, entity.GetComponent<T>(), i);
+		}
+	}
+
+	// Writes an index bucket into the caller's id and handle arrays and returns the total number of matches.
+	static uint32_t WriteIndexedEntities(Scene* scene, const std::set<entt::entity>& bucket, MonoArray* ids, MonoArray* handles)
+	{
+		uint32_t capacity = std::min((uint32_t)mono_array_length(ids), (uint32_t)mono_array_length(handles));
+		UUID* idData = mono_array_addr(ids, UUID, 0);
+		uint32_t* handleData = mono_array_addr(handles, uint32_t, 0);
+		uint32_t count = 0;
+		for (auto e : bucket)
+		{
+			Entity entity = Entity(e, scene);
+			if (count < capacity)
+			{
+				idData[count] = entity.GetUUID();
+				handleData[count] = (uint32_t)e;
+			}
+			count++;
+		}
+		return count;
+	}
+
 	namespace InternalCalls
 	{
 		static void DebugLog(float val)
@@ -35,87 +79,127 @@ namespace Locus
 		}
 
 		// --- Entity ---
-		static uint64_t Entity_CreateEntity()
+		static uint64_t Entity_CreateEntity(uint32_t* outHandle)
 		{
-			Ref<Scene> scene = ScriptEngine::GetScene();
-			Entity entity = scene->CreateEntity();
+			Entity entity = ScriptEngine::GetScene()->CreateEntity();
+			*outHandle = (uint32_t)entity;
 			return entity.GetUUID();
 		}
 
-		static bool Entity_HasComponent(UUID entityID, MonoReflectionType* componentType)
+		static uint32_t Entity_GetHandle(UUID entityID)
+		{
+			Scene* scene = ScriptEngine::GetScene().get();
+			if (!scene)
+				return (uint32_t)entt::null;
+			return (uint32_t)scene->GetEntityByUUID(entityID);
+		}
+
+		// Collision dispatch checks this before each callback, as an earlier callback can destroy the entity.
+		static bool Entity_IsValid(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Scene* scene = ScriptEngine::GetScene().get();
+			return scene && scene->GetEntityByHandle((entt::entity)entityHandle, entityID);
+		}
+
+		static bool Entity_HasComponent(UUID entityID, uint32_t entityHandle, MonoReflectionType* componentType)
+		{
+			Entity entity = GetEntity(entityID, entityHandle);
 			return s_HasComponentFunctions[mono_reflection_type_get_type(componentType)](entity);
 		}
 
-		static void Entity_AddComponent(UUID entityID, MonoReflectionType* componentType)
+		static void Entity_AddComponent(UUID entityID, uint32_t entityHandle, MonoReflectionType* componentType)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			s_AddComponentFunctions[mono_reflection_type_get_type(componentType)](entity);
 
 			// TODO: Think of alternative
-			Ref<Scene> scene = ScriptEngine::GetScene();
-			scene->CreatePhysicsData(entity);
+			ScriptEngine::GetScene()->CreatePhysicsData(entity);
 		}
 
 		// Tag
-		static MonoString* Entity_GetTag(UUID entityID)
+		static MonoString* Entity_GetTag(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			std::string tag = entity.GetComponent<TagComponent>().Tag;
 			return mono_string_new(ScriptEngine::GetAppDomain(), tag.c_str());
 		}
-		static void Entity_SetTag(UUID entityID, MonoString* newTag)
+		static void Entity_SetTag(UUID entityID, uint32_t entityHandle, MonoString* newTag)
 		{
-			Entity entity = GetEntity(entityID);
-			std::string newTagStr = ScriptUtils::MonoStringToUTF8(newTag);
-			entity.GetComponent<TagComponent>().Tag = newTagStr;
+			Entity entity = GetEntity(entityID, entityHandle);
+			ScriptEngine::GetScene()->SetEntityTag(entity, ScriptUtils::MonoStringToUTF8(newTag));
 		}
 
 		// Group
-		static MonoString* Entity_GetGroup(UUID entityID)
+		static MonoString* Entity_GetGroup(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			std::string group = entity.GetComponent<TagComponent>().Group;
 			return mono_string_new(ScriptEngine::GetAppDomain(), group.c_str());
 		}
-		static void Entity_SetGroup(UUID entityID, MonoString* newGroup)
+		static void Entity_SetGroup(UUID entityID, uint32_t entityHandle, MonoString* newGroup)
 		{
-			Entity entity = GetEntity(entityID);
-			std::string newGroupStr = ScriptUtils::MonoStringToUTF8(newGroup);
-			entity.GetComponent<TagComponent>().Group = newGroupStr;
+			Entity entity = GetEntity(entityID, entityHandle);
+			ScriptEngine::GetScene()->SetEntityGroup(entity, ScriptUtils::MonoStringToUTF8(newGroup));
 		}
 
 		// Enabled
-		static bool Entity_GetEnabled(UUID entityID)
+		static bool Entity_GetEnabled(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<TagComponent>().Enabled;
 		}
-		static void Entity_SetEnabled(UUID entityID, bool newEnabled)
+		static void Entity_SetEnabled(UUID entityID, uint32_t entityHandle, bool newEnabled)
 		{
-			Entity entity = GetEntity(entityID);
-			entity.GetComponent<TagComponent>().Enabled = newEnabled;
+			Entity entity = GetEntity(entityID, entityHandle);
+			ScriptEngine::GetScene()->SetEntityEnabled(entity, newEnabled);
 		}
 
-		static uint64_t Entity_Find(MonoString* tag)
+		static uint64_t Entity_Find(MonoString* tag, uint32_t* outHandle)
 		{
-			std::string newTagStr = ScriptUtils::MonoStringToUTF8(tag);
-			auto view = ScriptEngine::GetScene()->GetEntitiesWith<TagComponent>();
-			for (auto e : view)
+			std::string tagStr = ScriptUtils::MonoStringToUTF8(tag);
+			Scene* scene = ScriptEngine::GetScene().get();
+			auto& bucket = scene->GetEntitiesWithTag(tagStr);
+			if (bucket.empty())
 			{
-				Entity entity = Entity(e, ScriptEngine::GetScene().get());
-				if (entity.GetComponent<TagComponent>().Tag == newTagStr)
-					return entity.GetUUID();
+				*outHandle = (uint32_t)entt::null;
+				return 0;
 			}
 
-			return 0;
+			// The lowest handle, so repeated calls and runs of the same scene find the same entity.
+			Entity entity = Entity(*bucket.begin(), scene);
+			*outHandle = (uint32_t)entity;
+			return entity.GetUUID();
+		}
+
+		static int Entity_FindAll(MonoString* tag, MonoArray* ids, MonoArray* handles)
+		{
+			std::string tagStr = ScriptUtils::MonoStringToUTF8(tag);
+			Scene* scene = ScriptEngine::GetScene().get();
+			return (int)WriteIndexedEntities(scene, scene->GetEntitiesWithTag(tagStr), ids, handles);
+		}
+
+		static int Entity_GetGroupEntities(MonoString* group, MonoArray* ids, MonoArray* handles)
+		{
+			std::string groupStr = ScriptUtils::MonoStringToUTF8(group);
+			Scene* scene = ScriptEngine::GetScene().get();
+			return (int)WriteIndexedEntities(scene, scene->GetEntitiesInGroup(groupStr), ids, handles);
 		}
 
-		static void Entity_Destroy(UUID entityID)
+		static void Entity_Destroy(UUID entityID, uint32_t entityHandle)
 		{
-			Ref<Scene> scene = ScriptEngine::GetScene();
-			scene->DestroyEntity(scene->GetEntityByUUID(entityID));
+			ScriptEngine::GetScene()->DestroyEntity(GetEntity(entityID, entityHandle));
+		}
+
+		// --- Scene ---
+		static int Scene_QueryEntities(MonoReflectionType* componentType, MonoArray* ids, MonoArray* handles)
+		{
+			Scene* scene = ScriptEngine::GetScene().get();
+			auto it = s_QueryComponentFunctions.find(mono_reflection_type_get_type(componentType));
+			if (!scene || it == s_QueryComponentFunctions.end())
+				return 0;
+
+			uint32_t capacity = std::min((uint32_t)mono_array_length(ids), (uint32_t)mono_array_length(handles));
+			return (int)it->second(scene, mono_array_addr(ids, UUID, 0), mono_array_addr(handles, uint32_t, 0), capacity);
 		}
 
 		// --- Vec2 ---
@@ -158,265 +242,420 @@ namespace Locus
 
 		// --- Transform Component ---
 		// Local Transform
-		static void TransformComponent_GetLocalTransform(UUID entityID, glm::mat4* output)
+		static void TransformComponent_GetLocalTransform(UUID entityID, uint32_t entityHandle, glm::mat4* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<TransformComponent>().GetLocalTransform();
 		}
 		// World Transform
-		static void TransformComponent_GetWorldTransform(UUID entityID, glm::mat4* output)
+		static void TransformComponent_GetWorldTransform(UUID entityID, uint32_t entityHandle, glm::mat4* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = ScriptEngine::GetScene()->GetWorldTransform(entity);
 		}
 
 		// Local Position
-		static void TransformComponent_GetLocalPosition(UUID entityID, glm::vec3* output)
+		static void TransformComponent_GetLocalPosition(UUID entityID, uint32_t entityHandle, glm::vec3* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<TransformComponent>().LocalPosition;
 		}
-		static void TransformComponent_SetLocalPosition(UUID entityID, glm::vec3* newPos)
+		static void TransformComponent_SetLocalPosition(UUID entityID, uint32_t entityHandle, glm::vec3* newPos)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<TransformComponent>().LocalPosition = *newPos;
 		}
 
 		// Local Rotation Euler
-		static void TransformComponent_GetLocalRotationEuler(UUID entityID, glm::vec3* output)
+		static void TransformComponent_GetLocalRotationEuler(UUID entityID, uint32_t entityHandle, glm::vec3* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<TransformComponent>().GetLocalRotation();
 		}
-		static void TransformComponent_SetLocalRotationEuler(UUID entityID, glm::vec3* newRot)
+		static void TransformComponent_SetLocalRotationEuler(UUID entityID, uint32_t entityHandle, glm::vec3* newRot)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<TransformComponent>().SetLocalRotation(*newRot);
 		}
 
 		// Local Scale
-		static void TransformComponent_GetLocalScale(UUID entityID, glm::vec3* output)
+		static void TransformComponent_GetLocalScale(UUID entityID, uint32_t entityHandle, glm::vec3* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<TransformComponent>().LocalScale;
 		}
-		static void TransformComponent_SetLocalScale(UUID entityID, glm::vec3* newScale)
+		static void TransformComponent_SetLocalScale(UUID entityID, uint32_t entityHandle, glm::vec3* newScale)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<TransformComponent>().LocalScale = *newScale;
+			// Collider shapes are scaled by the transform.
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// World To Local matrix
-		static void TransformComponent_GetWorldToLocal(UUID entityID, glm::mat4* output)
+		static void TransformComponent_GetWorldToLocal(UUID entityID, uint32_t entityHandle, glm::mat4* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = glm::inverse(ScriptEngine::GetScene()->GetWorldTransform(entity));
 		}
 
+		// Batched
+		static void TransformComponent_GetLocalPositions(MonoArray* ids, MonoArray* handles, int count, MonoArray* output)
+		{
+			glm::vec3* positions = mono_array_addr(output, glm::vec3, 0);
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, output, [positions](Entity, TransformComponent& tc, uint32_t i)
+			{
+				positions[i] = tc.LocalPosition;
+			});
+		}
+		static void TransformComponent_SetLocalPositions(MonoArray* ids, MonoArray* handles, int count, MonoArray* newPositions)
+		{
+			glm::vec3* positions = mono_array_addr(newPositions, glm::vec3, 0);
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, newPositions, [positions](Entity, TransformComponent& tc, uint32_t i)
+			{
+				tc.LocalPosition = positions[i];
+			});
+		}
+		static void TransformComponent_GetLocalRotationsEuler(MonoArray* ids, MonoArray* handles, int count, MonoArray* output)
+		{
+			glm::vec3* rotations = mono_array_addr(output, glm::vec3, 0);
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, output, [rotations](Entity, TransformComponent& tc, uint32_t i)
+			{
+				rotations[i] = tc.GetLocalRotation();
+			});
+		}
+		static void TransformComponent_SetLocalRotationsEuler(MonoArray* ids, MonoArray* handles, int count, MonoArray* newRotations)
+		{
+			glm::vec3* rotations = mono_array_addr(newRotations, glm::vec3, 0);
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, newRotations, [rotations](Entity, TransformComponent& tc, uint32_t i)
+			{
+				tc.SetLocalRotation(rotations[i]);
+			});
+		}
+		static void TransformComponent_GetLocalScales(MonoArray* ids, MonoArray* handles, int count, MonoArray* output)
+		{
+			glm::vec3* scales = mono_array_addr(output, glm::vec3, 0);
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, output, [scales](Entity, TransformComponent& tc, uint32_t i)
+			{
+				scales[i] = tc.LocalScale;
+			});
+		}
+		static void TransformComponent_SetLocalScales(MonoArray* ids, MonoArray* handles, int count, MonoArray* newScales)
+		{
+			glm::vec3* scales = mono_array_addr(newScales, glm::vec3, 0);
+			Scene* scene = ScriptEngine::GetScene().get();
+			ForEachBatchComponent<TransformComponent>(ids, handles, count, newScales, [scales, scene](Entity entity, TransformComponent& tc, uint32_t i)
+			{
+				tc.LocalScale = scales[i];
+				// Collider shapes are scaled by the transform.
+				scene->MarkPhysicsDirty(entity);
+			});
+		}
+
 		// --- Sprite Renderer Component ---
 		// Color
-		static void SpriteRendererComponent_GetColor(UUID entityID, glm::vec4* output)
+		static void SpriteRendererComponent_GetColor(UUID entityID, uint32_t entityHandle, glm::vec4* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<SpriteRendererComponent>().Color;
 		}
-		static void SpriteRendererComponent_SetColor(UUID entityID, glm::vec4* newColor)
+		static void SpriteRendererComponent_SetColor(UUID entityID, uint32_t entityHandle, glm::vec4* newColor)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<SpriteRendererComponent>().Color = *newColor;
 		}
 
+		// Batched
+		static void SpriteRendererComponent_GetColors(MonoArray* ids, MonoArray* handles, int count, MonoArray* output)
+		{
+			glm::vec4* colors = mono_array_addr(output, glm::vec4, 0);
+			ForEachBatchComponent<SpriteRendererComponent>(ids, handles, count, output, [colors](Entity, SpriteRendererComponent& sprite, uint32_t i)
+			{
+				colors[i] = sprite.Color;
+			});
+		}
+		static void SpriteRendererComponent_SetColors(MonoArray* ids, MonoArray* handles, int count, MonoArray* newColors)
+		{
+			glm::vec4* colors = mono_array_addr(newColors, glm::vec4, 0);
+			ForEachBatchComponent<SpriteRendererComponent>(ids, handles, count, newColors, [colors](Entity, SpriteRendererComponent& sprite, uint32_t i)
+			{
+				sprite.Color = colors[i];
+			});
+		}
+
 		// Tiling Factor
-		static float SpriteRendererComponent_GetTilingFactor(UUID entityID)
+		static float SpriteRendererComponent_GetTilingFactor(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<SpriteRendererComponent>().TilingFactor;
 		}
-		static void SpriteRendererComponent_SetTilingFactor(UUID entityID, float newTilingFactor)
+		static void SpriteRendererComponent_SetTilingFactor(UUID entityID, uint32_t entityHandle, float newTilingFactor)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<SpriteRendererComponent>().TilingFactor = newTilingFactor;
 		}
 
 		// --- Circle Renderer Component ---
 		// Color
-		static void CircleRendererComponent_GetColor(UUID entityID, glm::vec4* output)
+		static void CircleRendererComponent_GetColor(UUID entityID, uint32_t entityHandle, glm::vec4* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			*output = entity.GetComponent<CircleRendererComponent>().Color;
 		}
-		static void CircleRendererComponent_SetColor(UUID entityID, glm::vec4* newColor)
+		static void CircleRendererComponent_SetColor(UUID entityID, uint32_t entityHandle, glm::vec4* newColor)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<CircleRendererComponent>().Color = *newColor;
 		}
 
 		// Thickness
-		static float CircleRendererComponent_GetThickness(UUID entityID)
+		static float CircleRendererComponent_GetThickness(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<CircleRendererComponent>().Thickness;
 		}
-		static void CircleRendererComponent_SetThickness(UUID entityID, float newThickness)
+		static void CircleRendererComponent_SetThickness(UUID entityID, uint32_t entityHandle, float newThickness)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<CircleRendererComponent>().Thickness = newThickness;
 		}
 
 		// Fade
-		static float CircleRendererComponent_GetFade(UUID entityID)
+		static float CircleRendererComponent_GetFade(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<CircleRendererComponent>().Fade;
 		}
-		static void CircleRendererComponent_SetFade(UUID entityID, float newFade)
+		static void CircleRendererComponent_SetFade(UUID entityID, uint32_t entityHandle, float newFade)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			entity.GetComponent<CircleRendererComponent>().Fade = newFade;
 		}
 
 		// --- Rigidbody2D Component ---
 		// Body Type
-		static int Rigidbody2DComponent_GetBodyType(UUID entityID)
+		static int Rigidbody2DComponent_GetBodyType(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return (int)entity.GetComponent<Rigidbody2DComponent>().BodyType;
 		}
-		static void Rigidbody2DComponent_SetBodyType(UUID entityID, int newBodyType)
+		static void Rigidbody2DComponent_SetBodyType(UUID entityID, uint32_t entityHandle, int newBodyType)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.BodyType = (Rigidbody2DType)newBodyType;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// Mass
-		static float Rigidbody2DComponent_GetMass(UUID entityID)
+		static float Rigidbody2DComponent_GetMass(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().Mass;
 		}
-		static void Rigidbody2DComponent_SetMass(UUID entityID, float newMass)
+		static void Rigidbody2DComponent_SetMass(UUID entityID, uint32_t entityHandle, float newMass)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.Mass = newMass;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// GravityScale
-		static float Rigidbody2DComponent_GetGravityScale(UUID entityID)
+		static float Rigidbody2DComponent_GetGravityScale(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().GravityScale;
 		}
-		static void Rigidbody2DComponent_SetGravityScale(UUID entityID, float newGravityScale)
+		static void Rigidbody2DComponent_SetGravityScale(UUID entityID, uint32_t entityHandle, float newGravityScale)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.GravityScale = newGravityScale;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// Linear Damping
-		static float Rigidbody2DComponent_GetLinearDamping(UUID entityID)
+		static float Rigidbody2DComponent_GetLinearDamping(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().LinearDamping;
 		}
-		static void Rigidbody2DComponent_SetLinearDamping(UUID entityID, float newLinearDamping)
+		static void Rigidbody2DComponent_SetLinearDamping(UUID entityID, uint32_t entityHandle, float newLinearDamping)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.LinearDamping = newLinearDamping;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// Angular Damping
-		static float Rigidbody2DComponent_GetAngularDamping(UUID entityID)
+		static float Rigidbody2DComponent_GetAngularDamping(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().AngularDamping;
 		}
-		static void Rigidbody2DComponent_SetAngularDamping(UUID entityID, float newAngularDamping)
+		static void Rigidbody2DComponent_SetAngularDamping(UUID entityID, uint32_t entityHandle, float newAngularDamping)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.AngularDamping = newAngularDamping;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// Fixed Rotation
-		static bool Rigidbody2DComponent_GetFixedRotation(UUID entityID)
+		static bool Rigidbody2DComponent_GetFixedRotation(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().FixedRotation;
 		}
-		static void Rigidbody2DComponent_SetFixedRotation(UUID entityID, bool newFixedRotation)
+		static void Rigidbody2DComponent_SetFixedRotation(UUID entityID, uint32_t entityHandle, bool newFixedRotation)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.FixedRotation = newFixedRotation;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// IsBullet
-		static bool Rigidbody2DComponent_GetIsBullet(UUID entityID)
+		static bool Rigidbody2DComponent_GetIsBullet(UUID entityID, uint32_t entityHandle)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			return entity.GetComponent<Rigidbody2DComponent>().IsBullet;
 		}
-		static void Rigidbody2DComponent_SetIsBullet(UUID entityID, bool newIsBullet)
+		static void Rigidbody2DComponent_SetIsBullet(UUID entityID, uint32_t entityHandle, bool newIsBullet)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
 			rb2d.IsBullet = newIsBullet;
+			ScriptEngine::GetScene()->MarkPhysicsDirty(entity);
 		}
 
 		// Position
-		static void Rigidbody2DComponent_GetPosition(UUID entityID, glm::vec2* output)
+		static void Rigidbody2DComponent_GetPosition(UUID entityID, uint32_t entityHandle, glm::vec2* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+			if (ScriptEngine::GetScene()->IsPhysicsThreaded())
+			{
+				*output = rb2d.SyncedPosition;
+				return;
+			}
 			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
 			glm::vec2 position = { runtimeBody->GetPosition().x, runtimeBody->GetPosition().y };
 			*output = position;
 		}
-		static void Rigidbody2DComponent_SetPosition(UUID entityID, glm::vec2* newPos)
+		static void Rigidbody2DComponent_SetPosition(UUID entityID, uint32_t entityHandle, glm::vec2* newPos)
 		{
-			Entity entity = GetEntity(entityID);
-			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
-			runtimeBody->SetTransform({ newPos->x, newPos->y }, runtimeBody->GetAngle());
+			glm::vec2 position = *newPos;
+			ScriptEngine::GetScene()->SubmitPhysicsCommand([entityID, entityHandle, position]()
+			{
+				// Queued commands can outlive the entity.
+				Entity entity = ScriptEngine::GetScene()->GetEntityByHandle((entt::entity)entityHandle, entityID);
+				if (!entity.IsValid())
+					return;
+				Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+				b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
+				runtimeBody->SetTransform({ position.x, position.y }, runtimeBody->GetAngle());
+				// Teleport. Don't interpolate from the old position.
+				rb2d.PreviousPosition = position;
+				rb2d.SyncedPosition = position;
+			});
 		}
 
 		// Velocity
-		static void Rigidbody2DComponent_GetVelocity(UUID entityID, glm::vec2* output)
+		static void Rigidbody2DComponent_GetVelocity(UUID entityID, uint32_t entityHandle, glm::vec2* output)
 		{
-			Entity entity = GetEntity(entityID);
+			Entity entity = GetEntity(entityID, entityHandle);
 			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+			if (ScriptEngine::GetScene()->IsPhysicsThreaded())
+			{
+				*output = rb2d.SyncedVelocity;
+				return;
+			}
 			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
 			glm::vec2 velocity = { runtimeBody->GetLinearVelocity().x, runtimeBody->GetLinearVelocity().y };
 			*output = velocity;
 		}
-		static void Rigidbody2DComponent_SetVelocity(UUID entityID, glm::vec2* newVelocity)
+		static void Rigidbody2DComponent_SetVelocity(UUID entityID, uint32_t entityHandle, glm::vec2* newVelocity)
 		{
-			Entity entity = GetEntity(entityID);
-			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
-			runtimeBody->SetLinearVelocity({ newVelocity->x, newVelocity->y });
+			glm::vec2 velocity = *newVelocity;
+			ScriptEngine::GetScene()->SubmitPhysicsCommand([entityID, entityHandle, velocity]()
+			{
+				// Queued commands can outlive the entity.
+				Entity entity = ScriptEngine::GetScene()->GetEntityByHandle((entt::entity)entityHandle, entityID);
+				if (!entity.IsValid())
+					return;
+				Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+				b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
+				runtimeBody->SetLinearVelocity({ velocity.x, velocity.y });
+				rb2d.SyncedVelocity = velocity;
+			});
 		}
 
 		// Add Force
-		static void Rigidbody2DComponent_AddForce(UUID entityID, glm::vec2* force)
+		static void Rigidbody2DComponent_AddForce(UUID entityID, uint32_t entityHandle, glm::vec2* force)
 		{
-			Entity entity = GetEntity(entityID);
-			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
-			runtimeBody->ApplyForce({ force->x, force->y }, runtimeBody->GetWorldCenter(), true);
+			glm::vec2 f = *force;
+			ScriptEngine::GetScene()->SubmitPhysicsCommand([entityID, entityHandle, f]()
+			{
+				// Queued commands can outlive the entity.
+				Entity entity = ScriptEngine::GetScene()->GetEntityByHandle((entt::entity)entityHandle, entityID);
+				if (!entity.IsValid())
+					return;
+				b2Body* runtimeBody = (b2Body*)entity.GetComponent<Rigidbody2DComponent>().RuntimeBody;
+				runtimeBody->ApplyForce({ f.x, f.y }, runtimeBody->GetWorldCenter(), true);
+			});
 		}
 
 		// Add Linear Impulse
-		static void Rigidbody2DComponent_AddLinearImpulse(UUID entityID, glm::vec2* impulse)
+		static void Rigidbody2DComponent_AddLinearImpulse(UUID entityID, uint32_t entityHandle, glm::vec2* impulse)
 		{
-			Entity entity = GetEntity(entityID);
-			Rigidbody2DComponent& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-			b2Body* runtimeBody = (b2Body*)rb2d.RuntimeBody;
-			runtimeBody->ApplyLinearImpulse({ impulse->x, impulse->y }, runtimeBody->GetWorldCenter(), true);
+			glm::vec2 i = *impulse;
+			ScriptEngine::GetScene()->SubmitPhysicsCommand([entityID, entityHandle, i]()
+			{
+				// Queued commands can outlive the entity.
+				Entity entity = ScriptEngine::GetScene()->GetEntityByHandle((entt::entity)entityHandle, entityID);
+				if (!entity.IsValid())
+					return;
+				b2Body* runtimeBody = (b2Body*)entity.GetComponent<Rigidbody2DComponent>().RuntimeBody;
+				runtimeBody->ApplyLinearImpulse({ i.x, i.y }, runtimeBody->GetWorldCenter(), true);
+			});
+		}
+
+		// --- Physics2D ---
+		// Results go into arrays owned by the caller so queries don't allocate on the C# side.
+		static bool Physics2D_Raycast(glm::vec2* origin, glm::vec2* direction, float distance, uint16_t mask, RaycastHit2D* outHit)
+		{
+			return ScriptEngine::GetScene()->Raycast2D(*origin, *direction, distance, *outHit, mask);
+		}
+
+		static int Physics2D_RaycastAll(glm::vec2* origin, glm::vec2* direction, float distance, uint16_t mask, MonoArray* hits)
+		{
+			RaycastHit2D* buffer = mono_array_addr(hits, RaycastHit2D, 0);
+			uint32_t maxHits = (uint32_t)mono_array_length(hits);
+			return (int)ScriptEngine::GetScene()->RaycastAll2D(*origin, *direction, distance, buffer, maxHits, mask);
+		}
+
+		static int Physics2D_OverlapAABB(glm::vec2* min, glm::vec2* max, uint16_t mask, MonoArray* results)
+		{
+			UUID* buffer = mono_array_addr(results, UUID, 0);
+			uint32_t maxCount = (uint32_t)mono_array_length(results);
+			return (int)ScriptEngine::GetScene()->OverlapAABB2D(*min, *max, buffer, maxCount, mask);
+		}
+
+		static int Physics2D_OverlapCircle(glm::vec2* center, float radius, uint16_t mask, MonoArray* results)
+		{
+			UUID* buffer = mono_array_addr(results, UUID, 0);
+			uint32_t maxCount = (uint32_t)mono_array_length(results);
+			return (int)ScriptEngine::GetScene()->OverlapCircle2D(*center, radius, buffer, maxCount, mask);
+		}
+
+		static int Physics2D_OverlapBox(glm::vec2* center, glm::vec2* size, float angle, uint16_t mask, MonoArray* results)
+		{
+			UUID* buffer = mono_array_addr(results, UUID, 0);
+			uint32_t maxCount = (uint32_t)mono_array_length(results);
+			return (int)ScriptEngine::GetScene()->OverlapBox2D(*center, *size, angle, buffer, maxCount, mask);
 		}
 
 		// --- Input ---
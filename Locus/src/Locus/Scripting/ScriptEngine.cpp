@@ -1,35 +1,80 @@
 #include "Lpch.h"
 #include "ScriptEngine.h"
 
+#include <future>
+
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
 #include <mono/metadata/attrdefs.h>
 #include "mono/metadata/mono-debug.h"
 #include "mono/metadata/threads.h"
 #include "mono/metadata/exception.h"
+#include "mono/metadata/object.h"
 
 #include "Locus/Core/UUID.h"
 #include "Locus/Core/Application.h"
+#include "Locus/Core/Hash.h"
+#include "Locus/Core/Timer.h"
 #include "Locus/Scene/Components.h"
 #include "Locus/Scripting/ScriptLink.h"
+#include "Locus/Scripting/ScriptProfiler.h"
 #include "Locus/Scripting/ScriptUtils.h"
 
 namespace Locus
 {
-	// Loads a C# assembly from a path. Returns the loaded assembly.
-	static MonoAssembly* LoadCSharpAssembly(const std::string& assemblyPath, bool loadPDB = false)
+	namespace Utils
 	{
-		uint32_t fileSize = 0;
-		char* fileData = ScriptUtils::ReadBytes(assemblyPath, &fileSize);
+		// Returns an empty buffer if the file can't be read, which happens while the compiler is still writing it.
+		static std::vector<char> ReadAssemblyFile(const std::filesystem::path& filepath)
+		{
+			uint32_t fileSize = 0;
+			char* fileData = ScriptUtils::ReadBytes(filepath.string(), &fileSize);
+			if (!fileData)
+				return {};
+			std::vector<char> data(fileData, fileData + fileSize);
+			delete[] fileData;
+			return data;
+		}
+
+		// Opens the image without loading it into a domain, to check that the data is a complete assembly.
+		static bool IsValidAssemblyImage(const std::vector<char>& data, const std::filesystem::path& filepath)
+		{
+			if (data.empty())
+			{
+				LOCUS_CORE_WARN("Script assembly {0} is empty", filepath.string());
+				return false;
+			}
+
+			MonoImageOpenStatus status;
+			MonoImage* image = mono_image_open_from_data_full((char*)data.data(), (uint32_t)data.size(), 1, &status, 0);
+			if (status != MONO_IMAGE_OK || !image)
+			{
+				LOCUS_CORE_WARN("Script assembly {0} is invalid: {1}", filepath.string(), mono_image_strerror(status));
+				return false;
+			}
+			mono_image_close(image);
+			return true;
+		}
 
+		static std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& filepath)
+		{
+			std::error_code error;
+			auto writeTime = std::filesystem::last_write_time(filepath, error);
+			return error ? std::filesystem::file_time_type() : writeTime;
+		}
+	}
+
+	// Loads a C# assembly from its file data. Returns the loaded assembly.
+	static MonoAssembly* LoadCSharpAssembly(const std::string& assemblyPath, const std::vector<char>& fileData, bool loadPDB = false)
+	{
 		// NOTE: We can't use this image for anything other than loading the assembly because this image doesn't have a reference to the assembly
+		// Mono copies the data, so the buffer can be reused for the next reload.
 		MonoImageOpenStatus status;
-		MonoImage* image = mono_image_open_from_data_full(fileData, fileSize, 1, &status, 0);
+		MonoImage* image = mono_image_open_from_data_full((char*)fileData.data(), (uint32_t)fileData.size(), 1, &status, 0);
 
 		if (status != MONO_IMAGE_OK)
 		{
-			const char* errorMessage = mono_image_strerror(status);
-			// Log some error message using the errorMessage data
+			LOCUS_CORE_ERROR("Failed to open C# assembly {0}: {1}", assemblyPath, mono_image_strerror(status));
 			return nullptr;
 		}
 
@@ -50,13 +95,49 @@ namespace Locus
 
 		MonoAssembly* assembly = mono_assembly_load_from_full(image, assemblyPath.c_str(), &status, 0);
 		mono_image_close(image);
-
-		// Don't forget to free the file data
-		delete[] fileData;
+		if (!assembly)
+			LOCUS_CORE_ERROR("Failed to load C# assembly {0}: {1}", assemblyPath, mono_image_strerror(status));
 
 		return assembly;
 	}
 
+	typedef void (*DispatchCollisionsThunk)(MonoArray*, MonoArray*, MonoArray*, MonoArray*, int, int, MonoException**);
+
+	// Instance of a class deriving from Locus.EntitySystem. Systems are not attached to an entity.
+	struct ScriptSystem
+	{
+		uint32_t GCHandle = 0;
+		OnCreateThunk OnCreate = nullptr;
+		OnUpdateThunk OnUpdate = nullptr;
+		uint32_t ProfileIndex = 0;
+	};
+
+	// Result of reading the assemblies on a worker thread. Only files whose write time changed are read.
+	//	Empty data keeps that assembly's current image on reload.
+	struct ScriptAssemblyChanges
+	{
+		std::vector<char> CoreData;
+		std::vector<char> AppData;
+		uint64_t CoreHash = 0;
+		uint64_t AppHash = 0;
+	};
+
+	static ScriptAssemblyChanges ReadAssemblyChanges(const std::filesystem::path& corePath, const std::filesystem::path& appPath, bool readCore, bool readApp)
+	{
+		ScriptAssemblyChanges changes;
+		if (readCore)
+		{
+			changes.CoreData = Utils::ReadAssemblyFile(corePath);
+			changes.CoreHash = Utils::HashBytes(changes.CoreData.data(), changes.CoreData.size());
+		}
+		if (readApp && std::filesystem::exists(appPath))
+		{
+			changes.AppData = Utils::ReadAssemblyFile(appPath);
+			changes.AppHash = Utils::HashBytes(changes.AppData.data(), changes.AppData.size());
+		}
+		return changes;
+	}
+
 	struct ScriptEngineData
 	{
 		// Domains
@@ -71,6 +152,7 @@ namespace Locus
 
 		Ref<Scene> Scene = nullptr;
 
+		std::filesystem::path CoreDllPath = "resources/scripts/Locus-Script.dll";
 		std::filesystem::path AppDllPath = {};
 		
 		bool Debugging = true;
@@ -78,17 +160,40 @@ namespace Locus
 		std::unordered_map<std::string, Ref<ScriptClass>> ScriptClasses;
 		std::unordered_map<UUID, Ref<ScriptInstance>> ScriptInstances;
 		std::vector<std::string> ScriptClassNames;
-		std::map<UUID, std::map<std::string, ScriptClassFieldInstance>> FieldInstances;
+		std::unordered_map<UUID, ScriptFieldInstances> FieldInstances;
 
 		std::queue<ExceptionData> Exceptions;
 
 		Ref<ScriptClass> EntityBaseClass;
+		Ref<ScriptClass> SystemBaseClass;
+
+		std::vector<Ref<ScriptClass>> SystemClasses;
+		std::vector<ScriptSystem> Systems;
+
+		// Batched collision dispatch. The arrays are held by GC handles and reused every frame.
+		DispatchCollisionsThunk DispatchCollisionsFunc = nullptr;
+		uint32_t CollisionEntitiesHandle = 0;
+		uint32_t CollisionOtherEntitiesHandle = 0;
+		uint32_t CollisionOtherIDsHandle = 0;
+		uint32_t CollisionOtherHandlesHandle = 0;
+		uint32_t CollisionCapacity = 0;
+
+		// --- Hot reload ---
+		// Assemblies are kept in memory so a reload only reads the files that changed.
+		std::vector<char> CoreAssemblyData;
+		std::vector<char> AppAssemblyData;
+		uint64_t CoreAssemblyHash = 0;
+		uint64_t AppAssemblyHash = 0;
+		std::filesystem::file_time_type CoreWriteTime;
+		std::filesystem::file_time_type AppWriteTime;
+		// Internal calls are registered with the runtime, not the domain, so they survive reloads.
+		bool InternalCallsLinked = false;
+		Timer PollTimer;
+		std::future<ScriptAssemblyChanges> ReloadTask;
 	};
 
 	static ScriptEngineData* s_SEData = nullptr;
-
-	typedef void (*OnUpdateThunk)(MonoObject*, float, MonoException**);
-	typedef void (*OnCreateThunk)(MonoObject*, MonoException**);
+	static constexpr float s_PollIntervalMillis = 500.0f;
 
 
 	// --- ScriptEngine -------------------------------------------------------
@@ -122,65 +227,232 @@ namespace Locus
 
 		mono_thread_set_main(mono_thread_current());
 
-		LoadAssembly("resources/scripts/Locus-Script.dll", s_SEData->Debugging);
+		ReadAssemblyFiles();
+		LoadAssemblies();
+	}
 
-		s_SEData->EntityBaseClass = CreateRef<ScriptClass>(s_SEData->CoreAssemblyImage, "Locus", "Entity");
+	// Reloads the assemblies from disk
+	void ScriptEngine::ReloadScripts(Ref<Scene> scene)
+	{
+		s_SEData->CoreWriteTime = Utils::GetWriteTime(s_SEData->CoreDllPath);
+		s_SEData->AppWriteTime = Utils::GetWriteTime(s_SEData->AppDllPath);
+		ScriptAssemblyChanges changes = ReadAssemblyChanges(s_SEData->CoreDllPath, s_SEData->AppDllPath, true, true);
+		ReloadAssemblies(scene, changes);
+	}
 
+	bool ScriptEngine::CheckForChanges(Ref<Scene> scene)
+	{
+		if (s_SEData->ReloadTask.valid())
+		{
+			if (s_SEData->ReloadTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+
+			ScriptAssemblyChanges changes = s_SEData->ReloadTask.get();
+			if (changes.CoreHash == s_SEData->CoreAssemblyHash)
+				changes.CoreData.clear();
+			if (changes.AppHash == s_SEData->AppAssemblyHash)
+				changes.AppData.clear();
+
+			if (changes.CoreData.empty() && changes.AppData.empty())
+			{
+				LOCUS_CORE_INFO("Script assemblies are unchanged. Skipping reload.");
+				return false;
+			}
+			return ReloadAssemblies(scene, changes);
+		}
+
+		if (s_SEData->PollTimer.ElapsedMillis() < s_PollIntervalMillis)
+			return false;
+		s_SEData->PollTimer.Reset();
+
+		auto coreWriteTime = Utils::GetWriteTime(s_SEData->CoreDllPath);
+		auto appWriteTime = Utils::GetWriteTime(s_SEData->AppDllPath);
+		bool readCore = coreWriteTime != s_SEData->CoreWriteTime;
+		bool readApp = appWriteTime != s_SEData->AppWriteTime;
+		if (!readCore && !readApp)
+			return false;
+		s_SEData->CoreWriteTime = coreWriteTime;
+		s_SEData->AppWriteTime = appWriteTime;
+
+		// Reading and hashing a large assembly takes a while, so it is done on a worker thread.
+		//	A file that can't be read yet comes back empty, and its next write triggers another read.
+		s_SEData->ReloadTask = std::async(std::launch::async, ReadAssemblyChanges, s_SEData->CoreDllPath, s_SEData->AppDllPath, readCore, readApp);
+		return false;
+	}
+
+	void ScriptEngine::ReadAssemblyFiles()
+	{
+		s_SEData->CoreWriteTime = Utils::GetWriteTime(s_SEData->CoreDllPath);
+		s_SEData->CoreAssemblyData = Utils::ReadAssemblyFile(s_SEData->CoreDllPath);
+		s_SEData->CoreAssemblyHash = Utils::HashBytes(s_SEData->CoreAssemblyData.data(), s_SEData->CoreAssemblyData.size());
+
+		s_SEData->AppWriteTime = Utils::GetWriteTime(s_SEData->AppDllPath);
+		s_SEData->AppAssemblyData.clear();
 		if (std::filesystem::exists(s_SEData->AppDllPath))
+			s_SEData->AppAssemblyData = Utils::ReadAssemblyFile(s_SEData->AppDllPath);
+		s_SEData->AppAssemblyHash = Utils::HashBytes(s_SEData->AppAssemblyData.data(), s_SEData->AppAssemblyData.size());
+	}
+
+	// Loads the in-memory assemblies into a new app domain.
+	void ScriptEngine::LoadAssemblies()
+	{
+		if (!LoadAssembly(s_SEData->CoreDllPath.string(), s_SEData->Debugging))
+			return;
+
+		s_SEData->EntityBaseClass = CreateRef<ScriptClass>(s_SEData->CoreAssemblyImage, "Locus", "Entity");
+		s_SEData->SystemBaseClass = CreateRef<ScriptClass>(s_SEData->CoreAssemblyImage, "Locus", "EntitySystem");
+		LoadCoreMethods();
+
+		if (!s_SEData->AppAssemblyData.empty() && LoadAppAssembly(s_SEData->AppDllPath.string(), s_SEData->Debugging))
 		{
-			std::string appAssemblyPath = s_SEData->AppDllPath.string();
-			LoadAppAssembly(appAssemblyPath, s_SEData->Debugging);
 			LoadAppAssemblyClasses();
 			// Links C++ internal function definitions to the respective C# method declarations.
-			ScriptLink::RegisterFunctions();
+			//	Component types belong to the domain and are registered again on every load.
+			if (s_SEData->InternalCallsLinked)
+			{
+				ScriptLink::RegisterComponents();
+			}
+			else
+			{
+				ScriptLink::RegisterFunctions();
+				s_SEData->InternalCallsLinked = true;
+			}
 		}
 	}
 
-	// Reloads the assembly
-	void ScriptEngine::ReloadScripts()
+	bool ScriptEngine::ReloadAssemblies(Ref<Scene> scene, ScriptAssemblyChanges& changes)
 	{
+		Timer timer;
+
+		// Both images are opened before the domain is unloaded, so an assembly that is still being
+		//	written leaves the current scripts running. Its next write triggers another attempt.
+		const std::vector<char>& coreData = changes.CoreData.empty() ? s_SEData->CoreAssemblyData : changes.CoreData;
+		const std::vector<char>& appData = changes.AppData.empty() ? s_SEData->AppAssemblyData : changes.AppData;
+		if (!Utils::IsValidAssemblyImage(coreData, s_SEData->CoreDllPath) ||
+			(!appData.empty() && !Utils::IsValidAssemblyImage(appData, s_SEData->AppDllPath)))
+		{
+			LOCUS_CORE_WARN("Keeping the loaded scripts until the assemblies change again");
+			return false;
+		}
+
+		if (!changes.CoreData.empty())
+		{
+			s_SEData->CoreAssemblyData = std::move(changes.CoreData);
+			s_SEData->CoreAssemblyHash = changes.CoreHash;
+		}
+		if (!changes.AppData.empty())
+		{
+			s_SEData->AppAssemblyData = std::move(changes.AppData);
+			s_SEData->AppAssemblyHash = changes.AppHash;
+		}
+
+		FreeCollisionArrays();
+		FreeSystems();
 		mono_domain_set(mono_get_root_domain(), false);
 		mono_domain_unload(s_SEData->AppDomain);
 
-		LoadAssembly("resources/scripts/Locus-Script.dll", s_SEData->Debugging);
+		LoadAssemblies();
+		uint32_t keptFields = RebindFieldInstances(scene);
 
-		s_SEData->EntityBaseClass = CreateRef<ScriptClass>(s_SEData->CoreAssemblyImage, "Locus", "Entity");
+		LOCUS_CORE_INFO("Reloaded scripts in {0} ms ({1} field values kept)", timer.ElapsedMillis(), keptFields);
+		return true;
+	}
 
-		if (std::filesystem::exists(s_SEData->AppDllPath))
-		{
-			std::string appAssemblyPath = s_SEData->AppDllPath.string();
+	// Field instances hold the editor values and live outside the domain. Moves them to the layout of the
+	//	reloaded class. Values whose field was removed or changed type are reset to their default.
+	//	Returns the number of values kept.
+	uint32_t ScriptEngine::RebindFieldInstances(Ref<Scene> scene)
+	{
+		if (!scene)
+			return 0;
 
-			LoadAppAssembly(appAssemblyPath, s_SEData->Debugging);
-			LoadAppAssemblyClasses();
-			// Link C++ functions to C# declarations
-			ScriptLink::RegisterFunctions();
+		uint32_t keptFields = 0;
+		auto view = scene->GetEntitiesWith<IDComponent, ScriptComponent>();
+		for (auto e : view)
+		{
+			auto [id, sc] = view.get<IDComponent, ScriptComponent>(e);
+			auto fieldsIt = s_SEData->FieldInstances.find(id.ID);
+			if (fieldsIt == s_SEData->FieldInstances.end())
+				continue;
+			// Keep the values of a class that failed to compile so they come back with it.
+			Ref<ScriptClass> scriptClass = GetScriptClass(sc.ScriptClass);
+			if (!scriptClass)
+				continue;
+
+			// The old class is still referenced by the field instances, so its layout is intact.
+			ScriptFieldInstances& fieldInstances = fieldsIt->second;
+			if (!fieldInstances.Class || fieldInstances.Class == scriptClass)
+				continue;
+
+			std::vector<uint8_t> data = scriptClass->GetFieldDefaults();
+			const auto& oldFields = fieldInstances.Class->GetPublicFields();
+			for (const ScriptClassField* field : scriptClass->GetFieldLayout())
+			{
+				auto oldIt = oldFields.find(field->FieldName);
+				if (oldIt == oldFields.end() || oldIt->second.Type != field->Type || field->Size == 0)
+					continue;
+				memcpy(data.data() + field->Offset, fieldInstances.Data.data() + oldIt->second.Offset, field->Size);
+				keptFields++;
+			}
+			fieldInstances.Class = scriptClass;
+			fieldInstances.Data = std::move(data);
 		}
+		return keptFields;
 	}
 
 	void ScriptEngine::Shutdown()
 	{
+		if (s_SEData->ReloadTask.valid())
+			s_SEData->ReloadTask.wait();
+		FreeCollisionArrays();
+		FreeSystems();
 		s_SEData->RootDomain = nullptr;
 		s_SEData->AppDomain = nullptr;
 		delete s_SEData;
 	}
 
 	// Loads the C# assembly that contains Locus's core API
-	void ScriptEngine::LoadAssembly(const std::string& assemblyPath, bool loadPDB)
+	bool ScriptEngine::LoadAssembly(const std::string& assemblyPath, bool loadPDB)
 	{
 		// Create app domain. App domains are like separate processes within mono
 		s_SEData->AppDomain = mono_domain_create_appdomain("LocusAppDomain", nullptr);
 		LOCUS_CORE_ASSERT(s_SEData->AppDomain, "Failed to create mono app domain!");
 		mono_domain_set(s_SEData->AppDomain, true);
 
-		s_SEData->CoreAssembly = LoadCSharpAssembly(assemblyPath, loadPDB);
-		s_SEData->CoreAssemblyImage = mono_assembly_get_image(s_SEData->CoreAssembly);
+		s_SEData->CoreAssembly = LoadCSharpAssembly(assemblyPath, s_SEData->CoreAssemblyData, loadPDB);
+		s_SEData->CoreAssemblyImage = s_SEData->CoreAssembly ? mono_assembly_get_image(s_SEData->CoreAssembly) : nullptr;
+		return s_SEData->CoreAssemblyImage != nullptr;
 	}
 
 	// Loads the C# assembly that contains the user-written project code
-	void ScriptEngine::LoadAppAssembly(const std::string& assemblyPath, bool loadPDB)
+	bool ScriptEngine::LoadAppAssembly(const std::string& assemblyPath, bool loadPDB)
+	{
+		s_SEData->AppAssembly = LoadCSharpAssembly(assemblyPath, s_SEData->AppAssemblyData, loadPDB);
+		s_SEData->AppAssemblyImage = s_SEData->AppAssembly ? mono_assembly_get_image(s_SEData->AppAssembly) : nullptr;
+		return s_SEData->AppAssemblyImage != nullptr;
+	}
+
+	// Caches thunks of the core assembly's methods called by the engine.
+	void ScriptEngine::LoadCoreMethods()
+	{
+		MonoMethod* dispatchCollisions = s_SEData->EntityBaseClass->GetMethod("DispatchCollisionsInternal", 6);
+		LOCUS_CORE_ASSERT(dispatchCollisions, "Could not find Entity.DispatchCollisionsInternal!");
+		s_SEData->DispatchCollisionsFunc = (DispatchCollisionsThunk)mono_method_get_unmanaged_thunk(dispatchCollisions);
+	}
+
+	void ScriptEngine::FreeCollisionArrays()
 	{
-		s_SEData->AppAssembly = LoadCSharpAssembly(assemblyPath, loadPDB);
-		s_SEData->AppAssemblyImage = mono_assembly_get_image(s_SEData->AppAssembly);
+		if (s_SEData->CollisionCapacity == 0)
+			return;
+		mono_gchandle_free(s_SEData->CollisionEntitiesHandle);
+		mono_gchandle_free(s_SEData->CollisionOtherEntitiesHandle);
+		mono_gchandle_free(s_SEData->CollisionOtherIDsHandle);
+		mono_gchandle_free(s_SEData->CollisionOtherHandlesHandle);
+		s_SEData->CollisionEntitiesHandle = 0;
+		s_SEData->CollisionOtherEntitiesHandle = 0;
+		s_SEData->CollisionOtherIDsHandle = 0;
+		s_SEData->CollisionOtherHandlesHandle = 0;
+		s_SEData->CollisionCapacity = 0;
 	}
 
 	// Loads all the user-written C# classes and its public fields.
@@ -188,6 +460,7 @@ namespace Locus
 	{
 		s_SEData->ScriptClasses.clear();
 		s_SEData->ScriptClassNames.clear();
+		s_SEData->SystemClasses.clear();
 		const MonoTableInfo* typeDefinitionsTable = mono_image_get_table_info(s_SEData->AppAssemblyImage, MONO_TABLE_TYPEDEF);
 		int32_t numTypes = mono_table_info_get_rows(typeDefinitionsTable);
 
@@ -211,6 +484,15 @@ namespace Locus
 			// Create ScriptClass
 			Ref<ScriptClass> scriptClass = CreateRef<ScriptClass>(s_SEData->AppAssemblyImage, namespaceName, className);
 			MonoClass* monoClass = scriptClass->GetMonoClass();
+
+			// Systems run once per frame and are not attached to entities.
+			if (mono_class_is_subclass_of(monoClass, s_SEData->SystemBaseClass->GetMonoClass(), false))
+			{
+				s_SEData->SystemClasses.push_back(scriptClass);
+				LOCUS_CORE_TRACE("Loaded system: {}::{}", namespaceName, className);
+				continue;
+			}
+
 			s_SEData->ScriptClasses[classNameStr] = scriptClass;
 			s_SEData->ScriptClassNames.push_back(classNameStr);
 			LOCUS_CORE_TRACE("Loaded: {}::{}", namespaceName, className);
@@ -240,16 +522,26 @@ namespace Locus
 					LOCUS_CORE_INFO(" " + std::string(fieldName));
 				}
 			}
+
+			scriptClass->BuildFieldLayout();
+			// Only entity scripts are instantiated by the engine, so only they are safe to construct here.
+			if (!scriptClass->m_PublicFields.empty() && mono_class_is_subclass_of(monoClass, s_SEData->EntityBaseClass->GetMonoClass(), false))
+				scriptClass->CaptureFieldDefaults();
 		}
 	}
 
 	void ScriptEngine::OnRuntimeStart(Ref<Scene> scene)
 	{
 		s_SEData->Scene = scene; 
+		// Instances register their class with the profiler when they are created.
+		ScriptProfiler::Reset();
 	}
 
 	void ScriptEngine::OnRuntimeStop()
 	{ 
+		// The arrays still reference instances from this run.
+		FreeCollisionArrays();
+		FreeSystems();
 		s_SEData->ScriptInstances.clear();
 		s_SEData->Scene = nullptr; 
 	}
@@ -258,17 +550,18 @@ namespace Locus
 	void ScriptEngine::OnCreateEntityScript(Entity entity)
 	{
 		auto& sc = entity.GetComponent<ScriptComponent>();
-		if (s_SEData->ScriptClasses.find(sc.ScriptClass) != s_SEData->ScriptClasses.end())
+		auto classIt = s_SEData->ScriptClasses.find(sc.ScriptClass);
+		if (classIt != s_SEData->ScriptClasses.end())
 		{
 			// Creates a class instance and copies data field data from the editor to the script instance.
-			s_SEData->ScriptInstances[entity.GetUUID()] = CreateRef<ScriptInstance>(s_SEData->ScriptClasses[sc.ScriptClass], entity.GetUUID());
-			auto& fields = ScriptEngine::GetFieldInstances(entity.GetUUID());
-			Ref<ScriptInstance> instance = ScriptEngine::GetScriptInstance(entity.GetUUID());
-			for (const auto& [name, field] : fields)
-			{
-				instance->SetFieldValueInternal(name, field.m_Buffer);
-			}
-			s_SEData->ScriptInstances[entity.GetUUID()]->InvokeOnCreate();
+			UUID uuid = entity.GetUUID();
+			Ref<ScriptInstance> instance = CreateRef<ScriptInstance>(classIt->second, entity);
+			s_SEData->ScriptInstances[uuid] = instance;
+			sc.RuntimeInstance = instance.get();
+			ScriptFieldInstances* fieldInstances = FindFieldInstances(uuid);
+			if (fieldInstances && fieldInstances->Class == classIt->second)
+				instance->SetFieldValues(*fieldInstances);
+			instance->InvokeOnCreate();
 		}
 		else
 		{
@@ -278,16 +571,61 @@ namespace Locus
 
 	void ScriptEngine::OnUpdateEntityScript(Entity entity, Timestep deltaTime)
 	{
-		if (s_SEData->ScriptInstances.find(entity.GetUUID()) != s_SEData->ScriptInstances.end())
+		ScriptInstance* instance = (ScriptInstance*)entity.GetComponent<ScriptComponent>().RuntimeInstance;
+		if (instance)
+			instance->InvokeOnUpdate(deltaTime);
+		else
+			LOCUS_CORE_ERROR("Unable to find class!");
+	}
+
+	void ScriptEngine::OnCreateSystems()
+	{
+		for (Ref<ScriptClass>& systemClass : s_SEData->SystemClasses)
 		{
-			s_SEData->ScriptInstances[entity.GetUUID()]->InvokeOnUpdate(deltaTime);
+			ScriptSystem system;
+			system.GCHandle = mono_gchandle_new(systemClass->Instantiate(), false);
+			MonoMethod* onCreateFunc = systemClass->GetMethod("OnCreate", 0);
+			MonoMethod* onUpdateFunc = systemClass->GetMethod("OnUpdate", 1);
+			if (onCreateFunc)
+				system.OnCreate = (OnCreateThunk)mono_method_get_unmanaged_thunk(onCreateFunc);
+			if (onUpdateFunc)
+				system.OnUpdate = (OnUpdateThunk)mono_method_get_unmanaged_thunk(onUpdateFunc);
+			system.ProfileIndex = ScriptProfiler::AddClass(systemClass->GetFullName());
+			s_SEData->Systems.push_back(system);
 		}
-		else
+
+		// Created in a separate pass so OnCreate() can't observe a partially built system list.
+		for (ScriptSystem& system : s_SEData->Systems)
 		{
-			LOCUS_CORE_ERROR("Unable to find class!");
+			if (!system.OnCreate)
+				continue;
+			ScriptProfileScope profile(system.ProfileIndex, ScriptCallback::OnCreate);
+			MonoException* exception = nullptr;
+			system.OnCreate(mono_gchandle_get_target(system.GCHandle), &exception);
+			ScriptUtils::ProcessException(exception);
 		}
 	}
 
+	void ScriptEngine::OnUpdateSystems(Timestep deltaTime)
+	{
+		for (ScriptSystem& system : s_SEData->Systems)
+		{
+			if (!system.OnUpdate)
+				continue;
+			ScriptProfileScope profile(system.ProfileIndex, ScriptCallback::OnUpdate);
+			MonoException* exception = nullptr;
+			system.OnUpdate(mono_gchandle_get_target(system.GCHandle), deltaTime, &exception);
+			ScriptUtils::ProcessException(exception);
+		}
+	}
+
+	void ScriptEngine::FreeSystems()
+	{
+		for (ScriptSystem& system : s_SEData->Systems)
+			mono_gchandle_free(system.GCHandle);
+		s_SEData->Systems.clear();
+	}
+
 	bool ScriptEngine::HasClass(const std::string& className, const std::string& namespaceName)
 	{
 		// Name formatting
@@ -306,21 +644,104 @@ namespace Locus
 		ScriptUtils::ProcessException((MonoException*)exception);
 	}
 
+	void ScriptEngine::DispatchCollisions(const entt::entity* entities, const entt::entity* others, const UUID* otherIDs, uint32_t beginCount, uint32_t count)
+	{
+		if (count == 0)
+			return;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		if (count > s_SEData->CollisionCapacity)
+		{
+			uint32_t capacity = std::max(count, s_SEData->CollisionCapacity * 2);
+			FreeCollisionArrays();
+			MonoClass* entityClass = s_SEData->EntityBaseClass->GetMonoClass();
+			s_SEData->CollisionEntitiesHandle = mono_gchandle_new((MonoObject*)mono_array_new(s_SEData->AppDomain, entityClass, capacity), false);
+			s_SEData->CollisionOtherEntitiesHandle = mono_gchandle_new((MonoObject*)mono_array_new(s_SEData->AppDomain, entityClass, capacity), false);
+			s_SEData->CollisionOtherIDsHandle = mono_gchandle_new((MonoObject*)mono_array_new(s_SEData->AppDomain, mono_get_uint64_class(), capacity), false);
+			s_SEData->CollisionOtherHandlesHandle = mono_gchandle_new((MonoObject*)mono_array_new(s_SEData->AppDomain, mono_get_uint32_class(), capacity), false);
+			s_SEData->CollisionCapacity = capacity;
+		}
+
+		MonoArray* entityArray = (MonoArray*)mono_gchandle_get_target(s_SEData->CollisionEntitiesHandle);
+		MonoArray* otherEntityArray = (MonoArray*)mono_gchandle_get_target(s_SEData->CollisionOtherEntitiesHandle);
+		MonoArray* otherIDArray = (MonoArray*)mono_gchandle_get_target(s_SEData->CollisionOtherIDsHandle);
+		MonoArray* otherHandleArray = (MonoArray*)mono_gchandle_get_target(s_SEData->CollisionOtherHandlesHandle);
+
+		// Entities whose script class failed to load have no instance and are skipped.
+		Scene* scene = s_SEData->Scene.get();
+		bool profiling = ScriptProfiler::IsActive();
+		uint32_t eventCount = 0, beginEventCount = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ScriptInstance* instance = (ScriptInstance*)Entity(entities[i], scene).GetComponent<ScriptComponent>().RuntimeInstance;
+			if (!instance)
+				continue;
+
+			// Scripts receive the other entity's own instance so no Entity is allocated for it. Others without
+			//	one are built in C# from their ID and handle.
+			ScriptInstance* otherInstance = nullptr;
+			Entity other = Entity(others[i], scene);
+			if (other.IsValid() && other.HasComponent<ScriptComponent>())
+				otherInstance = (ScriptInstance*)other.GetComponent<ScriptComponent>().RuntimeInstance;
+
+			mono_array_setref(entityArray, eventCount, mono_gchandle_get_target(instance->m_GCHandle));
+			mono_array_setref(otherEntityArray, eventCount, otherInstance ? mono_gchandle_get_target(otherInstance->m_GCHandle) : nullptr);
+			mono_array_set(otherIDArray, uint64_t, eventCount, (uint64_t)otherIDs[i]);
+			mono_array_set(otherHandleArray, uint32_t, eventCount, (uint32_t)others[i]);
+			if (profiling)
+				ScriptProfiler::AddCollisionEvents(instance->m_ProfileIndex, 1);
+			eventCount++;
+			if (i < beginCount)
+				beginEventCount++;
+		}
+
+		if (eventCount == 0)
+			return;
+
+		Timer dispatchTimer;
+		MonoException* exception = nullptr;
+		s_SEData->DispatchCollisionsFunc(entityArray, otherEntityArray, otherIDArray, otherHandleArray, (int)beginEventCount, (int)eventCount, &exception);
+		if (profiling)
+			ScriptProfiler::AddCollisionDispatch(dispatchTimer.ElapsedMillis());
+		ScriptUtils::ProcessException(exception);
+	}
+
 	// Getters
 	MonoImage* ScriptEngine::GetImage() { return s_SEData->CoreAssemblyImage; }
-	Ref<Scene> ScriptEngine::GetScene() { return s_SEData->Scene; }
+	const Ref<Scene>& ScriptEngine::GetScene() { return s_SEData->Scene; }
 	std::vector<std::string> ScriptEngine::GetClassNames() { return s_SEData->ScriptClassNames; }
 	Ref<ScriptClass> ScriptEngine::GetEntityBaseClass() { return s_SEData->EntityBaseClass; }
 	MonoDomain* ScriptEngine::GetAppDomain() { return s_SEData->AppDomain; }
 	std::queue<ExceptionData>& ScriptEngine::GetExceptions() { return s_SEData->Exceptions; }
-	std::map<std::string, ScriptClassFieldInstance>& ScriptEngine::GetFieldInstances(UUID id) { return s_SEData->FieldInstances[id]; }
+
+	ScriptFieldInstances& ScriptEngine::GetFieldInstances(UUID id, const Ref<ScriptClass>& scriptClass)
+	{
+		ScriptFieldInstances& fieldInstances = s_SEData->FieldInstances[id];
+		if (fieldInstances.Class != scriptClass)
+		{
+			fieldInstances.Class = scriptClass;
+			fieldInstances.Data = scriptClass ? scriptClass->GetFieldDefaults() : std::vector<uint8_t>();
+		}
+		return fieldInstances;
+	}
+
+	ScriptFieldInstances* ScriptEngine::FindFieldInstances(UUID id)
+	{
+		auto it = s_SEData->FieldInstances.find(id);
+		return it != s_SEData->FieldInstances.end() ? &it->second : nullptr;
+	}
+
+	void ScriptEngine::ClearFieldInstances(UUID id)
+	{
+		s_SEData->FieldInstances.erase(id);
+	}
 
 	Ref<ScriptClass> ScriptEngine::GetScriptClass(const std::string& name)
 	{
-		if (s_SEData->ScriptClasses.find(name) != s_SEData->ScriptClasses.end())
-			return s_SEData->ScriptClasses[name];
-		else
-			return nullptr;
+		// No operator[], so scene decoding can look up classes from worker threads.
+		auto it = s_SEData->ScriptClasses.find(name);
+		return it != s_SEData->ScriptClasses.end() ? it->second : nullptr;
 	}
 
 	Ref<ScriptInstance> ScriptEngine::GetScriptInstance(UUID id)
@@ -361,35 +782,80 @@ namespace Locus
 		return m_PublicFields[name];
 	}
 
-	bool ScriptClass::GetFieldValueInternal(const std::string& name, void* buffer)
+	std::string ScriptClass::GetFullName() const
+	{
+		if (m_NamespaceName.empty())
+			return m_ClassName;
+		return m_NamespaceName + "::" + m_ClassName;
+	}
+
+	void ScriptClass::BuildFieldLayout()
+	{
+		m_FieldLayout.clear();
+		uint32_t size = 0;
+		for (auto& [name, field] : m_PublicFields)
+		{
+			field.Index = (uint32_t)m_FieldLayout.size();
+			field.Offset = size;
+			field.Size = ScriptUtils::FieldTypeSize(field.Type);
+			size += field.Size;
+			m_FieldLayout.push_back(&field);
+		}
+		m_FieldDefaults.assign(size, 0);
+	}
+
+	void ScriptClass::CaptureFieldDefaults()
 	{
-		ScriptClassField& field = GetPublicField(name);
 		MonoObject* tempInstance = Instantiate();
 		unsigned int gchandle = mono_gchandle_new(tempInstance, false);
-		mono_field_get_value(mono_gchandle_get_target(gchandle), field.MonoField, buffer);
+		MonoObject* target = mono_gchandle_get_target(gchandle);
+		for (const ScriptClassField* field : m_FieldLayout)
+		{
+			// Reference type defaults stay zero, which is a null entity.
+			if (!ScriptUtils::IsValueFieldType(field->Type))
+				continue;
+			mono_field_get_value(target, field->MonoField, m_FieldDefaults.data() + field->Offset);
+		}
 		mono_gchandle_free(gchandle);
+	}
+
+	bool ScriptClass::GetFieldValueInternal(const std::string& name, void* buffer)
+	{
+		// Defaults are read from the blob so the editor never allocates managed objects.
+		ScriptClassField& field = GetPublicField(name);
+		memset(buffer, 0, 16);
+		if (field.Size > 0 && field.Offset + field.Size <= m_FieldDefaults.size())
+			memcpy(buffer, m_FieldDefaults.data() + field.Offset, field.Size);
 		return true;
 	}
 
 
 
 	// --- ScriptInstance -----------------------------------------------------
-	ScriptInstance::ScriptInstance(Ref<ScriptClass> scriptClass, UUID uuid)
-		: m_ScriptClass(scriptClass), m_UUID(uuid)
+	ScriptInstance::ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity)
+		: m_ScriptClass(scriptClass), m_UUID(entity.GetUUID())
 	{
 		// Use gchandle when creating or referencing instances. 
 		// MonoObject* instances are not handled and will result in errors.
 		m_GCHandle = mono_gchandle_new(m_ScriptClass->Instantiate(), false);
+		m_ProfileIndex = ScriptProfiler::AddClass(m_ScriptClass->GetFullName());
 
-		m_OnCreateFunc = m_ScriptClass->GetMethod("OnCreate", 0);
-		m_OnUpdateFunc = m_ScriptClass->GetMethod("OnUpdate", 1);
+		// Scripts are not required to implement OnCreate() or OnUpdate().
+		MonoMethod* onCreateFunc = m_ScriptClass->GetMethod("OnCreate", 0);
+		MonoMethod* onUpdateFunc = m_ScriptClass->GetMethod("OnUpdate", 1);
+		if (onCreateFunc)
+			m_OnCreateThunk = (OnCreateThunk)mono_method_get_unmanaged_thunk(onCreateFunc);
+		if (onUpdateFunc)
+			m_OnUpdateThunk = (OnUpdateThunk)mono_method_get_unmanaged_thunk(onUpdateFunc);
 
 		// Call Entity base class constructor
-		MonoMethod* entityBaseConstructor = s_SEData->EntityBaseClass->GetMethod(".ctor", 1);
+		// Passes the entt handle along with the UUID so internal calls can skip the UUID lookup.
+		MonoMethod* entityBaseConstructor = s_SEData->EntityBaseClass->GetMethod(".ctor", 2);
 		UUID id = m_UUID;
-		void* idPtr = &id;
+		uint32_t handle = (uint32_t)entity;
+		void* params[] = { &id, &handle };
 		MonoObject* exception = nullptr;
-		mono_runtime_invoke(entityBaseConstructor, mono_gchandle_get_target(m_GCHandle), &idPtr, &exception);
+		mono_runtime_invoke(entityBaseConstructor, mono_gchandle_get_target(m_GCHandle), params, &exception);
 		ScriptUtils::ProcessException((MonoException*)exception);
 	}
 
@@ -400,18 +866,21 @@ namespace Locus
 
 	void ScriptInstance::InvokeOnCreate()
 	{
-		OnCreateThunk testInteropThunk = (OnCreateThunk)mono_method_get_unmanaged_thunk(m_OnCreateFunc);
+		if (!m_OnCreateThunk)
+			return;
+		ScriptProfileScope profile(m_ProfileIndex, ScriptCallback::OnCreate);
 		MonoException* exception = nullptr;
-		testInteropThunk(mono_gchandle_get_target(m_GCHandle), &exception);
+		m_OnCreateThunk(mono_gchandle_get_target(m_GCHandle), &exception);
 		ScriptUtils::ProcessException(exception);
 	}
 
 	void ScriptInstance::InvokeOnUpdate(Timestep deltaTime)
 	{
-		// This is a more optimized way of calling functions. Need to profile to see if it actually works.
-		OnUpdateThunk testInteropThunk = (OnUpdateThunk)mono_method_get_unmanaged_thunk(m_OnUpdateFunc);
+		if (!m_OnUpdateThunk)
+			return;
+		ScriptProfileScope profile(m_ProfileIndex, ScriptCallback::OnUpdate);
 		MonoException* exception = nullptr;
-		testInteropThunk(mono_gchandle_get_target(m_GCHandle), deltaTime, &exception);
+		m_OnUpdateThunk(mono_gchandle_get_target(m_GCHandle), deltaTime, &exception);
 		ScriptUtils::ProcessException(exception);
 	}
 
@@ -428,4 +897,39 @@ namespace Locus
 		mono_field_set_value(mono_gchandle_get_target(m_GCHandle), field.MonoField, (void*)value);
 		return true;
 	}
+
+	void ScriptInstance::SetFieldValues(const ScriptFieldInstances& fieldInstances)
+	{
+		LOCUS_CORE_ASSERT(fieldInstances.Class == m_ScriptClass, "Field instances belong to another class!");
+		MonoObject* target = mono_gchandle_get_target(m_GCHandle);
+		const uint8_t* data = fieldInstances.Data.data();
+		MonoMethod* entityConstructor = nullptr;
+		for (const ScriptClassField* field : m_ScriptClass->GetFieldLayout())
+		{
+			if (ScriptUtils::IsValueFieldType(field->Type))
+			{
+				mono_field_set_value(target, field->MonoField, (void*)(data + field->Offset));
+			}
+			else if (field->Type == FieldType::LocusEntity)
+			{
+				// Same constructor as the script's own Entity base, so the field carries the entt handle too.
+				UUID id = *(const UUID*)(data + field->Offset);
+				Entity entity = id != 0 && s_SEData->Scene ? s_SEData->Scene->GetEntityByUUID(id) : Entity::Null;
+				MonoObject* entityObject = nullptr;
+				if (entity)
+				{
+					if (!entityConstructor)
+						entityConstructor = s_SEData->EntityBaseClass->GetMethod(".ctor", 2);
+					entityObject = s_SEData->EntityBaseClass->Instantiate();
+					uint32_t handle = (uint32_t)entity;
+					void* params[] = { &id, &handle };
+					MonoObject* exception = nullptr;
+					mono_runtime_invoke(entityConstructor, entityObject, params, &exception);
+					ScriptUtils::ProcessException((MonoException*)exception);
+				}
+				// Reference fields take the object pointer itself.
+				mono_field_set_value(target, field->MonoField, entityObject);
+			}
+		}
+	}
 }
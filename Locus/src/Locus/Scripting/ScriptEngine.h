@@ -1,6 +1,6 @@
 // --- ScriptEngine -----------------------------------------------------------
 // Contains: ScriptEngine, ScriptClass, ScriptInstance, ScriptClassField, 
-//	ScriptClassFieldInstance
+//	ScriptFieldInstances
 #pragma once
 
 #include "Locus/Core/Timestep.h"
@@ -16,6 +16,7 @@ extern "C" {
 	typedef struct _MonoAssembly MonoAssembly;
 	typedef struct _MonoDomain MonoDomain;
 	typedef struct _MonoClassField MonoClassField;
+	typedef struct _MonoException MonoException;
 }
 
 
@@ -24,6 +25,7 @@ namespace Locus
 	// Forward declarations
 	class ScriptClass;
 	class ScriptInstance;
+	struct ScriptAssemblyChanges;
 
 	enum class FieldType
 	{
@@ -61,42 +63,46 @@ namespace Locus
 		MonoClassField* MonoField;
 		std::string FieldName;
 		FieldType Type;
+		// Slot of the field in the class's field layout, and where its value is in a packed field blob.
+		uint32_t Index = 0;
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
 	};
 
 	// Field instance data. 
-	// ScriptClassFieldInstance is a struct for an instance of the field.
+	// ScriptFieldInstances holds the editor values of every public field of an
+	//	entity's script class, packed with the class's field layout.
 	//	Note that this struct has no relationships to a ScriptInstance. It is only
 	//	used during editor-time when ScriptInstances have not been created yet. 
 	//	Data is copied to the ScriptInstance fields once runtime starts.
-	struct ScriptClassFieldInstance
+	struct ScriptFieldInstances
 	{
-		ScriptClassField Field;
+		Ref<ScriptClass> Class;
+		std::vector<uint8_t> Data;
 
-		ScriptClassFieldInstance()
+		template<typename T>
+		T GetValue(const ScriptClassField& field) const
 		{
-			memset(m_Buffer, 0, sizeof(m_Buffer));
+			LOCUS_CORE_ASSERT(sizeof(T) <= field.Size && field.Offset + field.Size <= Data.size(), "Field is not stored in the blob!");
+			T value;
+			memcpy(&value, Data.data() + field.Offset, sizeof(T));
+			return value;
 		}
 
 		template<typename T>
-		T GetValue()
+		void SetValue(const ScriptClassField& field, const T& value)
 		{
-			static_assert(sizeof(T) <= 16, "Type too large!");
-			return *(T*)m_Buffer;
+			LOCUS_CORE_ASSERT(sizeof(T) <= field.Size && field.Offset + field.Size <= Data.size(), "Field is not stored in the blob!");
+			memcpy(Data.data() + field.Offset, &value, sizeof(T));
 		}
 
+		// Reference to the stored value for editor controls.
 		template<typename T>
-		void SetValue(T value)
+		T& GetValueRef(const ScriptClassField& field)
 		{
-			static_assert(sizeof(T) <= 16, "Type too large!");
-			memcpy(m_Buffer, &value, sizeof(T));
+			LOCUS_CORE_ASSERT(sizeof(T) <= field.Size && field.Offset + field.Size <= Data.size(), "Field is not stored in the blob!");
+			return *(T*)(Data.data() + field.Offset);
 		}
-
-	private:
-		uint8_t m_Buffer[16];
-
-		friend class ScriptEngine;
-		friend class ScriptInstance;
-		friend class PropertiesPanel;
 	};
 
 
@@ -115,29 +121,55 @@ namespace Locus
 		// Clears script instances
 		static void OnRuntimeStop();
 
+		// Creates the script instance and stores it in the entity's ScriptComponent.
 		static void OnCreateEntityScript(Entity entity);
+		// Prefer iterating ScriptComponents and calling InvokeOnUpdate() on their RuntimeInstance directly.
 		static void OnUpdateEntityScript(Entity entity, Timestep deltaTime);
+		// Creates one instance of every EntitySystem class and calls OnCreate().
+		static void OnCreateSystems();
+		// Calls OnUpdate() on every system once per frame.
+		static void OnUpdateSystems(Timestep deltaTime);
 
 		static bool HasClass(const std::string& className, const std::string& namespaceName = std::string());
 		static void InvokeMethod(Ref<ScriptInstance> instance, MonoMethod* method, void** params);
-
-		static void ReloadScripts();
+		// Sends collision events to C# in one call. The first beginCount events are OnCollisionBegin(), the rest OnCollisionEnd().
+		// Every entity must be valid and have a ScriptComponent. Others are passed as their script instance if they have one.
+		static void DispatchCollisions(const entt::entity* entities, const entt::entity* others, const UUID* otherIDs, uint32_t beginCount, uint32_t count);
+
+		// Reloads both assemblies from disk. Field instances of the scene's entities are kept.
+		static void ReloadScripts(Ref<Scene> scene = nullptr);
+		// Polls the assemblies for changes and reads them on a worker thread. Once read, reloads
+		//	if either assembly's contents changed. An assembly that fails to open keeps the current
+		//	scripts loaded until it is written again. Returns true if the scripts were reloaded.
+		//	Only call while no scene is running.
+		static bool CheckForChanges(Ref<Scene> scene = nullptr);
 
 		// Getters
 		static MonoImage* GetImage();
-		static Ref<Scene> GetScene();
+		static const Ref<Scene>& GetScene();
 		static std::vector<std::string> GetClassNames();
 		static Ref<ScriptClass> GetEntityBaseClass();
 		static MonoDomain* GetAppDomain();
 		static Ref<ScriptInstance> GetScriptInstance(UUID id);
 		static Ref<ScriptClass> GetScriptClass(const std::string& name);
-		static std::map<std::string, ScriptClassFieldInstance>& GetFieldInstances(UUID id);
+		// Returns the entity's field values. They are reset to the class defaults if they belong to another class.
+		static ScriptFieldInstances& GetFieldInstances(UUID id, const Ref<ScriptClass>& scriptClass);
+		// Returns nullptr if the entity has no field values.
+		static ScriptFieldInstances* FindFieldInstances(UUID id);
+		static void ClearFieldInstances(UUID id);
 		static std::queue<ExceptionData>& GetExceptions();
 
 	private:
-		static void LoadAssembly(const std::string& assemblyPath, bool loadPDB = false);
-		static void LoadAppAssembly(const std::string& assemblyPath, bool loadPDB = false);
+		static void ReadAssemblyFiles();
+		static void LoadAssemblies();
+		static bool ReloadAssemblies(Ref<Scene> scene, ScriptAssemblyChanges& changes);
+		static uint32_t RebindFieldInstances(Ref<Scene> scene);
+		static bool LoadAssembly(const std::string& assemblyPath, bool loadPDB = false);
+		static bool LoadAppAssembly(const std::string& assemblyPath, bool loadPDB = false);
 		static void LoadAppAssemblyClasses();
+		static void LoadCoreMethods();
+		static void FreeCollisionArrays();
+		static void FreeSystems();
 	};
 
 
@@ -158,9 +190,15 @@ namespace Locus
 
 		// Getters
 		MonoClass* GetMonoClass() const { return m_MonoClass; }
+		// Namespace::Class, or Class if it has no namespace.
+		std::string GetFullName() const;
 		MonoMethod* GetMethod(const std::string& name, int paramCount);
 		const std::map<std::string, ScriptClassField>& GetPublicFields() const { return m_PublicFields; }
 		ScriptClassField& GetPublicField(const std::string& name);
+		// Public fields ordered by ScriptClassField::Index.
+		const std::vector<const ScriptClassField*>& GetFieldLayout() const { return m_FieldLayout; }
+		// Default values of the public fields, packed with the field layout.
+		const std::vector<uint8_t>& GetFieldDefaults() const { return m_FieldDefaults; }
 
 		// Gets the default value of a C# field.
 		template<typename T>
@@ -174,6 +212,10 @@ namespace Locus
 		}
 
 	private:
+		// Assigns every public field a slot and an offset in the packed field blob.
+		void BuildFieldLayout();
+		// Reads the default of every public field from one temporary instance into m_FieldDefaults.
+		void CaptureFieldDefaults();
 		bool GetFieldValueInternal(const std::string& name, void* fieldValueBuffer);
 
 	private:
@@ -183,6 +225,9 @@ namespace Locus
 		std::string m_ClassName;
 
 		std::map<std::string, ScriptClassField> m_PublicFields;
+		std::vector<const ScriptClassField*> m_FieldLayout;
+		// Packed default values of the public fields, captured once when the assembly is loaded.
+		std::vector<uint8_t> m_FieldDefaults;
 
 	public:
 		friend class ScriptEngine;
@@ -195,11 +240,15 @@ namespace Locus
 	//	An instance is created from a ScriptClass and is tied to an Entity.
 	//	It holds a GCHandle which is the instance tied to the mono garbage
 	//	collector. This is used to reference the instance. Not with MonoObject*.
+	// Unmanaged thunks are resolved once per instance. Calling through them is much cheaper than mono_runtime_invoke.
+	typedef void (*OnCreateThunk)(MonoObject*, MonoException**);
+	typedef void (*OnUpdateThunk)(MonoObject*, float, MonoException**);
+
 	class ScriptInstance
 	{
 	public:
 		ScriptInstance() = default;
-		ScriptInstance(Ref<ScriptClass> scriptClass, UUID uuid);
+		ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity);
 		~ScriptInstance();
 
 		void InvokeOnCreate();
@@ -222,6 +271,11 @@ namespace Locus
 			SetFieldValueInternal(name, &value);
 		}
 
+		// Copies the editor values into the instance in one pass over the class's field layout.
+		//	Entity fields are stored as UUIDs and are assigned a managed Entity built from the scene's handle,
+		//	or null if the entity no longer exists. String fields are not applied.
+		void SetFieldValues(const ScriptFieldInstances& fieldInstances);
+
 	private:
 		bool GetFieldValueInternal(const std::string& name, void* buffer);
 		bool SetFieldValueInternal(const std::string& name, const void* value);
@@ -229,9 +283,10 @@ namespace Locus
 	private:
 		UUID m_UUID;
 		Ref<ScriptClass> m_ScriptClass;
-		MonoMethod* m_OnCreateFunc;
-		MonoMethod* m_OnUpdateFunc;
+		OnCreateThunk m_OnCreateThunk = nullptr;
+		OnUpdateThunk m_OnUpdateThunk = nullptr;
 		unsigned int m_GCHandle;
+		uint32_t m_ProfileIndex = 0;
 
 	public:
 		friend class ScriptEngine;
@@ -3,6 +3,7 @@
 
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
+#include <mono/metadata/object.h>
 
 #include "Locus/Scripting/ScriptEngine.h"
 #include "Locus/Scene/Entity.h"
@@ -21,6 +22,8 @@ namespace Locus
 
 		// Entity
 		LINK_INTERNAL_CALL(Entity_CreateEntity);
+		LINK_INTERNAL_CALL(Entity_GetHandle);
+		LINK_INTERNAL_CALL(Entity_IsValid);
 		LINK_INTERNAL_CALL(Entity_HasComponent);
 		LINK_INTERNAL_CALL(Entity_AddComponent);
 		LINK_INTERNAL_CALL(Entity_GetTag);
@@ -30,8 +33,13 @@ namespace Locus
 		LINK_INTERNAL_CALL(Entity_GetEnabled);
 		LINK_INTERNAL_CALL(Entity_SetEnabled);
 		LINK_INTERNAL_CALL(Entity_Find);
+		LINK_INTERNAL_CALL(Entity_FindAll);
+		LINK_INTERNAL_CALL(Entity_GetGroupEntities);
 		LINK_INTERNAL_CALL(Entity_Destroy);
 
+		// Scene
+		LINK_INTERNAL_CALL(Scene_QueryEntities);
+
 		// Vec2
 		LINK_INTERNAL_CALL(Vec2_Distance);
 		LINK_INTERNAL_CALL(Vec2_Length);
@@ -49,6 +57,12 @@ namespace Locus
 		LINK_INTERNAL_CALL(TransformComponent_GetLocalTransform);
 		LINK_INTERNAL_CALL(TransformComponent_GetWorldTransform);
 		LINK_INTERNAL_CALL(TransformComponent_GetWorldToLocal);
+		LINK_INTERNAL_CALL(TransformComponent_GetLocalPositions);
+		LINK_INTERNAL_CALL(TransformComponent_SetLocalPositions);
+		LINK_INTERNAL_CALL(TransformComponent_GetLocalRotationsEuler);
+		LINK_INTERNAL_CALL(TransformComponent_SetLocalRotationsEuler);
+		LINK_INTERNAL_CALL(TransformComponent_GetLocalScales);
+		LINK_INTERNAL_CALL(TransformComponent_SetLocalScales);
 		LINK_INTERNAL_CALL(TransformComponent_GetLocalPosition);
 		LINK_INTERNAL_CALL(TransformComponent_SetLocalPosition);
 		LINK_INTERNAL_CALL(TransformComponent_GetLocalRotationEuler);
@@ -59,6 +73,8 @@ namespace Locus
 		// Sprite Renderer Component
 		LINK_INTERNAL_CALL(SpriteRendererComponent_GetColor);
 		LINK_INTERNAL_CALL(SpriteRendererComponent_SetColor);
+		LINK_INTERNAL_CALL(SpriteRendererComponent_GetColors);
+		LINK_INTERNAL_CALL(SpriteRendererComponent_SetColors);
 		LINK_INTERNAL_CALL(SpriteRendererComponent_GetTilingFactor);
 		LINK_INTERNAL_CALL(SpriteRendererComponent_SetTilingFactor);
 
@@ -92,6 +108,13 @@ namespace Locus
 		LINK_INTERNAL_CALL(Rigidbody2DComponent_GetVelocity);
 		LINK_INTERNAL_CALL(Rigidbody2DComponent_SetVelocity);
 
+		// Physics2D
+		LINK_INTERNAL_CALL(Physics2D_Raycast);
+		LINK_INTERNAL_CALL(Physics2D_RaycastAll);
+		LINK_INTERNAL_CALL(Physics2D_OverlapAABB);
+		LINK_INTERNAL_CALL(Physics2D_OverlapCircle);
+		LINK_INTERNAL_CALL(Physics2D_OverlapBox);
+
 		// Input
 		LINK_INTERNAL_CALL(Input_IsKeyPressed);
 		LINK_INTERNAL_CALL(Input_IsKeyHeld);
@@ -115,12 +138,31 @@ namespace Locus
 		// Add to map
 		s_HasComponentFunctions[managedType] = [](Entity entity) { return entity.HasComponent<T>(); };
 		s_AddComponentFunctions[managedType] = [](Entity entity) { entity.AddOrReplaceComponent<T>(); };
+		s_QueryComponentFunctions[managedType] = [](Scene* scene, UUID* outIDs, uint32_t* outHandles, uint32_t capacity)
+		{
+			uint32_t count = 0;
+			auto view = scene->GetEntitiesWith<T>();
+			for (auto e : view)
+			{
+				Entity entity = Entity(e, scene);
+				if (!entity.GetComponent<TagComponent>().Enabled)
+					continue;
+				if (count < capacity)
+				{
+					outIDs[count] = entity.GetUUID();
+					outHandles[count] = (uint32_t)e;
+				}
+				count++;
+			}
+			return count;
+		};
 	}
 
 	void ScriptLink::RegisterComponents()
 	{
 		s_HasComponentFunctions.clear();
 		s_AddComponentFunctions.clear();
+		s_QueryComponentFunctions.clear();
 		RegisterComponent<IDComponent>();
 		RegisterComponent<TagComponent>();
 		RegisterComponent<TransformComponent>();
@@ -0,0 +1,179 @@
+#include "Lpch.h"
+#include "ScriptProfiler.h"
+
+#include <mono/metadata/mono-gc.h>
+
+namespace Locus
+{
+	static constexpr size_t s_CallbackCount = (size_t)ScriptCallback::Count;
+
+	struct ScriptProfilerData
+	{
+		bool Enabled = false;
+
+		std::vector<ScriptClassProfile> Classes;
+		// Stats of the frame in progress. Parallel to Classes.
+		std::vector<std::array<ScriptCallbackStats, s_CallbackCount>> Current;
+		std::vector<std::array<std::string, s_CallbackCount>> TraceNames;
+
+		ScriptCallbackStats CollisionDispatch;
+		ScriptCallbackStats CurrentCollisionDispatch;
+
+		ScriptGCStats GC;
+		uint32_t LastCollectionTotal = 0;
+	};
+
+	static ScriptProfilerData s_SPData;
+
+	namespace Utils
+	{
+		static const char* ScriptCallbackToString(ScriptCallback callback)
+		{
+			switch (callback)
+			{
+				case ScriptCallback::OnCreate:  return "OnCreate";
+				case ScriptCallback::OnUpdate:  return "OnUpdate";
+				case ScriptCallback::Collision: return "Collision";
+			}
+			return "Unknown";
+		}
+
+		static long long ToMicroseconds(std::chrono::time_point<std::chrono::high_resolution_clock> time)
+		{
+			return std::chrono::time_point_cast<std::chrono::microseconds>(time).time_since_epoch().count();
+		}
+	}
+
+	void ScriptProfiler::SetEnabled(bool enabled) { s_SPData.Enabled = enabled; }
+	bool ScriptProfiler::IsEnabled() { return s_SPData.Enabled; }
+	bool ScriptProfiler::IsActive() { return s_SPData.Enabled || LOCUS_PROFILE; }
+
+	void ScriptProfiler::Reset()
+	{
+		s_SPData.Classes.clear();
+		s_SPData.Current.clear();
+		s_SPData.TraceNames.clear();
+		s_SPData.CollisionDispatch = {};
+		s_SPData.CurrentCollisionDispatch = {};
+	}
+
+	uint32_t ScriptProfiler::AddClass(const std::string& className)
+	{
+		for (uint32_t i = 0; i < (uint32_t)s_SPData.Classes.size(); i++)
+		{
+			if (s_SPData.Classes[i].ClassName == className)
+				return i;
+		}
+
+		ScriptClassProfile profile;
+		profile.ClassName = className;
+		s_SPData.Classes.push_back(profile);
+		s_SPData.Current.push_back({});
+		auto& names = s_SPData.TraceNames.emplace_back();
+		for (size_t i = 0; i < s_CallbackCount; i++)
+			names[i] = className + "::" + Utils::ScriptCallbackToString((ScriptCallback)i);
+		return (uint32_t)s_SPData.Classes.size() - 1;
+	}
+
+	void ScriptProfiler::AddCall(uint32_t classIndex, ScriptCallback callback, float milliseconds)
+	{
+		if (classIndex >= s_SPData.Current.size())
+			return;
+		ScriptCallbackStats& stats = s_SPData.Current[classIndex][(size_t)callback];
+		stats.Milliseconds += milliseconds;
+		stats.Calls++;
+	}
+
+	void ScriptProfiler::AddCollisionEvents(uint32_t classIndex, uint32_t count)
+	{
+		if (classIndex >= s_SPData.Current.size())
+			return;
+		s_SPData.Current[classIndex][(size_t)ScriptCallback::Collision].Calls += count;
+	}
+
+	void ScriptProfiler::AddCollisionDispatch(float milliseconds)
+	{
+		s_SPData.CurrentCollisionDispatch.Milliseconds += milliseconds;
+		s_SPData.CurrentCollisionDispatch.Calls++;
+	}
+
+	void ScriptProfiler::EndFrame()
+	{
+		if (!IsActive())
+			return;
+
+		for (size_t i = 0; i < s_SPData.Classes.size(); i++)
+		{
+			ScriptClassProfile& profile = s_SPData.Classes[i];
+			for (size_t c = 0; c < s_CallbackCount; c++)
+			{
+				const ScriptCallbackStats& current = s_SPData.Current[i][c];
+				profile.Frame[c] = current;
+				profile.Total[c].Milliseconds += current.Milliseconds;
+				profile.Total[c].Calls += current.Calls;
+			}
+			s_SPData.Current[i] = {};
+		}
+		s_SPData.CollisionDispatch = s_SPData.CurrentCollisionDispatch;
+		s_SPData.CurrentCollisionDispatch = {};
+
+		// --- GC ---
+		ScriptGCStats& gc = s_SPData.GC;
+		int generations = mono_gc_max_generation() + 1;
+		gc.Collections.resize(generations);
+		uint32_t collectionTotal = 0;
+		for (int i = 0; i < generations; i++)
+		{
+			gc.Collections[i] = (uint32_t)mono_gc_collection_count(i);
+			collectionTotal += gc.Collections[i];
+		}
+		gc.FrameCollections = collectionTotal >= s_SPData.LastCollectionTotal ? collectionTotal - s_SPData.LastCollectionTotal : 0;
+		s_SPData.LastCollectionTotal = collectionTotal;
+		gc.HeapSize = mono_gc_get_heap_size();
+		gc.UsedSize = mono_gc_get_used_size();
+
+#if LOCUS_PROFILE
+		long long now = Utils::ToMicroseconds(std::chrono::high_resolution_clock::now());
+		Instrumentor::Get().WriteCounter("Mono GC Heap (KB)", now, (double)gc.UsedSize / 1024.0);
+		Instrumentor::Get().WriteCounter("Mono GC Collections", now, (double)collectionTotal);
+#endif
+	}
+
+	const std::vector<ScriptClassProfile>& ScriptProfiler::GetClassProfiles() { return s_SPData.Classes; }
+	const ScriptCallbackStats& ScriptProfiler::GetCollisionDispatchStats() { return s_SPData.CollisionDispatch; }
+	const ScriptGCStats& ScriptProfiler::GetGCStats() { return s_SPData.GC; }
+
+	const std::string& ScriptProfiler::GetTraceName(uint32_t classIndex, ScriptCallback callback)
+	{
+		return s_SPData.TraceNames[classIndex][(size_t)callback];
+	}
+
+
+
+	// --- ScriptProfileScope -------------------------------------------------
+	ScriptProfileScope::ScriptProfileScope(uint32_t classIndex, ScriptCallback callback)
+		: m_ClassIndex(classIndex), m_Callback(callback), m_Active(ScriptProfiler::IsActive())
+	{
+		if (m_Active)
+			m_Start = std::chrono::high_resolution_clock::now();
+	}
+
+	ScriptProfileScope::~ScriptProfileScope()
+	{
+		if (!m_Active)
+			return;
+
+		auto end = std::chrono::high_resolution_clock::now();
+		float milliseconds = std::chrono::duration<float, std::milli>(end - m_Start).count();
+		ScriptProfiler::AddCall(m_ClassIndex, m_Callback, milliseconds);
+
+#if LOCUS_PROFILE
+		if (m_ClassIndex < ScriptProfiler::GetClassProfiles().size())
+		{
+			uint32_t threadID = (uint32_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
+			Instrumentor::Get().WriteProfile({ ScriptProfiler::GetTraceName(m_ClassIndex, m_Callback),
+				Utils::ToMicroseconds(m_Start), Utils::ToMicroseconds(end), threadID });
+		}
+#endif
+	}
+}
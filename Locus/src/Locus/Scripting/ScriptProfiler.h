@@ -0,0 +1,81 @@
+// --- ScriptProfiler ---------------------------------------------------------
+// Measures time spent in C# script callbacks per script class along with the
+//	Mono GC collection counts and heap size. Timing is off until enabled from
+//	the editor. Builds with LOCUS_PROFILE always time callbacks and also write
+//	them to the instrumentation trace, with the GC stats as counter events.
+#pragma once
+
+namespace Locus
+{
+	enum class ScriptCallback
+	{
+		OnCreate = 0, OnUpdate, Collision, Count
+	};
+
+	struct ScriptCallbackStats
+	{
+		float Milliseconds = 0.0f;
+		uint32_t Calls = 0;
+	};
+
+	struct ScriptClassProfile
+	{
+		std::string ClassName;
+		// Last completed frame, and accumulated since the runtime started. Indexed by ScriptCallback.
+		// Collision events are dispatched to every class in one call, so only their count is known per class.
+		//	The time of the whole dispatch is in GetCollisionDispatchStats().
+		ScriptCallbackStats Frame[(size_t)ScriptCallback::Count];
+		ScriptCallbackStats Total[(size_t)ScriptCallback::Count];
+	};
+
+	struct ScriptGCStats
+	{
+		// Collections per generation since the domain was created.
+		std::vector<uint32_t> Collections;
+		// Collections of any generation during the last frame.
+		uint32_t FrameCollections = 0;
+		int64_t HeapSize = 0;
+		int64_t UsedSize = 0;
+	};
+
+	class ScriptProfiler
+	{
+	public:
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+		// True if callbacks should be timed.
+		static bool IsActive();
+
+		// Clears every class. Call before script instances are created.
+		static void Reset();
+		// Returns the index instances of the class report their calls with.
+		static uint32_t AddClass(const std::string& className);
+
+		static void AddCall(uint32_t classIndex, ScriptCallback callback, float milliseconds);
+		static void AddCollisionEvents(uint32_t classIndex, uint32_t count);
+		static void AddCollisionDispatch(float milliseconds);
+
+		// Publishes the stats of the frame and samples the GC.
+		static void EndFrame();
+
+		static const std::vector<ScriptClassProfile>& GetClassProfiles();
+		static const ScriptCallbackStats& GetCollisionDispatchStats();
+		static const ScriptGCStats& GetGCStats();
+		// Name written to the trace for a class callback.
+		static const std::string& GetTraceName(uint32_t classIndex, ScriptCallback callback);
+	};
+
+	// Times a script callback and reports it to the ScriptProfiler while profiling is active.
+	class ScriptProfileScope
+	{
+	public:
+		ScriptProfileScope(uint32_t classIndex, ScriptCallback callback);
+		~ScriptProfileScope();
+
+	private:
+		uint32_t m_ClassIndex;
+		ScriptCallback m_Callback;
+		bool m_Active;
+		std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
+	};
+}
@@ -55,6 +55,33 @@ namespace Locus
 			return FieldType::None;
 		}
 
+		uint32_t FieldTypeSize(FieldType type)
+		{
+			switch (type)
+			{
+				case FieldType::SystemSingle:  return 4;
+				case FieldType::SystemDouble:  return 8;
+				case FieldType::SystemShort:   return 2;
+				case FieldType::SystemInt:     return 4;
+				case FieldType::SystemLong:    return 8;
+				case FieldType::SystemUShort:  return 2;
+				case FieldType::SystemUInt:    return 4;
+				case FieldType::SystemULong:   return 8;
+				case FieldType::SystemBoolean: return 1;
+				case FieldType::SystemChar:    return 2;
+				case FieldType::LocusVec2:     return 8;
+				case FieldType::LocusVec3:     return 12;
+				case FieldType::LocusVec4:     return 16;
+				case FieldType::LocusEntity:   return 8;
+			}
+			return 0;
+		}
+
+		bool IsValueFieldType(FieldType type)
+		{
+			return type != FieldType::None && type != FieldType::SystemString && type != FieldType::LocusEntity;
+		}
+
 		bool CheckMonoError(MonoError& error)
 		{
 			bool hasError = !mono_error_ok(&error);
@@ -14,6 +14,10 @@ namespace Locus
 		char* ReadBytes(const std::string& filepath, uint32_t* outSize);
 
 		FieldType MonoTypeToFieldType(MonoType* monoType);
+		// Size of the field's value in a packed field blob. Entities are stored as their UUID. Strings are not stored.
+		uint32_t FieldTypeSize(FieldType type);
+		// True if Mono stores the field inline so it can be copied with mono_field_get_value and mono_field_set_value.
+		bool IsValueFieldType(FieldType type);
 
 		bool CheckMonoError(MonoError& error);
 
@@ -13,4 +13,26 @@ namespace Locus
 		static std::string OpenFile(const char* filter);
 		static std::string SaveFile(const char* filter);
 	};
+
+	// Read-only view of a whole file mapped into memory. Pages are loaded by the OS as they are touched.
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& filepath);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// False if the file doesn't exist, is empty or couldn't be mapped.
+		bool IsValid() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
 }
@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	// --- VertexBuffer -------------------------------------------------------
@@ -12,9 +14,15 @@ namespace Locus
 		LOCUS_PROFILE_FUNCTION();
 
 		// Generate, Bind, and define buffer data for vertices
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		RenderThread::Submit([handle, size]()
+			{
+				uint32_t rendererID;
+				glGenBuffers(1, &rendererID);
+				glBindBuffer(GL_ARRAY_BUFFER, rendererID);
+				glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
@@ -22,36 +30,60 @@ namespace Locus
 		LOCUS_PROFILE_FUNCTION();
 
 		// Generate, Bind, and define buffer data for vertices
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		const void* copy = RenderThread::CopyData(vertices, size);
+		RenderThread::Submit([handle, copy, size]()
+			{
+				uint32_t rendererID;
+				glGenBuffers(1, &rendererID);
+				glBindBuffer(GL_ARRAY_BUFFER, rendererID);
+				glBufferData(GL_ARRAY_BUFFER, size, copy, GL_STATIC_DRAW);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteBuffers(1, &rendererID);
+			});
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, *handle);
+			});
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]()
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+			});
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		RendererHandle handle = m_RendererID;
+		const void* copy = RenderThread::CopyData(data, size);
+		RenderThread::Submit([handle, copy, size]()
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, *handle);
+				glBufferSubData(GL_ARRAY_BUFFER, 0, size, copy);
+			});
 	}
 
 
@@ -62,35 +94,59 @@ namespace Locus
 		LOCUS_PROFILE_FUNCTION();
 
 		// Generate, Bind, and define buffer data for index buffers
-		glGenBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		const void* copy = RenderThread::CopyData(indices, count * sizeof(uint32_t));
+		RenderThread::Submit([handle, copy, count]()
+			{
+				uint32_t rendererID;
+				glGenBuffers(1, &rendererID);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID);
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), copy, GL_STATIC_DRAW);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteBuffers(1, &rendererID);
+			});
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *handle);
+			});
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]()
+			{
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			});
 	}
 
 	void OpenGLIndexBuffer::SetData(const void* data, uint32_t count)
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(uint32_t), data);
+		RendererHandle handle = m_RendererID;
+		const void* copy = RenderThread::CopyData(data, count * sizeof(uint32_t));
+		RenderThread::Submit([handle, copy, count]()
+			{
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *handle);
+				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(uint32_t), copy);
+			});
 	}
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Locus/Renderer/Buffer.h"
+#include "Locus/Renderer/RendererHandle.h"
 
 namespace Locus
 {
@@ -24,7 +25,7 @@ namespace Locus
 		virtual inline void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 		BufferLayout m_Layout;
 	};
 
@@ -44,6 +45,6 @@ namespace Locus
 		virtual inline uint32_t GetCount() const { return m_Count; }
 	private:
 		uint32_t m_Count;
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 	};
 }
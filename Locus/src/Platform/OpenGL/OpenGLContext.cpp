@@ -4,6 +4,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	OpenGLContext::OpenGLContext(GLFWwindow* windowHandle) : m_WindowHandle(windowHandle) 
@@ -32,6 +34,21 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glfwSwapBuffers(m_WindowHandle);
+		GLFWwindow* window = m_WindowHandle;
+		RenderThread::Submit([window]()
+			{
+				LOCUS_PROFILE_SCOPE("glfwSwapBuffers");
+				glfwSwapBuffers(window);
+			});
+	}
+
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::DetachCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
 	}
 }
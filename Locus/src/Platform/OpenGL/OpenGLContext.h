@@ -15,6 +15,9 @@ namespace Locus
 
 		virtual void Init() override;
 		virtual void SwapBuffers() override;
+
+		virtual void MakeCurrent() override;
+		virtual void DetachCurrent() override;
 	private:
 		GLFWwindow* m_WindowHandle;
 	};
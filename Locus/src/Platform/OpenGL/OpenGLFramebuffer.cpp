@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	static const uint32_t s_MaxFramebufferSize = 8192;
@@ -18,106 +20,133 @@ namespace Locus
 				m_DepthAttachmentSpecification = spec;
 		}
 
+		m_Objects = CreateRef<FramebufferObjects>();
+		m_PixelReadback = CreateRef<PixelReadback>();
+
 		Refresh();
 	}
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
 	{
-		glDeleteFramebuffers(1, &m_RendererID);
-		glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
-		glDeleteTextures(1, &m_DepthAttachment);
+		Ref<FramebufferObjects> objects = m_Objects;
+		RenderThread::Submit([objects]()
+			{
+				glDeleteFramebuffers(1, &objects->RendererID);
+				glDeleteTextures((GLsizei)objects->ColorAttachments.size(), objects->ColorAttachments.data());
+				glDeleteTextures(1, &objects->DepthAttachment);
+			});
+
+		Ref<PixelReadback> readback = m_PixelReadback;
+		RenderThread::Submit([readback]()
+			{
+				if (readback->Fence)
+					glDeleteSync((GLsync)readback->Fence);
+				glDeleteBuffers(1, &readback->PixelPackBuffer);
+			});
 	}
 
 	void OpenGLFramebuffer::Refresh()
 	{
-		if (m_RendererID)
-		{
-			glDeleteFramebuffers(1, &m_RendererID);
-			glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
-			glDeleteTextures(1, &m_DepthAttachment);
-
-			m_ColorAttachments.clear();
-			m_DepthAttachment = 0;
-		}
+		// Recreated without waiting. GetColorAttachmentRendererID() waits if it is called before this has run.
+		uint32_t refresh = ++m_Refresh;
+		Ref<FramebufferObjects> objects = m_Objects;
+		FramebufferSpecification specification = m_Specification;
+		std::vector<FramebufferTextureSpecification> colorSpecifications = m_ColorAttachmentSpecifications;
+		FramebufferTextureSpecification depthSpecification = m_DepthAttachmentSpecification;
+		RenderThread::Submit([objects, refresh, specification, colorSpecifications, depthSpecification]()
+			{
+				std::vector<uint32_t>& colorAttachments = objects->ColorAttachments;
+				if (objects->RendererID)
+				{
+					glDeleteFramebuffers(1, &objects->RendererID);
+					glDeleteTextures((GLsizei)colorAttachments.size(), colorAttachments.data());
+					glDeleteTextures(1, &objects->DepthAttachment);
 
-		glCreateFramebuffers(1, &m_RendererID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+					colorAttachments.clear();
+					objects->DepthAttachment = 0;
+				}
 
-		GLenum textureTarget = m_Specification.Samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+				glCreateFramebuffers(1, &objects->RendererID);
+				glBindFramebuffer(GL_FRAMEBUFFER, objects->RendererID);
 
-		// Color attachment
-		if (m_ColorAttachmentSpecifications.size())
-		{
-			m_ColorAttachments.resize(m_ColorAttachmentSpecifications.size());
-			glCreateTextures(textureTarget, (GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
+				GLenum textureTarget = specification.Samples > 1 ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
-			for (size_t i = 0; i < m_ColorAttachments.size(); i++)
-			{
-				glBindTexture(textureTarget, m_ColorAttachments[i]);
+				// Color attachment
+				if (colorSpecifications.size())
+				{
+					colorAttachments.resize(colorSpecifications.size());
+					glCreateTextures(textureTarget, (GLsizei)colorAttachments.size(), colorAttachments.data());
+
+					for (size_t i = 0; i < colorAttachments.size(); i++)
+					{
+						glBindTexture(textureTarget, colorAttachments[i]);
+
+						switch (colorSpecifications[i].TextureFormat)
+						{
+							case FramebufferTextureFormat::RGBA8:
+								if (textureTarget == GL_TEXTURE_2D_MULTISAMPLE)
+									glTexImage2DMultisample(textureTarget, specification.Samples, GL_RGBA8, specification.Width, specification.Height, GL_FALSE);
+								else
+									glTexImage2D(textureTarget, 0, GL_RGBA8, specification.Width, specification.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+								break;
+
+							case FramebufferTextureFormat::RED_INT:
+								glTexImage2D(textureTarget, 0, GL_R32I, specification.Width, specification.Height, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+								break; 
+						}
+
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+						glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + (GLenum)i, textureTarget, colorAttachments[i], 0);
+					}
+				}
 
-				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
+				// Depth attachment
+				if (depthSpecification.TextureFormat != FramebufferTextureFormat::None)
 				{
-					case FramebufferTextureFormat::RGBA8:
+					glCreateTextures(textureTarget, 1, &objects->DepthAttachment);
+					glBindTexture(textureTarget, objects->DepthAttachment);
+
+					switch (depthSpecification.TextureFormat)
+					{
+					case FramebufferTextureFormat::DEPTH24STENCIL8:
 						if (textureTarget == GL_TEXTURE_2D_MULTISAMPLE)
-							glTexImage2DMultisample(textureTarget, m_Specification.Samples, GL_RGBA8, m_Specification.Width, m_Specification.Height, GL_FALSE);
+							glTexImage2DMultisample(textureTarget, specification.Samples, GL_DEPTH24_STENCIL8, specification.Width, specification.Height, GL_FALSE);
 						else
-							glTexImage2D(textureTarget, 0, GL_RGBA8, m_Specification.Width, m_Specification.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+							glTexStorage2D(textureTarget, 1, GL_DEPTH24_STENCIL8, specification.Width, specification.Height);
 						break;
+					}
+
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-					case FramebufferTextureFormat::RED_INT:
-						glTexImage2D(textureTarget, 0, GL_R32I, m_Specification.Width, m_Specification.Height, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
-						break; 
+					glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, textureTarget, objects->DepthAttachment, 0);
 				}
 
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				if (colorAttachments.size() > 1)
+				{
+					LOCUS_CORE_ASSERT(colorAttachments.size() <= 4, "Color Attachment failed");
+					GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
+					glDrawBuffers((GLsizei)colorAttachments.size(), buffers);
+				}
+				else if (colorAttachments.empty())
+				{
+					glDrawBuffer(GL_NONE);
+				}
 
-				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + (GLenum)i, textureTarget, m_ColorAttachments[i], 0);
-			}
-		}
+				LOCUS_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
-		// Depth attachment
-		if (m_DepthAttachmentSpecification.TextureFormat != FramebufferTextureFormat::None)
-		{
-			glCreateTextures(textureTarget, 1, &m_DepthAttachment);
-			glBindTexture(textureTarget, m_DepthAttachment);
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-			switch (m_DepthAttachmentSpecification.TextureFormat)
-			{
-			case FramebufferTextureFormat::DEPTH24STENCIL8:
-				if (textureTarget == GL_TEXTURE_2D_MULTISAMPLE)
-					glTexImage2DMultisample(textureTarget, m_Specification.Samples, GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height, GL_FALSE);
-				else
-					glTexStorage2D(textureTarget, 1, GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height);
-				break;
-			}
-
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, textureTarget, m_DepthAttachment, 0);
-		}
-
-		if (m_ColorAttachments.size() > 1)
-		{
-			LOCUS_CORE_ASSERT(m_ColorAttachments.size() <= 4, "Color Attachment failed");
-			GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
-			glDrawBuffers((GLsizei)m_ColorAttachments.size(), buffers);
-		}
-		else if (m_ColorAttachments.empty())
-		{
-			glDrawBuffer(GL_NONE);
-		}
-
-		LOCUS_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
-
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+				objects->CompletedRefresh = refresh;
+			});
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -134,44 +163,145 @@ namespace Locus
 		Refresh();
 	}
 
+	uint32_t OpenGLFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
+	{
+		LOCUS_CORE_ASSERT(index < m_ColorAttachmentSpecifications.size(), "No Color Attachments!");
+
+		if (m_Objects->CompletedRefresh != m_Refresh && RenderThread::IsRunning() && !RenderThread::IsRenderThread())
+			RenderThread::Flush();
+		return m_Objects->ColorAttachments[index];
+	}
+
 	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
 	{
-		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment Index out of bounds!");
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
-		int pixelData;
-		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "Attachment Index out of bounds!");
+		int pixelData = -1;
+		Ref<FramebufferObjects> objects = m_Objects;
+		RenderThread::SubmitAndWait([objects, attachmentIndex, x, y, &pixelData]()
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, objects->RendererID);
+				glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+				glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			});
 		return pixelData;
 	}
 
+	void OpenGLFramebuffer::RequestPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "Attachment Index out of bounds!");
+
+		uint32_t request = ++m_PixelRequest;
+		m_PixelRequestPending = true;
+
+		// Copies into a pixel pack buffer so glReadPixels returns without waiting for the GPU.
+		Ref<FramebufferObjects> objects = m_Objects;
+		Ref<PixelReadback> readback = m_PixelReadback;
+		RenderThread::Submit([readback, request, objects, attachmentIndex, x, y]()
+			{
+				if (!readback->PixelPackBuffer)
+				{
+					glCreateBuffers(1, &readback->PixelPackBuffer);
+					glNamedBufferData(readback->PixelPackBuffer, sizeof(int), nullptr, GL_STREAM_READ);
+				}
+				if (readback->Fence)
+					glDeleteSync((GLsync)readback->Fence);
+
+				glBindFramebuffer(GL_FRAMEBUFFER, objects->RendererID);
+				glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->PixelPackBuffer);
+				glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+				readback->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				readback->FenceRequest = request;
+			});
+	}
+
+	bool OpenGLFramebuffer::GetRequestedPixel(int& outPixel)
+	{
+		if (!m_PixelRequestPending)
+			return false;
+
+		if (m_PixelReadback->CompletedRequest == m_PixelRequest)
+		{
+			outPixel = m_PixelReadback->Pixel;
+			m_PixelRequestPending = false;
+			return true;
+		}
+
+		// Poll the fence without blocking. The result is picked up on a later call.
+		Ref<PixelReadback> readback = m_PixelReadback;
+		RenderThread::Submit([readback]()
+			{
+				if (!readback->Fence)
+					return;
+
+				GLenum status = glClientWaitSync((GLsync)readback->Fence, 0, 0);
+				if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+					return;
+
+				int pixel = -1;
+				glGetNamedBufferSubData(readback->PixelPackBuffer, 0, sizeof(int), &pixel);
+				glDeleteSync((GLsync)readback->Fence);
+				readback->Fence = nullptr;
+				readback->Pixel = pixel;
+				readback->CompletedRequest = readback->FenceRequest;
+			});
+
+		return false;
+	}
+
 	void OpenGLFramebuffer::BindTexture(uint32_t attachmentIndex)
 	{
-		glBindTextureUnit(0, m_ColorAttachments[attachmentIndex]);
+		Ref<FramebufferObjects> objects = m_Objects;
+		RenderThread::Submit([objects, attachmentIndex]()
+			{
+				glBindTextureUnit(0, objects->ColorAttachments[attachmentIndex]);
+			});
 	}
 
 	void OpenGLFramebuffer::ClearAttachmentInt(uint32_t attachmentIndex, int value)
 	{
-		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index out of bounds!");
+		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "Attachment index out of bounds!");
 
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, GL_RED_INTEGER, GL_INT, &value);
+		Ref<FramebufferObjects> objects = m_Objects;
+		RenderThread::Submit([objects, attachmentIndex, value]()
+			{
+				glClearTexImage(objects->ColorAttachments[attachmentIndex], 0, GL_RED_INTEGER, GL_INT, &value);
+			});
 	}
 
 	void OpenGLFramebuffer::ClearAttachmentColor(uint32_t attachmentIndex, const glm::vec4& value)
 	{
-		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index out of bounds!");
+		LOCUS_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "Attachment index out of bounds!");
 
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, GL_RGBA, GL_FLOAT , &value);
+		Ref<FramebufferObjects> objects = m_Objects;
+		RenderThread::Submit([objects, attachmentIndex, value]()
+			{
+				glClearTexImage(objects->ColorAttachments[attachmentIndex], 0, GL_RGBA, GL_FLOAT, &value);
+			});
 	}
 
 	void OpenGLFramebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		Ref<FramebufferObjects> objects = m_Objects;
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		RenderThread::Submit([objects, width, height]()
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, objects->RendererID);
+				glViewport(0, 0, width, height);
+			});
 	}
 
 	void OpenGLFramebuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		RenderThread::Submit([]()
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			});
 	}
 }
@@ -2,10 +2,36 @@
 // OpenGL framebuffer class.
 #pragma once
 
+#include <atomic>
+
 #include "Locus/Renderer/Framebuffer.h"
 
 namespace Locus
 {
+	// Pixel pack buffer and fence for asynchronous pixel reads. GL objects are only touched on the render thread,
+	// the result is handed back through the atomics.
+	struct PixelReadback
+	{
+		uint32_t PixelPackBuffer = 0;
+		void* Fence = nullptr;
+		uint32_t FenceRequest = 0;
+
+		// Id of the request whose result is stored in Pixel. Stale results of replaced requests are ignored.
+		std::atomic<uint32_t> CompletedRequest = 0;
+		std::atomic<int> Pixel = -1;
+	};
+
+	// GL objects of a framebuffer. Refresh() recreates them on the render thread, recorded commands read them when
+	// they execute. The main thread only reads them once CompletedRefresh has caught up with the last refresh.
+	struct FramebufferObjects
+	{
+		uint32_t RendererID = 0;
+		std::vector<uint32_t> ColorAttachments;
+		uint32_t DepthAttachment = 0;
+
+		std::atomic<uint32_t> CompletedRefresh = 0;
+	};
+
 	class OpenGLFramebuffer : public Framebuffer
 	{
 	public:
@@ -19,26 +45,28 @@ namespace Locus
 
 		virtual void Resize(uint32_t width, uint32_t height) override;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+		virtual void RequestPixel(uint32_t attachmentIndex, int x, int y) override;
+		virtual bool GetRequestedPixel(int& outPixel) override;
 		virtual void BindTexture(uint32_t attachmentIndex) override;
 
 		virtual void ClearAttachmentInt(uint32_t attachmentIndex, int value) override;
 		virtual void ClearAttachmentColor(uint32_t attachmentIndex, const glm::vec4& value) override;
 
-		virtual inline uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override 
-		{
-			LOCUS_CORE_ASSERT(index < m_ColorAttachments.size(), "No Color Attachments!");
-			return m_ColorAttachments[index];
-		}
+		// Waits for the render thread only if the attachments are still being recreated.
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
 		virtual inline const FramebufferSpecification& GetSpecification() const { return m_Specification; }
 
 	private:
-		uint32_t m_RendererID = 0;
 		FramebufferSpecification m_Specification;
 		
 		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
 		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
 
-		std::vector<uint32_t> m_ColorAttachments;
-		uint32_t m_DepthAttachment = 0;
+		// Shared with recorded commands so they stay valid if the framebuffer is destroyed first.
+		Ref<FramebufferObjects> m_Objects;
+		Ref<PixelReadback> m_PixelReadback;
+		uint32_t m_Refresh = 0;
+		uint32_t m_PixelRequest = 0;
+		bool m_PixelRequestPending = false;
 	};
 }
@@ -1,6 +1,8 @@
 #include "Lpch.h"
 #include "OpenGLRendererAPI.h"
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	static void OpenGLMessageCallback( unsigned source, unsigned type, unsigned id, unsigned severity,
@@ -21,70 +23,111 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		#ifdef LOCUS_DEBUG
-			glEnable(GL_DEBUG_OUTPUT);
-			glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-			glDebugMessageCallback(OpenGLMessageCallback, nullptr);
-			glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
-		#endif
+		RenderThread::Submit([]()
+			{
+				#ifdef LOCUS_DEBUG
+					glEnable(GL_DEBUG_OUTPUT);
+					glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+					glDebugMessageCallback(OpenGLMessageCallback, nullptr);
+					glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+				#endif
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				glEnable(GL_BLEND);
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_LINE_SMOOTH);
+				glEnable(GL_DEPTH_TEST);
+				glEnable(GL_LINE_SMOOTH);
 
-		glEnable(GL_CULL_FACE);
+				glEnable(GL_CULL_FACE);
+			});
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4 color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		RenderThread::Submit([color]()
+			{
+				glClearColor(color.r, color.g, color.b, color.a);
+			});
 	}
 
 	void OpenGLRendererAPI::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		RenderThread::Submit([]()
+			{
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
 	{
-		vertexArray->Bind();
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		RenderThread::Submit([vertexArray, count]()
+			{
+				vertexArray->Bind();
+				glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawArray(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
 	{
-		vertexArray->Bind();
-		glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+		RenderThread::Submit([vertexArray, vertexCount]()
+			{
+				vertexArray->Bind();
+				glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t instanceBase)
 	{
-		vertexArray->Bind();
-		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount, instanceBase);
+		RenderThread::Submit([vertexArray, indexCount, instanceCount, instanceBase]()
+			{
+				vertexArray->Bind();
+				glDrawElementsInstancedBaseInstance(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount, instanceBase);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawArrayInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t instanceBase)
 	{
-		vertexArray->Bind();
-		glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, vertexCount, instanceCount, instanceBase);
+		RenderThread::Submit([vertexArray, vertexCount, instanceCount, instanceBase]()
+			{
+				vertexArray->Bind();
+				glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, vertexCount, instanceCount, instanceBase);
+			});
 	}
 
 	void OpenGLRendererAPI::DrawLine(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
 	{
-		vertexArray->Bind();
-		glDrawArrays(GL_LINES, 0, vertexCount);
+		RenderThread::Submit([vertexArray, vertexCount]()
+			{
+				vertexArray->Bind();
+				glDrawArrays(GL_LINES, 0, vertexCount);
+			});
 	}
 
 	void OpenGLRendererAPI::Resize(int x, int y, int width, int height)
 	{
-		glViewport(x, y, width, height);
+		RenderThread::Submit([x, y, width, height]()
+			{
+				glViewport(x, y, width, height);
+			});
 	}
 
 	void OpenGLRendererAPI::SetLineWidth(float width)
 	{
-		glLineWidth(width);
+		RenderThread::Submit([width]()
+			{
+				glLineWidth(width);
+			});
+	}
+
+	void OpenGLRendererAPI::SetFaceCulling(bool enabled)
+	{
+		RenderThread::Submit([enabled]()
+			{
+				if (enabled)
+					glEnable(GL_CULL_FACE);
+				else
+					glDisable(GL_CULL_FACE);
+			});
 	}
 }
@@ -30,6 +30,8 @@ namespace Locus
 		virtual void Resize(int x, int y, int width, int height) override;
 
 		virtual void SetLineWidth(float width) override;
+
+		virtual void SetFaceCulling(bool enabled) override;
 	};
 
 }
@@ -2,6 +2,7 @@
 #include "OpenGLShader.h"
 
 #include <fstream>
+#include <future>
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -9,7 +10,9 @@
 #include <spirv_cross/spirv_cross.hpp>
 #include <spirv_cross/spirv_glsl.hpp>
 
+#include "Locus/Core/Hash.h"
 #include "Locus/Core/Timer.h"
+#include "Locus/Renderer/RenderThread.h"
 
 namespace Locus
 {
@@ -83,31 +86,96 @@ namespace Locus
 			LOCUS_CORE_ASSERT(false, "GLShaderStageCachedVulkanFileExtensions() failed");
 			return "";
 		}
+
+		static std::string ShaderNameFromFilePath(const std::string& filepath)
+		{
+			auto lastSlash = filepath.find_last_of("/\\");
+			lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+			auto lastDot = filepath.rfind('.');
+			auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+			return filepath.substr(lastSlash, count);
+		}
+
+		// --- Cache keys -----------------------------------------------------
+		// Bump these when the compile options below change so old cache entries are not reused.
+		static constexpr const char* VulkanCompileOptions = "v1;vulkan_1_2;optimization_performance";
+		static constexpr const char* OpenGLCompileOptions = "v1;opengl_4_5";
+
+		static constexpr uint32_t ProgramBinaryMagic = 0x4250534C; // "LSPB"
+
+		struct ProgramBinaryHeader
+		{
+			uint32_t Magic = 0;
+			uint32_t Format = 0;
+			uint64_t DriverHash = 0;
+		};
+
+		static uint64_t HashString(const std::string& str, uint64_t seed = s_HashSeed)
+		{
+			return HashBytes(str.data(), str.size(), seed);
+		}
+
+		// Program binaries are only valid for the driver that produced them.
+		static uint64_t GetDriverHash()
+		{
+			static uint64_t driverHash = []()
+			{
+				std::string driver = (const char*)glGetString(GL_VENDOR);
+				driver += (const char*)glGetString(GL_RENDERER);
+				driver += (const char*)glGetString(GL_VERSION);
+				return HashString(driver);
+			}();
+			return driverHash;
+		}
+
+		static std::filesystem::path GetCachedFilePath(const std::string& cacheName, uint64_t hash, const char* extension)
+		{
+			return std::filesystem::path(GetCacheDirectory()) / fmt::format("{0}.{1:016x}{2}", cacheName, hash, extension);
+		}
+
+		static bool ReadBinaryCache(const std::filesystem::path& path, std::vector<uint32_t>& outData)
+		{
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (!in.is_open())
+				return false;
+
+			in.seekg(0, std::ios::end);
+			auto size = in.tellg();
+			in.seekg(0, std::ios::beg);
+
+			outData.resize(size / sizeof(uint32_t));
+			in.read((char*)outData.data(), size);
+			return true;
+		}
+
+		static void WriteBinaryCache(const std::filesystem::path& path, const std::vector<uint32_t>& data)
+		{
+			std::ofstream out(path, std::ios::out | std::ios::binary);
+			if (out.is_open())
+			{
+				out.write((char*)data.data(), data.size() * sizeof(uint32_t));
+				out.flush();
+				out.close();
+			}
+		}
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& filepath)
-		: m_FilePath(filepath)
+	OpenGLShader::OpenGLShader(const std::string& filepath, const ShaderDefines& defines)
+		: m_FilePath(filepath), m_Defines(defines)
 	{
 		LOCUS_PROFILE_FUNCTION();
 
 		Utils::CreateCacheDirectoryIfNeeded();
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
 		{
 			Timer timer;
-			CompileOrGetVulkanBinaries(shaderSources);
-			CompileOrGetOpenGLBinaries();
+			bool compiled = Compile();
+			LOCUS_CORE_ASSERT(compiled, "Shader compilation failed!");
 			CreateProgram();
 			LOCUS_CORE_WARN("Shader creation took {0} ms", timer.ElapsedMillis());
 		}
 
-		// Extract name from filepath
-		auto lastSlash = filepath.find_last_of("/\\");
-		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
-		auto lastDot = filepath.rfind('.');
-		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
-		m_Name = filepath.substr(lastSlash, count);
+		m_Name = Utils::ShaderNameFromFilePath(filepath);
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -115,12 +183,13 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		std::unordered_map<GLenum, std::string> sources;
-		sources[GL_VERTEX_SHADER] = vertexSrc;
-		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
+		Utils::CreateCacheDirectoryIfNeeded();
+
+		m_ShaderSources[GL_VERTEX_SHADER] = vertexSrc;
+		m_ShaderSources[GL_FRAGMENT_SHADER] = fragmentSrc;
 		
-		CompileOrGetVulkanBinaries(sources);
-		CompileOrGetOpenGLBinaries();
+		bool compiled = Compile();
+		LOCUS_CORE_ASSERT(compiled, "Shader compilation failed!");
 		CreateProgram();
 	}
 
@@ -128,7 +197,124 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glDeleteProgram(m_RendererID);
+		// The link command recorded by CreateProgram() references this shader, so it has to run first.
+		m_RendererID.Get();
+
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteProgram(rendererID);
+			});
+	}
+
+	std::vector<Ref<Shader>> OpenGLShader::CreateBatch(const std::vector<std::string>& filepaths)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		Utils::CreateCacheDirectoryIfNeeded();
+
+		Timer timer;
+		std::vector<Ref<OpenGLShader>> shaders;
+		std::vector<std::future<bool>> compileTasks;
+		for (const auto& filepath : filepaths)
+		{
+			Ref<OpenGLShader> shader(new OpenGLShader());
+			shader->m_FilePath = filepath;
+			shader->m_Name = Utils::ShaderNameFromFilePath(filepath);
+			compileTasks.push_back(std::async(std::launch::async, &OpenGLShader::Compile, shader.get()));
+			shaders.push_back(shader);
+		}
+
+		// Linking needs the GL context so it happens on the render thread once the SPIR-V is ready.
+		// All programs are linked by a single command that nothing waits for.
+		std::vector<Ref<Shader>> result;
+		std::vector<RendererHandle> handles;
+		for (size_t i = 0; i < shaders.size(); i++)
+		{
+			bool compiled = compileTasks[i].get();
+			LOCUS_CORE_ASSERT(compiled, "Shader compilation failed!");
+			handles.push_back(shaders[i]->m_RendererID = RendererHandle::Pending());
+			result.push_back(shaders[i]);
+		}
+		RenderThread::Submit([shaders, handles]()
+			{
+				for (size_t i = 0; i < shaders.size(); i++)
+					handles[i].Set(shaders[i]->LinkProgram());
+			});
+		LOCUS_CORE_WARN("Shader batch creation ({0} shaders) took {1} ms", shaders.size(), timer.ElapsedMillis());
+
+		return result;
+	}
+
+	void OpenGLShader::ReloadAsync()
+	{
+		if (m_FilePath.empty())
+			return;
+
+		// Already compiling or linking. Compile again once the current reload finishes so the latest edit wins.
+		if (m_ReloadShader)
+		{
+			m_ReloadPending = true;
+			return;
+		}
+
+		m_ReloadShader = Ref<OpenGLShader>(new OpenGLShader());
+		m_ReloadShader->m_FilePath = m_FilePath;
+		m_ReloadShader->m_Name = m_Name;
+		m_ReloadShader->m_Defines = m_Defines;
+		m_ReloadTimer.Reset();
+		m_ReloadTask = std::async(std::launch::async, &OpenGLShader::Compile, m_ReloadShader.get());
+	}
+
+	bool OpenGLShader::ApplyReload()
+	{
+		if (!m_ReloadShader)
+			return false;
+
+		if (m_ReloadTask.valid())
+		{
+			if (m_ReloadTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+
+			// Records the link. The result is checked on a later call so this never waits for the render thread.
+			if (m_ReloadTask.get())
+				m_ReloadShader->CreateProgram();
+		}
+
+		if (m_ReloadShader->m_RendererID.IsPending())
+			return false;
+
+		LOCUS_PROFILE_FUNCTION();
+
+		bool swapped = false;
+		if (*m_ReloadShader->m_RendererID)
+		{
+			// Commands recorded earlier this frame still reference the old program, so delete it in order.
+			RendererHandle oldHandle = m_RendererID;
+			RenderThread::Submit([oldHandle]()
+				{
+					uint32_t oldRendererID = *oldHandle;
+					glDeleteProgram(oldRendererID);
+				});
+			m_RendererID = m_ReloadShader->m_RendererID;
+			m_ReloadShader->m_RendererID = RendererHandle();
+			swapped = true;
+			LOCUS_CORE_INFO("Reloaded shader {0} in {1} ms", m_Name, m_ReloadTimer.ElapsedMillis());
+		}
+		else
+		{
+			LOCUS_CORE_ERROR("Failed to reload shader {0}. Keeping the previous program.", m_Name);
+		}
+		m_ReloadShader.reset();
+
+		if (m_ReloadPending)
+		{
+			m_ReloadPending = false;
+			ReloadAsync();
+		}
+
+		return swapped;
 	}
 
 	std::string OpenGLShader::ReadFile(const std::string& path)
@@ -180,118 +366,188 @@ namespace Locus
 		return shaderSources;
 	}
 
-	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources)
+	bool OpenGLShader::Compile()
 	{
-		GLuint program = glCreateProgram();
+		LOCUS_PROFILE_FUNCTION();
+
+		if (!m_FilePath.empty())
+			m_ShaderSources = PreProcess(ReadFile(m_FilePath));
+
+		if (m_ShaderSources.empty())
+		{
+			LOCUS_CORE_ERROR("Shader has no stages ({0})", GetCacheName());
+			return false;
+		}
 
-		shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
-		//options.AddMacroDefinition("OPENGL");
-		options.SetOptimizationLevel(shaderc_optimization_level_performance);
+		// Cache keys. The OpenGL key chains off the Vulkan key so a source, define or option change invalidates both.
+		uint64_t definesSeed = Utils::HashString(Utils::VulkanCompileOptions);
+		for (const auto& define : m_Defines)
+			definesSeed = Utils::HashString(define + ";", definesSeed);
 
-		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
+		m_VulkanHashes.clear();
+		m_OpenGLHashes.clear();
+		m_ProgramHash = 0;
+		for (auto&& [stage, source] : m_ShaderSources)
+		{
+			uint64_t stageSeed = Utils::HashBytes(&stage, sizeof(GLenum), definesSeed);
+			uint64_t vulkanHash = Utils::HashString(source, stageSeed);
+			uint64_t openGLHash = Utils::HashString(Utils::OpenGLCompileOptions, vulkanHash);
+			m_VulkanHashes[stage] = vulkanHash;
+			m_OpenGLHashes[stage] = openGLHash;
+			m_ProgramHash ^= openGLHash;
+		}
 
 		m_VulkanSPIRV.clear();
-		for (auto&& [stage, source] : shaderSources)
+		m_OpenGLSPIRV.clear();
+		m_OpenGLSourceCode.clear();
+
+		// A cached program binary skips SPIR-V entirely. If the driver rejects it, LinkProgram() compiles then.
+		if (std::filesystem::exists(Utils::GetCachedFilePath(GetCacheName(), m_ProgramHash, ".cached_program")))
+			return true;
+
+		return CompileOrGetVulkanBinaries() && CompileOrGetOpenGLBinaries();
+	}
+
+	bool OpenGLShader::CompileOrGetVulkanBinaries()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		std::string cacheName = GetCacheName();
+
+		// Stages are compiled in parallel. Each task only writes to its own pre-inserted binary.
+		std::vector<std::future<bool>> tasks;
+		m_VulkanSPIRV.clear();
+		for (const auto& pair : m_ShaderSources)
 		{
-			std::filesystem::path shaderFilePath = m_FilePath;
-			std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedVulkanFileExtension(stage));
+			GLenum stage = pair.first;
+			const std::string& source = pair.second;
+			uint64_t hash = m_VulkanHashes.at(stage);
+			std::vector<uint32_t>& data = m_VulkanSPIRV[stage];
 
-			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-			if (in.is_open())
+			tasks.push_back(std::async(std::launch::async, [this, stage, hash, &source, &data, &cacheName]()
 			{
-				in.seekg(0, std::ios::end);
-				auto size = in.tellg();
-				in.seekg(0, std::ios::beg);
+				LOCUS_PROFILE_SCOPE("OpenGLShader::CompileVulkanStage");
+
+				std::filesystem::path cachedPath = Utils::GetCachedFilePath(cacheName, hash, Utils::GLShaderStageCachedVulkanFileExtension(stage));
+				if (Utils::ReadBinaryCache(cachedPath, data))
+					return true;
+
+				shaderc::Compiler compiler;
+				shaderc::CompileOptions options;
+				options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+				//options.AddMacroDefinition("OPENGL");
+				options.SetOptimizationLevel(shaderc_optimization_level_performance);
+				for (const auto& define : m_Defines)
+				{
+					size_t equals = define.find('=');
+					if (equals == std::string::npos)
+						options.AddMacroDefinition(define);
+					else
+						options.AddMacroDefinition(define.substr(0, equals), define.substr(equals + 1));
+				}
 
-				auto& data = m_VulkanSPIRV[stage];
-				data.resize(size / sizeof(uint32_t));
-				in.read((char*)data.data(), size);
-			}
-			else
-			{
-				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str(), options);
+				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), cacheName.c_str(), options);
 				if (module.GetCompilationStatus() != shaderc_compilation_status_success)
 				{
 					LOCUS_CORE_ERROR(module.GetErrorMessage());
-					LOCUS_CORE_ASSERT(false, "ShaderC compilation failed!");
+					return false;
 				}
 
-				m_VulkanSPIRV[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+				data = std::vector<uint32_t>(module.cbegin(), module.cend());
+				Utils::WriteBinaryCache(cachedPath, data);
+				return true;
+			}));
+		}
+
+		bool success = true;
+		for (auto& task : tasks)
+			success &= task.get();
 
-				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-				if (out.is_open())
-				{
-					auto& data = m_VulkanSPIRV[stage];
-					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-					out.flush();
-					out.close();
-				}
-			}
+		if (success)
+		{
+			for (auto&& [stage, data] : m_VulkanSPIRV)
+				Reflect(stage, data);
 		}
 
-		for (auto&& [stage, data] : m_VulkanSPIRV)
-			Reflect(stage, data);
+		return success;
 	}
 
-	void OpenGLShader::CompileOrGetOpenGLBinaries()
+	bool OpenGLShader::CompileOrGetOpenGLBinaries()
 	{
-		shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-		options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
-		options.SetOptimizationLevel(shaderc_optimization_level_performance);
+		LOCUS_PROFILE_FUNCTION();
 
-		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
+		std::string cacheName = GetCacheName();
 
+		std::vector<std::future<bool>> tasks;
 		m_OpenGLSPIRV.clear();
 		m_OpenGLSourceCode.clear();
-		for (auto&& [stage, spirv] : m_VulkanSPIRV)
+		for (const auto& pair : m_VulkanSPIRV)
 		{
-			std::filesystem::path shaderFilePath = m_FilePath;
-			std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+			GLenum stage = pair.first;
+			const std::vector<uint32_t>& spirv = pair.second;
+			uint64_t hash = m_OpenGLHashes.at(stage);
+			std::vector<uint32_t>& data = m_OpenGLSPIRV[stage];
+			std::string& glslSource = m_OpenGLSourceCode[stage];
 
-			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-			if (in.is_open())
+			tasks.push_back(std::async(std::launch::async, [stage, hash, &spirv, &data, &glslSource, &cacheName]()
 			{
-				in.seekg(0, std::ios::end);
-				auto size = in.tellg();
-				in.seekg(0, std::ios::beg);
+				LOCUS_PROFILE_SCOPE("OpenGLShader::CompileOpenGLStage");
+
+				std::filesystem::path cachedPath = Utils::GetCachedFilePath(cacheName, hash, Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+				if (Utils::ReadBinaryCache(cachedPath, data))
+					return true;
 
-				auto& data = m_OpenGLSPIRV[stage];
-				data.resize(size / sizeof(uint32_t));
-				in.read((char*)data.data(), size);
-			}
-			else
-			{
 				spirv_cross::CompilerGLSL glslCompiler(spirv);
-				m_OpenGLSourceCode[stage] = glslCompiler.compile();
-				auto& source = m_OpenGLSourceCode[stage];
+				glslSource = glslCompiler.compile();
+
+				shaderc::Compiler compiler;
+				shaderc::CompileOptions options;
+				options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
+				options.SetOptimizationLevel(shaderc_optimization_level_performance);
 
-				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str());
+				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(glslSource, Utils::GLShaderStageToShaderC(stage), cacheName.c_str());
 				if (module.GetCompilationStatus() != shaderc_compilation_status_success)
 				{
 					LOCUS_CORE_ERROR(module.GetErrorMessage());
-					LOCUS_CORE_ASSERT(false, "ShaderC compilation failed!");
+					return false;
 				}
 
-				m_OpenGLSPIRV[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
-
-				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-				if (out.is_open())
-				{
-					auto& data = m_OpenGLSPIRV[stage];
-					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-					out.flush();
-					out.close();
-				}
-			}
+				data = std::vector<uint32_t>(module.cbegin(), module.cend());
+				Utils::WriteBinaryCache(cachedPath, data);
+				return true;
+			}));
 		}
+
+		bool success = true;
+		for (auto& task : tasks)
+			success &= task.get();
+
+		return success;
 	}
 
 	void OpenGLShader::CreateProgram()
 	{
-		GLuint program = glCreateProgram();
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		RenderThread::Submit([this, handle]()
+			{
+				handle.Set(LinkProgram());
+			});
+	}
+
+	uint32_t OpenGLShader::LinkProgram()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		GLuint program = LoadProgramBinary();
+		if (program)
+			return program;
+
+		// No usable program binary. Fall back to the SPIR-V path.
+		if (m_OpenGLSPIRV.empty() && !(CompileOrGetVulkanBinaries() && CompileOrGetOpenGLBinaries()))
+			return 0;
+
+		program = glCreateProgram();
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 		std::vector<GLuint> shaderIDs;
 		for (auto&& [stage, spirv] : m_OpenGLSPIRV)
@@ -313,12 +569,14 @@ namespace Locus
 
 			std::vector<GLchar> infoLog(maxLength);
 			glGetProgramInfoLog(program, maxLength, &maxLength, infoLog.data());
-			LOCUS_CORE_ERROR("Shader linking failed ({0}):\n{1}", m_FilePath, infoLog.data());
+			LOCUS_CORE_ERROR("Shader linking failed ({0}):\n{1}", GetCacheName(), infoLog.data());
 
 			glDeleteProgram(program);
 
 			for (auto id : shaderIDs)
 				glDeleteShader(id);
+
+			return 0;
 		}
 
 		for (auto id : shaderIDs)
@@ -327,7 +585,78 @@ namespace Locus
 			glDeleteShader(id);
 		}
 
-		m_RendererID = program;
+		SaveProgramBinary(program);
+
+		return program;
+	}
+
+	uint32_t OpenGLShader::LoadProgramBinary()
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		std::ifstream in(Utils::GetCachedFilePath(GetCacheName(), m_ProgramHash, ".cached_program"), std::ios::in | std::ios::binary);
+		if (!in.is_open())
+			return 0;
+
+		Utils::ProgramBinaryHeader header;
+		in.read((char*)&header, sizeof(Utils::ProgramBinaryHeader));
+		if (!in || header.Magic != Utils::ProgramBinaryMagic || header.DriverHash != Utils::GetDriverHash())
+			return 0;
+
+		std::vector<char> binary((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, (GLenum)header.Format, binary.data(), (GLsizei)binary.size());
+
+		GLint isLinked;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+
+	void OpenGLShader::SaveProgramBinary(uint32_t program)
+	{
+		LOCUS_PROFILE_FUNCTION();
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount == 0)
+			return;
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length == 0)
+			return;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+		Utils::ProgramBinaryHeader header;
+		header.Magic = Utils::ProgramBinaryMagic;
+		header.Format = format;
+		header.DriverHash = Utils::GetDriverHash();
+
+		std::ofstream out(Utils::GetCachedFilePath(GetCacheName(), m_ProgramHash, ".cached_program"), std::ios::out | std::ios::binary);
+		if (out.is_open())
+		{
+			out.write((char*)&header, sizeof(Utils::ProgramBinaryHeader));
+			out.write(binary.data(), binary.size());
+			out.flush();
+			out.close();
+		}
+	}
+
+	std::string OpenGLShader::GetCacheName() const
+	{
+		if (m_FilePath.empty())
+			return m_Name;
+		return std::filesystem::path(m_FilePath).filename().string();
 	}
 
 	void OpenGLShader::Reflect(GLenum stage, const std::vector<uint32_t>& shaderData)
@@ -358,13 +687,20 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glUseProgram(m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				glUseProgram(*handle);
+			});
 	}
 
 	void OpenGLShader::Unbind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glUseProgram(0);
+		RenderThread::Submit([]()
+			{
+				glUseProgram(0);
+			});
 	}
 }
@@ -1,9 +1,15 @@
 // --- OpenGlShader -----------------------------------------------------------
 // OpenGL Shader class. Creates OpenGL shaders with GLSL source data.
 // Can either read from file or from string.
+// Compiled SPIR-V and linked program binaries are cached in
+// resources/cache/shader/opengl keyed by a hash of the source and compile
+// options, so edited shaders never load stale binaries.
 #pragma once
 
+#include <future>
+
 #include "Locus/Renderer/Shader.h"
+#include "Locus/Renderer/RendererHandle.h"
 
 typedef unsigned int GLenum;
 
@@ -13,30 +19,65 @@ namespace Locus
 	{
 	public:
 		OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
-		OpenGLShader(const std::string& filepath);
+		OpenGLShader(const std::string& filepath, const ShaderDefines& defines = {});
 		~OpenGLShader();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual inline const std::string& GetName() const override { return m_Name; }
+		virtual inline const std::string& GetFilePath() const override { return m_FilePath; }
+
+		virtual void ReloadAsync() override;
+		virtual bool ApplyReload() override;
+
+		// Compiles the SPIR-V of every shader on worker threads. Programs are linked on the render thread.
+		static std::vector<Ref<Shader>> CreateBatch(const std::vector<std::string>& filepaths);
 
 	private:
+		OpenGLShader() = default;
+
 		std::string ReadFile(const std::string& path);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
-		void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources);
-		void CompileOrGetOpenGLBinaries();
+
+		// Reads and hashes the sources and produces SPIR-V binaries. Does not touch the GL context so
+		// it is safe to call from worker threads.
+		bool Compile();
+		bool CompileOrGetVulkanBinaries();
+		bool CompileOrGetOpenGLBinaries();
+		// Records the link on the render thread. m_RendererID stays pending until it has run.
 		void CreateProgram();
+		// Links the program and returns it, or 0 on failure. Must be called on the thread that owns the GL context.
+		uint32_t LinkProgram();
+		// Returns a linked program from the program binary cache or 0 if there is no valid entry.
+		uint32_t LoadProgramBinary();
+		void SaveProgramBinary(uint32_t program);
 		void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
 
+		std::string GetCacheName() const;
+
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 		std::string m_Name;
 		std::string m_FilePath;
+		ShaderDefines m_Defines;
+
+		std::unordered_map<GLenum, std::string> m_ShaderSources;
+		std::unordered_map<GLenum, uint64_t> m_VulkanHashes;
+		std::unordered_map<GLenum, uint64_t> m_OpenGLHashes;
+		uint64_t m_ProgramHash = 0;
 
 		std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
 		std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
 
 		std::unordered_map<GLenum, std::string> m_OpenGLSourceCode; // Debug purpose
+
+		// --- Hot reload ---
+		// The staging shader is compiled on a worker thread and its program is moved into this shader.
+		// m_ReloadTask is declared last so it is destroyed (and waited on) before the staging shader.
+		Ref<OpenGLShader> m_ReloadShader;
+		bool m_ReloadPending = false;
+		Timer m_ReloadTimer;
+		std::future<bool> m_ReloadTask;
 	};
 }
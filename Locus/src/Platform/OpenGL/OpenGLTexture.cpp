@@ -3,6 +3,8 @@
 
 #include <stb_image.h>
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height) : m_Width(width), m_Height(height)
@@ -12,13 +14,20 @@ namespace Locus
 		m_InternalFormat = GL_RGBA8;
 		m_DataFormat = GL_RGBA;
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		GLenum internalFormat = m_InternalFormat;
+		RenderThread::Submit([handle, internalFormat, width, height]()
+			{
+				uint32_t rendererID;
+				glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+				glTextureStorage2D(rendererID, 1, internalFormat, width, height);
+
+				glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+				glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, uint32_t rendererID)
@@ -29,10 +38,13 @@ namespace Locus
 		m_InternalFormat = 0;
 		m_DataFormat = 0;
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		RenderThread::Submit([rendererID]()
+			{
+				glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+				glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			});
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::filesystem::path& path) : m_Path(path)
@@ -82,34 +94,51 @@ namespace Locus
 
 		LOCUS_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
 		
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_2D, m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
-		glBindTexture(GL_TEXTURE_2D, 0);
-
-		stbi_image_free(data);
+		// Decoding stays on this thread, only the upload runs on the render thread. The command owns the
+		// decoded pixels and frees them after the upload.
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		RenderThread::Submit([handle, internalFormat, dataFormat, width, height, data]()
+			{
+				uint32_t rendererID;
+				glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+				glBindTexture(GL_TEXTURE_2D, rendererID);
+				glTextureStorage2D(rendererID, 1, internalFormat, width, height);
+				glGenerateMipmap(GL_TEXTURE_2D);
+
+				glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+				glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+				glTextureSubImage2D(rendererID, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
+				glBindTexture(GL_TEXTURE_2D, 0);
+				handle.Set(rendererID);
+
+				stbi_image_free(data);
+			});
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteTextures(1, &rendererID);
+			});
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([slot, handle]()
+			{
+				glBindTextureUnit(slot, *handle);
+			});
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -118,7 +147,14 @@ namespace Locus
 
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		LOCUS_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture");
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		RendererHandle handle = m_RendererID;
+		uint32_t width = m_Width, height = m_Height;
+		GLenum dataFormat = m_DataFormat;
+		const void* copy = RenderThread::CopyData(data, size);
+		RenderThread::Submit([handle, width, height, dataFormat, copy]()
+			{
+				glTextureSubImage2D(*handle, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, copy);
+			});
 	}
 
 	const std::string OpenGLTexture2D::GetTextureName() const
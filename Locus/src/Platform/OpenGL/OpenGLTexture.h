@@ -5,6 +5,7 @@
 #include <glad/glad.h>
 
 #include "Locus/Renderer/Texture.h"
+#include "Locus/Renderer/RendererHandle.h"
 
 namespace Locus
 {
@@ -23,19 +24,23 @@ namespace Locus
 		virtual inline uint32_t GetHeight() const override { return m_Height; }
 		virtual inline void SetWidth(uint32_t width) override { m_Width = width; }
 		virtual inline void SetHeight(uint32_t height) override { m_Height = height; }
-		virtual inline uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual inline uint32_t GetRendererID() const override { return m_RendererID.Get(); }
 		virtual inline const std::filesystem::path& GetTexturePath() const override { return m_Path; }
 		virtual const std::string GetTextureName() const override;
 
 		virtual bool operator==(const Texture& other) const override
 		{
-			return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
+			// Compares names without waiting. A texture still being created only equals itself.
+			const RendererHandle& otherID = ((OpenGLTexture2D&)other).m_RendererID;
+			if (m_RendererID == otherID)
+				return true;
+			return !m_RendererID.IsPending() && !otherID.IsPending() && *m_RendererID == *otherID;
 		}
 
 	private:
 		std::filesystem::path m_Path;
 		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID = 0;
+		RendererHandle m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
 	};
 }
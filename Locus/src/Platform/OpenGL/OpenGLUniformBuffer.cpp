@@ -4,6 +4,7 @@
 #include <glad/glad.h>
 
 #include "Locus/Renderer/Renderer.h"
+#include "Locus/Renderer/RenderThread.h"
 
 namespace Locus
 {
@@ -15,18 +16,34 @@ namespace Locus
 		else
 			LOCUS_CORE_ASSERT(false, "UBO binding occupied!");
 
-		glCreateBuffers(1, &m_RendererID);
-		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
-		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		RenderThread::Submit([handle, size, binding]()
+			{
+				uint32_t rendererID;
+				glCreateBuffers(1, &rendererID);
+				glNamedBufferData(rendererID, size, nullptr, GL_DYNAMIC_DRAW);
+				glBindBufferBase(GL_UNIFORM_BUFFER, binding, rendererID);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLUniformBuffer::~OpenGLUniformBuffer()
 	{
-		glDeleteBuffers(1, &m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteBuffers(1, &rendererID);
+			});
 	}
 
 	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		glNamedBufferSubData(m_RendererID, offset, size, data);
+		RendererHandle handle = m_RendererID;
+		const void* copy = RenderThread::CopyData(data, size);
+		RenderThread::Submit([handle, copy, size, offset]()
+			{
+				glNamedBufferSubData(*handle, offset, size, copy);
+			});
 	}
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Locus/Renderer/UniformBuffer.h"
+#include "Locus/Renderer/RendererHandle.h"
 
 namespace Locus
 {
@@ -14,6 +15,6 @@ namespace Locus
 
 		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
 	private:
-		uint32_t m_RendererID = 0;
+		RendererHandle m_RendererID;
 	};
 }
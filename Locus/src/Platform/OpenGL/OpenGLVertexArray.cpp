@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "Locus/Renderer/RenderThread.h"
+
 namespace Locus
 {
 	static GLenum ShaderDataTypeToOpenGLBaseType(ShaderDataType type)
@@ -30,28 +32,46 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glGenVertexArrays(1, &m_RendererID);
+		RendererHandle handle = m_RendererID = RendererHandle::Pending();
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID;
+				glGenVertexArrays(1, &rendererID);
+				handle.Set(rendererID);
+			});
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glDeleteVertexArrays(1, &m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				uint32_t rendererID = *handle;
+				glDeleteVertexArrays(1, &rendererID);
+			});
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle]()
+			{
+				glBindVertexArray(*handle);
+			});
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		RenderThread::Submit([]()
+			{
+				glBindVertexArray(0);
+			});
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -60,86 +80,100 @@ namespace Locus
 
 		LOCUS_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "VertexBuffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
-		vertexBuffer->Bind();
-
-		const auto& layout = vertexBuffer->GetLayout();
-
+		// Attribute indices are assigned here so the recorded command does not touch members.
+		RendererHandle handle = m_RendererID;
+		uint32_t startIndex = m_VertexBufferIndex;
+		BufferLayout layout = vertexBuffer->GetLayout();
 		for (const auto& element : layout)
-		{
-			switch (element.Type)
+			m_VertexBufferIndex += element.Type == ShaderDataType::Mat4 ? 4 : 1;
+
+		RenderThread::Submit([handle, startIndex, layout, vertexBuffer]()
 			{
-				case ShaderDataType::Int:
-				case ShaderDataType::Int2:
-				case ShaderDataType::Int3:
-				case ShaderDataType::Int4:
-				case ShaderDataType::Bool:
-				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-
-					glVertexAttribIPointer(m_VertexBufferIndex, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.Type), 
-						layout.GetStride(), (const void*)(size_t)element.Offset);
-					if (element.Instanced)
-						glVertexAttribDivisor(m_VertexBufferIndex, element.Instanced);
-					m_VertexBufferIndex++;
-					break;
-				}
-				case ShaderDataType::Float:
-				case ShaderDataType::Float2:
-				case ShaderDataType::Float3:
-				case ShaderDataType::Float4:
-				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-
-					glVertexAttribPointer(m_VertexBufferIndex, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)(size_t)element.Offset);
-					if (element.Instanced)
-						glVertexAttribDivisor(m_VertexBufferIndex, element.Instanced);
-					m_VertexBufferIndex++;
-					break;
-				}
-				case ShaderDataType::Mat4:
+				glBindVertexArray(*handle);
+				vertexBuffer->Bind();
+
+				uint32_t index = startIndex;
+				for (const auto& element : layout)
 				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-					glEnableVertexAttribArray(m_VertexBufferIndex + 1);
-					glEnableVertexAttribArray(m_VertexBufferIndex + 2);
-					glEnableVertexAttribArray(m_VertexBufferIndex + 3);
-					glVertexAttribPointer(m_VertexBufferIndex + 0, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)(size_t)element.Offset);
-					glVertexAttribPointer(m_VertexBufferIndex + 1, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 4)));
-					glVertexAttribPointer(m_VertexBufferIndex + 2, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 8)));
-					glVertexAttribPointer(m_VertexBufferIndex + 3, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 12)));
-
-					if (element.Instanced)
+					switch (element.Type)
 					{
-						glVertexAttribDivisor(m_VertexBufferIndex, element.Instanced);
-						glVertexAttribDivisor(m_VertexBufferIndex + 1, element.Instanced);
-						glVertexAttribDivisor(m_VertexBufferIndex + 2, element.Instanced);
-						glVertexAttribDivisor(m_VertexBufferIndex + 3, element.Instanced);
-					}
+						case ShaderDataType::Int:
+						case ShaderDataType::Int2:
+						case ShaderDataType::Int3:
+						case ShaderDataType::Int4:
+						case ShaderDataType::Bool:
+						{
+							glEnableVertexAttribArray(index);
+
+							glVertexAttribIPointer(index, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.Type), 
+								layout.GetStride(), (const void*)(size_t)element.Offset);
+							if (element.Instanced)
+								glVertexAttribDivisor(index, element.Instanced);
+							index++;
+							break;
+						}
+						case ShaderDataType::Float:
+						case ShaderDataType::Float2:
+						case ShaderDataType::Float3:
+						case ShaderDataType::Float4:
+						{
+							glEnableVertexAttribArray(index);
+
+							glVertexAttribPointer(index, element.GetComponentCount(), ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)(size_t)element.Offset);
+							if (element.Instanced)
+								glVertexAttribDivisor(index, element.Instanced);
+							index++;
+							break;
+						}
+						case ShaderDataType::Mat4:
+						{
+							glEnableVertexAttribArray(index);
+							glEnableVertexAttribArray(index + 1);
+							glEnableVertexAttribArray(index + 2);
+							glEnableVertexAttribArray(index + 3);
+							glVertexAttribPointer(index + 0, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)(size_t)element.Offset);
+							glVertexAttribPointer(index + 1, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 4)));
+							glVertexAttribPointer(index + 2, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 8)));
+							glVertexAttribPointer(index + 3, 4, ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), (const void*)((size_t)element.Offset + (sizeof(float) * 12)));
+
+							if (element.Instanced)
+							{
+								glVertexAttribDivisor(index, element.Instanced);
+								glVertexAttribDivisor(index + 1, element.Instanced);
+								glVertexAttribDivisor(index + 2, element.Instanced);
+								glVertexAttribDivisor(index + 3, element.Instanced);
+							}
 					
 					
-					m_VertexBufferIndex += 4;
-					break;
+							index += 4;
+							break;
+						}
+						default: LOCUS_CORE_ASSERT(false, "Unknown ShaderDataType!");
+					}
 				}
-				default: LOCUS_CORE_ASSERT(false, "Unknown ShaderDataType!");
-			}
-		}
+				glBindVertexArray(0);
+			});
+
 		m_VertexBuffers.push_back(vertexBuffer);
-		glBindVertexArray(0);
 	}
 
 	void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
-		indexBuffer->Bind();
+		RendererHandle handle = m_RendererID;
+		RenderThread::Submit([handle, indexBuffer]()
+			{
+				glBindVertexArray(*handle);
+				indexBuffer->Bind();
+				glBindVertexArray(0);
+			});
 
 		m_IndexBuffer = indexBuffer;
-		glBindVertexArray(0);
 	}
 }
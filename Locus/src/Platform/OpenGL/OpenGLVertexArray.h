@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Locus/Renderer/VertexArray.h"
+#include "Locus/Renderer/RendererHandle.h"
 
 namespace Locus
 {
@@ -22,7 +23,7 @@ namespace Locus
 		virtual inline const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
 
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 		uint32_t m_VertexBufferIndex = 0;
 
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
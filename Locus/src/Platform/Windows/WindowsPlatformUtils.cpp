@@ -49,4 +49,40 @@ namespace Locus
 		}
 		return std::string();
 	}
+
+
+
+	// --- MappedFile ---------------------------------------------------------
+	MappedFile::MappedFile(const std::string& filepath)
+	{
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+		m_FileHandle = file;
+
+		LARGE_INTEGER size;
+		// Empty files can't be mapped.
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			return;
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+			return;
+		m_MappingHandle = mapping;
+
+		m_Data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (m_Data)
+			m_Size = (uint64_t)size.QuadPart;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+	}
 }
@@ -9,6 +9,7 @@
 #include "Locus/Events/KeyEvent.h"
 #include "Locus/Events/Event.h"
 #include "Locus/Renderer/Renderer.h"
+#include "Locus/Renderer/RenderThread.h"
 
 namespace Locus
 {
@@ -188,10 +189,11 @@ namespace Locus
 	{
 		LOCUS_PROFILE_FUNCTION();
 
-		if (enabled)
-			glfwSwapInterval(1);
-		else
-			glfwSwapInterval(0);
+		// Swap interval applies to the thread the context is current on.
+		RenderThread::Submit([enabled]()
+			{
+				glfwSwapInterval(enabled ? 1 : 0);
+			});
 
 		m_Data.VSync = enabled;
 	}
@@ -29,6 +29,7 @@ namespace Locus
 		virtual bool IsVSync() const override;
 
 		inline virtual void* GetNativeWindow() const { return m_Window; }
+		inline virtual GraphicsContext& GetContext() override { return *m_Context; }
 
 	private:
 		// Initiates GLFW and glad, sets GLFW callbacks